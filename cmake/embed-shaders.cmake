@@ -0,0 +1,221 @@
+##########################################################################
+# Copyright 2025 Vladislav Riabov
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+##########################################################################
+
+# Run in script mode by embed_shaders(), see the root CMakeLists.txt:
+#   cmake -DOUTPUT=<header> -DDEPFILE=<file> -DSHADERS=<a|b> -DINCLUDE_DIRECTORIES=<a|b>
+#     [-DGLSLANG=<glslangValidator> -DSPIRV_DIRECTORY=<dir>] -P embed-shaders.cmake
+#
+# Every shader is preprocessed (#include "file" resolved relative to the including
+# file, then the include directories, each file included once), minified (comments,
+# indentation and blank lines removed) and written as a constexpr
+# engine::gl::EmbeddedShader with the first 64 bits of its SHA-256 as cache key.
+# With GLSLANG, complete stages (starting with #version) are compiled from the
+# preprocessed text into GL SPIR-V and embedded as well; compile errors fail the build.
+
+cmake_minimum_required(VERSION 3.25)
+
+string(REPLACE "|" ";" SHADERS "${SHADERS}")
+string(REPLACE "|" ";" INCLUDE_DIRECTORIES "${INCLUDE_DIRECTORIES}")
+
+set(DEPENDENCIES "")
+
+function(resolve_include NAME FROM_DIRECTORY RESULT)
+  foreach(directory ${FROM_DIRECTORY} ${INCLUDE_DIRECTORIES})
+    if(EXISTS "${directory}/${NAME}")
+      get_filename_component(path "${directory}/${NAME}" ABSOLUTE)
+      set(${RESULT} "${path}" PARENT_SCOPE)
+      return()
+    endif()
+  endforeach()
+  message(FATAL_ERROR "Shader include \"${NAME}\" not found from ${FROM_DIRECTORY}")
+endfunction()
+
+# INCLUDED is the chain of files being expanded, to report cycles
+function(preprocess FILE INCLUDED RESULT)
+  if("${FILE}" IN_LIST INCLUDED)
+    message(FATAL_ERROR "Shader include cycle: ${INCLUDED};${FILE}")
+  endif()
+  list(APPEND INCLUDED "${FILE}")
+
+  set(dependencies ${DEPENDENCIES})
+  list(APPEND dependencies "${FILE}")
+  set(DEPENDENCIES ${dependencies} PARENT_SCOPE)
+
+  file(READ "${FILE}" content)
+  string(REPLACE "\r\n" "\n" content "${content}")
+  get_filename_component(directory "${FILE}" DIRECTORY)
+
+  # Comments go first so that commented out includes are not expanded
+  string(REGEX REPLACE "/\\*([^*]|\\*+[^*/])*\\*+/" "" content "${content}")
+  string(REGEX REPLACE "//[^\n]*" "" content "${content}")
+
+  while(TRUE)
+    string(REGEX MATCH "#[ \t]*include[ \t]*\"([^\"]+)\"" directive "${content}")
+    if(NOT directive)
+      break()
+    endif()
+
+    resolve_include("${CMAKE_MATCH_1}" "${directory}" path)
+    get_property(once GLOBAL PROPERTY EMBED_SHADERS_ONCE)
+    if("${path}" IN_LIST once)
+      set(included "")
+    else()
+      set_property(GLOBAL APPEND PROPERTY EMBED_SHADERS_ONCE "${path}")
+      set(DEPENDENCIES ${dependencies})
+      preprocess("${path}" "${INCLUDED}" included)
+      set(dependencies ${DEPENDENCIES})
+    endif()
+
+    string(FIND "${content}" "${directive}" position)
+    string(LENGTH "${directive}" length)
+    string(SUBSTRING "${content}" 0 ${position} before)
+    math(EXPR after_begin "${position} + ${length}")
+    string(SUBSTRING "${content}" ${after_begin} -1 after)
+    set(content "${before}${included}\n${after}")
+  endwhile()
+
+  set(DEPENDENCIES ${dependencies} PARENT_SCOPE)
+  set(${RESULT} "${content}" PARENT_SCOPE)
+endfunction()
+
+function(minify CONTENT RESULT)
+  string(REGEX REPLACE "[ \t]+" " " content "${CONTENT}")
+  string(REGEX REPLACE " ?\n ?" "\n" content "${content}")
+  string(REGEX REPLACE "\n\n+" "\n" content "${content}")
+  string(REGEX REPLACE "^\n" "" content "${content}")
+  set(${RESULT} "${content}" PARENT_SCOPE)
+endfunction()
+
+# vertex-shader.vert -> kVertexShaderVert
+function(identifier FILE RESULT)
+  get_filename_component(name "${FILE}" NAME)
+  string(REGEX MATCHALL "[A-Za-z0-9]+" parts "${name}")
+  set(identifier "k")
+  foreach(part ${parts})
+    string(SUBSTRING "${part}" 0 1 first)
+    string(SUBSTRING "${part}" 1 -1 rest)
+    string(TOUPPER "${first}" first)
+    string(APPEND identifier "${first}${rest}")
+  endforeach()
+  set(${RESULT} "${identifier}" PARENT_SCOPE)
+endfunction()
+
+function(stage_type FILE RESULT)
+  get_filename_component(extension "${FILE}" LAST_EXT)
+  set(types
+    .vert GL_VERTEX_SHADER .frag GL_FRAGMENT_SHADER .geom GL_GEOMETRY_SHADER
+    .tesc GL_TESS_CONTROL_SHADER .tese GL_TESS_EVALUATION_SHADER .comp GL_COMPUTE_SHADER)
+  list(FIND types "${extension}" index)
+  if(index EQUAL -1)
+    set(${RESULT} "0" PARENT_SCOPE)
+  else()
+    math(EXPR index "${index} + 1")
+    list(GET types ${index} type)
+    set(${RESULT} "${type}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+set(header "// Generated by cmake/embed-shaders.cmake, do not edit\n#pragma once\n\n#include \"gl/embedded-shader.hxx\"\n\nnamespace shaders\n{\n")
+
+# Little-endian words, eight per line
+function(spirv_words FILE RESULT)
+  file(READ "${FILE}" hex HEX)
+  string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u, " words "${hex}")
+  # CMake regular expressions have no {n} repetition
+  string(REPEAT "0x[0-9a-f]+u, " 8 line)
+  string(REGEX REPLACE "(${line})" "\\1\n  " words "${words}")
+  string(REPLACE " \n" "\n" words "${words}")
+  string(REGEX REPLACE "[ \n]+$" "" words "${words}")
+  set(${RESULT} "${words}" PARENT_SCOPE)
+endfunction()
+
+function(compile_spirv FILE_NAME CONTENT RESULT)
+  set(${RESULT} "" PARENT_SCOPE)
+  if(NOT GLSLANG OR NOT CONTENT MATCHES "^#version")
+    return()
+  endif()
+
+  # The extension tells glslang the stage
+  file(MAKE_DIRECTORY "${SPIRV_DIRECTORY}")
+  set(source "${SPIRV_DIRECTORY}/${FILE_NAME}")
+  file(WRITE "${source}" "${CONTENT}")
+  execute_process(COMMAND "${GLSLANG}" -G -o "${source}.spv" "${source}"
+    RESULT_VARIABLE status OUTPUT_VARIABLE output ERROR_VARIABLE output)
+  if(NOT status EQUAL 0)
+    message(FATAL_ERROR "SPIR-V compilation of ${FILE_NAME} failed:\n${output}")
+  endif()
+
+  spirv_words("${source}.spv" words)
+  set(${RESULT} "${words}" PARENT_SCOPE)
+endfunction()
+
+foreach(shader ${SHADERS})
+  get_filename_component(shader "${shader}" ABSOLUTE)
+  set_property(GLOBAL PROPERTY EMBED_SHADERS_ONCE "${shader}")
+
+  preprocess("${shader}" "" content)
+  minify("${content}" content)
+
+  string(SHA256 hash "${content}")
+  string(SUBSTRING "${hash}" 0 16 hash)
+  identifier("${shader}" name)
+  stage_type("${shader}" type)
+  get_filename_component(file_name "${shader}" NAME)
+
+  # MSVC caps a single string literal at 16 KiB, long sources are split at lines
+  set(literals "")
+  set(rest "${content}")
+  string(LENGTH "${rest}" length)
+  while(length GREATER 8000)
+    string(SUBSTRING "${rest}" 0 8000 chunk)
+    string(FIND "${chunk}" "\n" cut REVERSE)
+    math(EXPR cut "${cut} + 1")
+    string(SUBSTRING "${rest}" 0 ${cut} chunk)
+    string(SUBSTRING "${rest}" ${cut} -1 rest)
+    string(APPEND literals "R\"glsl(${chunk})glsl\"\n    ")
+    string(LENGTH "${rest}" length)
+  endwhile()
+  string(APPEND literals "R\"glsl(${rest})glsl\"")
+
+  set(spirv "")
+  if(NOT type STREQUAL "0")
+    compile_spirv("${file_name}" "${content}" words)
+    if(words)
+      string(APPEND header "\ninline constexpr uint32_t ${name}Spirv[] = {\n  ${words}\n};\n")
+      set(spirv "\n  ${name}Spirv,")
+    endif()
+  endif()
+
+  string(APPEND header "\ninline constexpr engine::gl::EmbeddedShader ${name} = {\n"
+    "  ${type},\n  \"${file_name}\",\n  ${literals},\n  0x${hash}ull,${spirv}\n};\n")
+endforeach()
+
+string(APPEND header "\n}  // namespace shaders\n")
+
+# Rewritten only on change, so that dependents are not rebuilt for nothing
+file(WRITE "${OUTPUT}.tmp" "${header}")
+configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+file(REMOVE "${OUTPUT}.tmp")
+
+if(DEPFILE)
+  list(REMOVE_DUPLICATES DEPENDENCIES)
+  set(depfile "${OUTPUT}:")
+  foreach(dependency ${DEPENDENCIES})
+    string(REPLACE " " "\\ " dependency "${dependency}")
+    string(APPEND depfile " \\\n  ${dependency}")
+  endforeach()
+  file(WRITE "${DEPFILE}" "${depfile}\n")
+endif()
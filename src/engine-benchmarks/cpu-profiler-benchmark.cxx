@@ -0,0 +1,88 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+
+#include "profiling/cpu-profiler.hxx"
+
+#include <thread>
+#include <vector>
+
+namespace benchmarks
+{
+
+void RunCpuProfilerBenchmarks()
+{
+  using engine::profiling::CpuProfiler;
+  using engine::profiling::CpuScope;
+
+  PrintSuite("cpu-profiler");
+
+  constexpr size_t kIterations = 10'000'000;
+  constexpr double kBudgetNs = 50.0;
+
+  // Registers the thread buffer outside of the measured loop
+  CpuProfiler::Instance().SetThreadName("benchmark");
+
+  double baseline = Measure("empty loop", kIterations, []
+  {
+    int value = 0;
+    DoNotOptimize(value);
+  });
+
+  Measure("CpuProfiler::Now", kIterations, []
+  {
+    DoNotOptimize(CpuProfiler::Now());
+  });
+
+  double scope = Measure("CpuScope", kIterations, []
+  {
+    CpuScope scope("benchmark scope");
+    DoNotOptimize(scope);
+  });
+
+  double nested = Measure("CpuScope, 4 nested", kIterations / 4, []
+  {
+    CpuScope a("a");
+    CpuScope b("b");
+    CpuScope c("c");
+    CpuScope d("d");
+    DoNotOptimize(d);
+  });
+
+  // Every thread writes its own buffer, the cost must not grow with contention
+  constexpr size_t kThreads = 4;
+  std::vector<std::thread> threads;
+  std::vector<double> threaded(kThreads);
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&result = threaded[i]]
+    {
+      result = Measure("CpuScope, 4 threads", kIterations / 4, []
+      {
+        CpuScope scope("threaded scope");
+        DoNotOptimize(scope);
+      });
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  double per_scope = scope - baseline;
+  std::printf("  per-scope overhead %.2f ns, nested %.2f ns: %s the %.0f ns budget\n",
+    per_scope, nested / 4, per_scope < kBudgetNs ? "within" : "OVER", kBudgetNs);
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,119 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+
+#include "core/job-system.hxx"
+#include "math/cpu-features.hxx"
+#include "math/frustum.hxx"
+#include "math/frustum-culler.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t kObjects = 1'000'000;
+constexpr size_t kIterations = 20;
+
+float Noise(size_t i)
+{
+  const float value = std::sin(i * 12.9898f) * 43758.5453f;
+  return value - std::floor(value);
+}
+
+struct Bounds
+{
+  glm::vec3 center;
+  float radius;
+  glm::vec3 extent;
+};
+
+}  // namespace
+
+// Frustum culling of 1M objects scattered around the camera: an AoS loop of
+// per-object tests against the SoA batches at every dispatch level, on the
+// calling thread and split across a job system
+void RunCullingBenchmarks()
+{
+  PrintSuite("culling");
+
+  // 90 degree field of view looking down +z, as hello-camera builds it
+  const float near_z = 0.1f;
+  const float far_z = 500.f;
+  const float range_z = far_z - near_z;
+  const glm::mat4 projection = glm::transpose(glm::mat4(
+    1.f, 0.f, 0.f, 0.f,
+    0.f, 1.f, 0.f, 0.f,
+    0.f, 0.f, (far_z + near_z) / range_z, -(2.f * far_z * near_z) / range_z,
+    0.f, 0.f, 1.f, 0.f));
+  const engine::math::Frustum frustum = engine::math::Frustum::FromViewProjection(projection);
+
+  std::vector<Bounds> objects(kObjects);
+  for (size_t i = 0; i < kObjects; ++i) {
+    const glm::vec3 center = (glm::vec3(Noise(i * 7), Noise(i * 7 + 1), Noise(i * 7 + 2)) - 0.5f) * 1000.f;
+    const glm::vec3 extent = glm::vec3(Noise(i * 7 + 3), Noise(i * 7 + 4), Noise(i * 7 + 5)) * 4.f + 0.5f;
+    objects[i] = {center, glm::length(extent), extent};
+  }
+
+  engine::JobSystem jobs;
+  engine::math::FrustumCuller culler;
+  culler.Reserve(kObjects);
+  for (const Bounds& object : objects)
+    culler.Add(object.center, object.radius, object.extent);
+
+  std::vector<uint32_t> visible;
+  visible.reserve(kObjects);
+  Measure("AoS, per-object tests", kIterations, [&]
+  {
+    visible.clear();
+    for (uint32_t i = 0; i < kObjects; ++i) {
+      const Bounds& object = objects[i];
+      if (frustum.IntersectsSphere(object.center, object.radius) && frustum.IntersectsAabb(object.center, object.extent))
+        visible.push_back(i);
+    }
+    DoNotOptimize(visible.back());
+  }, 3);
+
+  const engine::math::SimdLevel supported = engine::math::SupportedSimdLevel();
+  for (uint32_t level = 0; level <= static_cast<uint32_t>(supported); ++level) {
+    engine::math::SetSimdLevel(static_cast<engine::math::SimdLevel>(level));
+    const std::string name = std::string("SoA, ") + engine::math::SimdLevelName(engine::math::GetSimdLevel());
+
+    culler.SetJobSystem(nullptr);
+    Measure(name + ", 1 thread", kIterations, [&] { DoNotOptimize(culler.Cull(frustum).size()); }, 3);
+
+    culler.SetJobSystem(&jobs);
+    Measure(name + ", jobs on " + std::to_string(jobs.WorkerCount() + 1) + " threads", kIterations, [&]
+    {
+      DoNotOptimize(culler.Cull(frustum).size());
+    }, 3);
+  }
+  engine::math::SetSimdLevel(supported);
+
+  // FMA rounds differently, objects touching a plane may flip between levels
+  std::printf("  visible: %zu of %zu per-object, %zu batched\n", visible.size(), kObjects, culler.Cull(frustum).size());
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,97 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+
+#include "memory/frame-arena.hxx"
+
+#include <cstdlib>
+#include <memory_resource>
+#include <vector>
+
+namespace benchmarks
+{
+
+void RunFrameArenaBenchmarks()
+{
+  using engine::memory::FrameArena;
+
+  PrintSuite("frame-arena");
+
+  // A "frame" allocates kAllocations blocks and frees them all at its end
+  constexpr size_t kAllocations = 4096;
+  constexpr size_t kFrames = 500;
+  constexpr size_t kSize = 64;
+
+  std::vector<void*> pointers(kAllocations);
+
+  double heap = Measure("malloc/free, 4096 x 64 B per frame", kFrames, [&pointers]
+  {
+    for (void*& pointer : pointers) {
+      pointer = std::malloc(kSize);
+      DoNotOptimize(pointer);
+    }
+    for (void* pointer : pointers)
+      std::free(pointer);
+  }) / kAllocations;
+
+  FrameArena arena;
+  arena.SetPoisonOnReset(false);
+  double bump = Measure("FrameArena, 4096 x 64 B per frame", kFrames, [&arena]
+  {
+    for (size_t i = 0; i < kAllocations; ++i)
+      DoNotOptimize(arena.Allocate(kSize, 16));
+    arena.EndFrame();
+  }) / kAllocations;
+
+  FrameArena poisoned;
+  poisoned.SetPoisonOnReset(true);
+  Measure("FrameArena with poisoning, 4096 x 64 B per frame", kFrames, [&poisoned]
+  {
+    for (size_t i = 0; i < kAllocations; ++i)
+      DoNotOptimize(poisoned.Allocate(kSize, 16));
+    poisoned.EndFrame();
+  });
+
+  // Containers: a frame builds 64 lists of 256 elements
+  constexpr size_t kLists = 64;
+  constexpr size_t kElements = 256;
+
+  Measure("std::vector<int>, 64 lists x 256 push_back", kFrames, []
+  {
+    for (size_t list = 0; list < kLists; ++list) {
+      std::vector<int> values;
+      for (size_t i = 0; i < kElements; ++i)
+        values.push_back(static_cast<int>(i));
+      DoNotOptimize(values.data());
+    }
+  });
+
+  Measure("std::pmr::vector<int> on FrameArena", kFrames, [&arena]
+  {
+    for (size_t list = 0; list < kLists; ++list) {
+      std::pmr::vector<int> values(&arena.Resource());
+      for (size_t i = 0; i < kElements; ++i)
+        values.push_back(static_cast<int>(i));
+      DoNotOptimize(values.data());
+    }
+    arena.EndFrame();
+  });
+
+  std::printf("  per allocation: malloc/free %.2f ns, FrameArena %.2f ns (%.1fx)\n", heap, bump, heap / bump);
+}
+
+}  // namespace benchmarks
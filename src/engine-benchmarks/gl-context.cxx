@@ -0,0 +1,71 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/gl-context.hxx"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdio>
+
+namespace benchmarks
+{
+
+GlContext::GlContext()
+{
+  if (glfwInit() != GLFW_TRUE) {
+    std::printf("  skipped: failed to initialize GLFW\n");
+    return;
+  }
+
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+  m_window = glfwCreateWindow(64, 64, "engine-benchmarks", NULL, NULL);
+  if (m_window == nullptr) {
+    std::printf("  skipped: failed to create a GL 4.6 context\n");
+    glfwTerminate();
+    return;
+  }
+
+  glfwMakeContextCurrent(m_window);
+  glfwSwapInterval(0);
+
+  if (gladLoadGL() == 0) {
+    std::printf("  skipped: failed to load GL functions\n");
+    glfwDestroyWindow(m_window);
+    glfwTerminate();
+    m_window = nullptr;
+  }
+}
+
+GlContext::~GlContext()
+{
+  if (m_window == nullptr)
+    return;
+
+  glfwDestroyWindow(m_window);
+  glfwTerminate();
+}
+
+void GlContext::SwapBuffers()
+{
+  glfwSwapBuffers(m_window);
+}
+
+}  // namespace benchmarks
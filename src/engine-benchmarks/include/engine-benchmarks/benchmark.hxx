@@ -0,0 +1,78 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+
+namespace benchmarks
+{
+
+// Keeps the compiler from discarding a computed value
+template<class T>
+inline void DoNotOptimize(const T& value)
+{
+#ifdef _MSC_VER
+  static thread_local const void* volatile sink = nullptr;
+  sink = &value;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+  asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+// Runs function() iterations times per repetition and reports the best
+// repetition in nanoseconds per call
+template<class Function>
+double Measure(std::string_view name, size_t iterations, Function&& function, size_t repetitions = 5)
+{
+  for (size_t i = 0; i < std::max<size_t>(iterations / 10, 1); ++i)
+    function();
+
+  double best = std::numeric_limits<double>::max();
+  for (size_t repetition = 0; repetition < repetitions; ++repetition) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+      function();
+    auto end = std::chrono::steady_clock::now();
+
+    best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+  }
+
+  std::printf("  %-48.*s %12.2f ns/op\n", static_cast<int>(name.size()), name.data(), best);
+  return best;
+}
+
+inline void PrintSuite(std::string_view name)
+{
+  std::printf("\n[%.*s]\n", static_cast<int>(name.size()), name.data());
+}
+
+void RunCpuProfilerBenchmarks();
+void RunCullingBenchmarks();
+void RunFrameArenaBenchmarks();
+void RunIndirectRendererBenchmarks();
+void RunMathBenchmarks();
+void RunRenderQueueBenchmarks();
+void RunRingBufferBenchmarks();
+void RunShaderProgramBenchmarks();
+void RunTransformBenchmarks();
+
+}  // namespace benchmarks
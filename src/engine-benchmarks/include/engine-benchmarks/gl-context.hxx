@@ -0,0 +1,43 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+struct GLFWwindow;
+
+namespace benchmarks
+{
+
+// Hidden window with a current GL 4.6 core context for suites that issue GL
+// calls. Suites check IsValid() and skip themselves without a display.
+class GlContext
+{
+public:
+  GlContext();
+  ~GlContext();
+
+  GlContext(const GlContext&) = delete;
+  GlContext& operator=(const GlContext&) = delete;
+
+  bool IsValid() const { return m_window != nullptr; }
+  GLFWwindow* Window() const { return m_window; }
+  // Frame boundary for suites that need the driver to see whole frames, vsync is off
+  void SwapBuffers();
+
+private:
+  GLFWwindow* m_window = nullptr;
+};
+
+}  // namespace benchmarks
@@ -0,0 +1,161 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+#include "engine-benchmarks/gl-context.hxx"
+
+#include "gl/geometry-pool.hxx"
+#include "gl/indirect-renderer.hxx"
+#include "gl/shader-program.hxx"
+#include "gl/state-cache.hxx"
+#include "gl/uniform-block.hxx"
+#include "gl/vertex-array.hxx"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdio>
+#include <vector>
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t kFrames = 10;
+constexpr uint32_t kObjects = 100'000;
+
+#define BENCHMARK_OBJECT_DATA(X) \
+  X(glm::mat4, transform)
+
+ENGINE_GL_STORAGE_ARRAY(ObjectData, objects, 0, BENCHMARK_OBJECT_DATA);
+
+// Tiny cubes so that the cost is per draw, not per pixel
+const std::string kIndirectVertexSource = "#version 460 core\n" + ObjectData::Glsl() + R"(
+layout (location = 0) in vec3 position;
+void main()
+{
+  gl_Position = objects[gl_DrawID].transform * vec4(position, 1.0);
+}
+)";
+
+constexpr const char* kDirectVertexSource = R"(
+#version 460 core
+layout (location = 0) in vec3 position;
+uniform mat4 transform;
+void main()
+{
+  gl_Position = transform * vec4(position, 1.0);
+}
+)";
+
+constexpr const char* kFragmentSource = R"(
+#version 460 core
+out vec4 FragColor;
+void main()
+{
+  FragColor = vec4(1.0);
+}
+)";
+
+const std::array<glm::vec3, 8> kCubeVertices = {{
+  {-1.f, -1.f, -1.f}, {1.f, -1.f, -1.f}, {1.f, 1.f, -1.f}, {-1.f, 1.f, -1.f},
+  {-1.f, -1.f, 1.f}, {1.f, -1.f, 1.f}, {1.f, 1.f, 1.f}, {-1.f, 1.f, 1.f},
+}};
+
+constexpr std::array<uint32_t, 36> kCubeIndices = {
+  0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4, 0, 4, 7, 7, 3, 0,
+  1, 5, 6, 6, 2, 1, 3, 2, 6, 6, 7, 3, 0, 1, 5, 5, 4, 0,
+};
+
+}  // namespace
+
+// 100k objects, each with its own transform, drawn one call each and through
+// the indirect renderer's single multi-draw
+void RunIndirectRendererBenchmarks()
+{
+  PrintSuite("indirect-renderer");
+
+  GlContext context;
+  if (!context.IsValid())
+    return;
+
+  engine::gl::GeometryPool pool(sizeof(glm::vec3), 1024, 4096);
+  const engine::gl::MeshRange cube = pool.Add(std::span<const glm::vec3>(kCubeVertices), kCubeIndices);
+
+  engine::gl::VertexArray vertex_array;
+  pool.Attach(vertex_array);
+  vertex_array.SetAttribute(0, 0, 3, GL_FLOAT, 0);
+
+  std::vector<ObjectData> objects(kObjects);
+  for (uint32_t i = 0; i < kObjects; ++i) {
+    glm::mat4& transform = objects[i].transform;
+    transform = glm::mat4(0.001f);
+    transform[3] = glm::vec4((i % 316) / 158.f - 1.f, (i / 316) / 158.f - 1.f, 0.f, 1.f);
+  }
+
+  engine::gl::StateCache state;
+
+  {
+    engine::gl::ShaderProgram program({
+      {GL_VERTEX_SHADER, kDirectVertexSource},
+      {GL_FRAGMENT_SHADER, kFragmentSource},
+    });
+    state.UseProgram(program.Get());
+    state.BindVertexArray(vertex_array.Get());
+
+    const void* indices = reinterpret_cast<const void*>(cube.first * sizeof(uint32_t));
+    Measure("glDrawElements + uniform per object, 100k objects", kFrames, [&]
+    {
+      for (const ObjectData& object : objects) {
+        program.Set("transform", object.transform);
+        glDrawElementsBaseVertex(GL_TRIANGLES, cube.count, GL_UNSIGNED_INT, indices, cube.base_vertex);
+      }
+      context.SwapBuffers();
+    }, 3);
+    glFinish();
+  }
+
+  engine::gl::ShaderProgram program({
+    {GL_VERTEX_SHADER, kIndirectVertexSource},
+    {GL_FRAGMENT_SHADER, kFragmentSource},
+  });
+
+  engine::gl::Pipeline pipeline;
+  pipeline.program = program.Get();
+  pipeline.vertex_array = vertex_array.Get();
+  pipeline.index_type = GL_UNSIGNED_INT;
+
+  engine::gl::IndirectRenderer renderer(sizeof(ObjectData), ObjectData::kBinding, kObjects);
+  const uint16_t batch = renderer.AddBatch(pipeline, {});
+
+  Measure("IndirectRenderer, 100k objects", kFrames, [&]
+  {
+    renderer.BeginFrame();
+    for (const ObjectData& object : objects)
+      renderer.Submit(batch, cube, object);
+    renderer.Execute(state);
+    renderer.EndFrame();
+    context.SwapBuffers();
+  }, 3);
+  glFinish();
+
+  const engine::gl::IndirectRenderer::Stats& stats = renderer.GetStats();
+  std::printf("  indirect: %u objects in %u draw calls\n", stats.objects, stats.draw_calls);
+}
+
+}  // namespace benchmarks
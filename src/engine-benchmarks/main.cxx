@@ -0,0 +1,69 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+
+#include <cstdio>
+#include <string_view>
+
+namespace
+{
+
+struct Suite
+{
+  std::string_view name;
+  void (*run)();
+};
+
+constexpr Suite kSuites[] = {
+  {"cpu-profiler", benchmarks::RunCpuProfilerBenchmarks},
+  {"culling", benchmarks::RunCullingBenchmarks},
+  {"frame-arena", benchmarks::RunFrameArenaBenchmarks},
+  {"indirect-renderer", benchmarks::RunIndirectRendererBenchmarks},
+  {"math", benchmarks::RunMathBenchmarks},
+  {"render-queue", benchmarks::RunRenderQueueBenchmarks},
+  {"ring-buffer", benchmarks::RunRingBufferBenchmarks},
+  {"shader-program", benchmarks::RunShaderProgramBenchmarks},
+  {"transform", benchmarks::RunTransformBenchmarks},
+};
+
+}  // namespace
+
+// Usage: engine-benchmarks [suite...], runs every suite when none is given
+int main(int argc, char** argv)
+{
+  int ran = 0;
+  for (const Suite& suite : kSuites) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; ++i)
+      selected = selected || suite.name == argv[i];
+
+    if (selected) {
+      suite.run();
+      ++ran;
+    }
+  }
+
+  if (ran == 0) {
+    std::printf("Unknown suite. Available:");
+    for (const Suite& suite : kSuites)
+      std::printf(" %.*s", static_cast<int>(suite.name.size()), suite.name.data());
+    std::printf("\n");
+    return 1;
+  }
+
+  return 0;
+}
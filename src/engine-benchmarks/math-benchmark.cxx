@@ -0,0 +1,179 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+
+#include "math/cpu-features.hxx"
+#include "math/kernels.hxx"
+#include "math/soa.hxx"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t kSizes[] = {1'000, 10'000, 100'000, 1'000'000};
+// Roughly the same amount of work per measurement whatever the batch size
+constexpr size_t kElementsPerMeasure = 10'000'000;
+
+float Noise(size_t i)
+{
+  return std::sin(i * 12.9898f) * 4.f;
+}
+
+struct Data
+{
+  explicit Data(size_t size)
+   : matrices(size), matrices_out(size), vectors(size), vectors_out(size), rotations(size), points(size),
+     points_out(size), aabb_centers(size), aabb_extents(size), aabb_centers_out(size), aabb_extents_out(size),
+     points_aos(size), points_aos_out(size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      for (int column = 0; column < 4; ++column)
+        matrices[i][column] = glm::vec4(Noise(i * 16 + column * 4), Noise(i * 16 + column * 4 + 1),
+          Noise(i * 16 + column * 4 + 2), Noise(i * 16 + column * 4 + 3));
+      vectors[i] = glm::vec4(Noise(i * 4), Noise(i * 4 + 1), Noise(i * 4 + 2), 1.f);
+      rotations[i] = glm::normalize(glm::quat(Noise(i * 4 + 3), Noise(i * 4), Noise(i * 4 + 1), Noise(i * 4 + 2)));
+      points_aos[i] = glm::vec3(vectors[i]);
+      points.Set(i, points_aos[i]);
+      aabb_centers.Set(i, points_aos[i]);
+      aabb_extents.Set(i, glm::abs(glm::vec3(Noise(i + 1), Noise(i + 2), Noise(i + 3))));
+    }
+  }
+
+  std::vector<glm::mat4> matrices;
+  std::vector<glm::mat4> matrices_out;
+  std::vector<glm::vec4> vectors;
+  std::vector<glm::vec4> vectors_out;
+  std::vector<glm::quat> rotations;
+  engine::math::Vec3Soa points;
+  engine::math::Vec3Soa points_out;
+  engine::math::Vec3Soa aabb_centers;
+  engine::math::Vec3Soa aabb_extents;
+  engine::math::Vec3Soa aabb_centers_out;
+  engine::math::Vec3Soa aabb_extents_out;
+  std::vector<glm::vec3> points_aos;
+  std::vector<glm::vec3> points_aos_out;
+};
+
+// One line per implementation: glm first, then every kernel level the CPU runs
+template<class Glm, class Kernel>
+void Compare(const char* name, size_t size, Glm&& glm_loop, Kernel&& kernel)
+{
+  const size_t iterations = std::max<size_t>(kElementsPerMeasure / size, 1);
+  const std::string label = std::string(name) + ", " + std::to_string(size);
+
+  Measure(label + ", glm", iterations, glm_loop, 3);
+
+  const engine::math::SimdLevel supported = engine::math::SupportedSimdLevel();
+  for (uint32_t level = 0; level <= static_cast<uint32_t>(supported); ++level) {
+    engine::math::SetSimdLevel(static_cast<engine::math::SimdLevel>(level));
+    Measure(label + ", " + engine::math::SimdLevelName(engine::math::GetSimdLevel()), iterations, kernel, 3);
+  }
+  engine::math::SetSimdLevel(supported);
+}
+
+}  // namespace
+
+// Batch math kernels at every dispatch level against the equivalent glm loops,
+// one batch per op from 1k to 1M elements
+void RunMathBenchmarks()
+{
+  PrintSuite("math");
+  std::printf("  dispatch: %s\n", engine::math::SimdLevelName(engine::math::SupportedSimdLevel()));
+
+  const glm::mat4 transform = glm::mat4(glm::vec4(0.8f, 0.1f, -0.2f, 0.f), glm::vec4(-0.1f, 0.9f, 0.3f, 0.f),
+    glm::vec4(0.2f, -0.3f, 0.7f, 0.f), glm::vec4(1.f, 2.f, 3.f, 1.f));
+
+  for (size_t size : kSizes) {
+    Data data(size);
+
+    Compare("mat4 * mat4", size, [&]
+    {
+      for (size_t i = 0; i < size; ++i)
+        data.matrices_out[i] = transform * data.matrices[i];
+      DoNotOptimize(data.matrices_out.back());
+    }, [&]
+    {
+      engine::math::MultiplyMatrices(transform, data.matrices, data.matrices_out);
+      DoNotOptimize(data.matrices_out.back());
+    });
+
+    Compare("mat4 * vec4", size, [&]
+    {
+      for (size_t i = 0; i < size; ++i)
+        data.vectors_out[i] = transform * data.vectors[i];
+      DoNotOptimize(data.vectors_out.back());
+    }, [&]
+    {
+      engine::math::TransformVectors(transform, data.vectors, data.vectors_out);
+      DoNotOptimize(data.vectors_out.back());
+    });
+
+    data.points_out.Resize(size);
+    Compare("points, glm AoS against SoA", size, [&]
+    {
+      for (size_t i = 0; i < size; ++i)
+        data.points_aos_out[i] = glm::vec3(transform * glm::vec4(data.points_aos[i], 1.f));
+      DoNotOptimize(data.points_aos_out.back());
+    }, [&]
+    {
+      engine::math::TransformPoints(transform, data.points.Span(), data.points_out.Span());
+      DoNotOptimize(data.points_out[size - 1]);
+    });
+
+    Compare("quaternion to mat4", size, [&]
+    {
+      for (size_t i = 0; i < size; ++i)
+        data.matrices_out[i] = glm::mat4_cast(data.rotations[i]);
+      DoNotOptimize(data.matrices_out.back());
+    }, [&]
+    {
+      engine::math::QuaternionsToMatrices(data.rotations, data.matrices_out);
+      DoNotOptimize(data.matrices_out.back());
+    });
+
+    data.aabb_centers_out.Resize(size);
+    data.aabb_extents_out.Resize(size);
+    const glm::mat3 linear(transform);
+    const glm::mat3 absolute(glm::abs(linear[0]), glm::abs(linear[1]), glm::abs(linear[2]));
+    Compare("AABB transform", size, [&]
+    {
+      for (size_t i = 0; i < size; ++i) {
+        data.aabb_centers_out.Set(i, glm::vec3(transform * glm::vec4(data.aabb_centers[i], 1.f)));
+        data.aabb_extents_out.Set(i, absolute * data.aabb_extents[i]);
+      }
+      DoNotOptimize(data.aabb_extents_out[size - 1]);
+    }, [&]
+    {
+      engine::math::TransformAabbs(transform, data.aabb_centers.Span(), data.aabb_extents.Span(),
+        data.aabb_centers_out.Span(), data.aabb_extents_out.Span());
+      DoNotOptimize(data.aabb_extents_out[size - 1]);
+    });
+  }
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,93 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+
+#include "gl/render-queue.hxx"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace benchmarks
+{
+
+void RunRenderQueueBenchmarks()
+{
+  using engine::gl::DrawPacket;
+  using engine::gl::RenderQueue;
+
+  PrintSuite("render-queue");
+
+  // Submission and sorting only touch CPU memory, no context is needed
+  constexpr size_t kPackets = 100'000;
+  constexpr size_t kFrames = 50;
+  constexpr uint16_t kPipelines = 32;
+  constexpr uint16_t kMaterials = 512;
+
+  RenderQueue queue;
+  for (uint16_t i = 0; i < kPipelines; ++i) {
+    engine::gl::Pipeline pipeline;
+    pipeline.blend = i % 8 == 0;
+    queue.AddPipeline(pipeline);
+  }
+  for (uint16_t i = 0; i < kMaterials; ++i)
+    queue.AddMaterial({});
+  queue.SetDepthRange(0.1f, 1000.f);
+
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float> depth(0.1f, 1000.f);
+  std::vector<DrawPacket> packets(kPackets);
+  std::vector<float> depths(kPackets);
+  for (size_t i = 0; i < kPackets; ++i) {
+    packets[i].pipeline = static_cast<uint16_t>(random() % kPipelines);
+    packets[i].material = static_cast<uint16_t>(random() % kMaterials);
+    packets[i].mesh.count = 36;
+    depths[i] = depth(random);
+  }
+
+  auto submit = [&]
+  {
+    queue.Clear();
+    for (size_t i = 0; i < kPackets; ++i)
+      queue.Submit(packets[i], depths[i]);
+  };
+
+  Measure("Submit, 100k packets", kFrames, submit);
+
+  double radix = Measure("Submit + radix Sort, 100k packets", kFrames, [&]
+  {
+    submit();
+    queue.Sort();
+    DoNotOptimize(queue[0]);
+  });
+
+  // Same keys through a comparison sort of the packets themselves
+  std::vector<DrawPacket> sorted;
+  double comparison = Measure("Submit + std::sort of packets, 100k packets", kFrames, [&]
+  {
+    submit();
+    sorted.assign(packets.begin(), packets.end());
+    for (size_t i = 0; i < kPackets; ++i)
+      sorted[i].key = queue[i].key;
+    std::sort(sorted.begin(), sorted.end(), [](const DrawPacket& a, const DrawPacket& b) { return a.key < b.key; });
+    DoNotOptimize(sorted[0]);
+  });
+
+  std::printf("  radix sort %.2fx faster than std::sort per frame\n", comparison / radix);
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,147 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+#include "engine-benchmarks/gl-context.hxx"
+
+#include "gl/handle.hxx"
+#include "gl/ring-buffer.hxx"
+#include "gl/shader-program.hxx"
+#include "gl/state-cache.hxx"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdio>
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t kFrames = 200;
+constexpr size_t kDrawsPerFrame = 1000;
+
+using Matrices = std::array<glm::mat4, 4>;
+
+#define BENCHMARK_OBJECT_BLOCK(X) \
+  X(Matrices, matrices)
+
+ENGINE_GL_UNIFORM_BLOCK(ObjectBlock, 0, BENCHMARK_OBJECT_BLOCK);
+
+// One point per draw, its position depends on the block so the data is really read
+const std::string kVertexSource = "#version 460 core\n" + ObjectBlock::Glsl() + R"(
+void main()
+{
+  gl_Position = matrices[0] * matrices[1] * matrices[2] * matrices[3] * vec4(0.0, 0.0, 0.0, 1.0);
+}
+)";
+
+constexpr const char* kFragmentSource = R"(
+#version 460 core
+out vec4 FragColor;
+void main()
+{
+  FragColor = vec4(1.0);
+}
+)";
+
+ObjectBlock MakeBlock(size_t draw)
+{
+  ObjectBlock block;
+  for (glm::mat4& matrix : block.matrices)
+    matrix = glm::mat4(1.f);
+  block.matrices[0][3] = glm::vec4(static_cast<float>(draw % 16) / 16.f, 0.f, 0.f, 1.f);
+  return block;
+}
+
+}  // namespace
+
+// The same per-draw uniform stream through three upload strategies. Per frame
+// timings include the implicit synchronization each of them pays.
+void RunRingBufferBenchmarks()
+{
+  PrintSuite("ring-buffer");
+
+  GlContext context;
+  if (!context.IsValid())
+    return;
+
+  engine::gl::ShaderProgram program({
+    {GL_VERTEX_SHADER, kVertexSource},
+    {GL_FRAGMENT_SHADER, kFragmentSource},
+  });
+  engine::gl::StateCache state;
+  program.Use(state);
+
+  engine::gl::VertexArrayHandle vao = engine::gl::VertexArrayHandle::Create();
+  state.BindVertexArray(vao.Get());
+
+  std::vector<ObjectBlock> blocks(kDrawsPerFrame);
+  for (size_t i = 0; i < kDrawsPerFrame; ++i)
+    blocks[i] = MakeBlock(i);
+
+  // Mutable storage on purpose, orphaning needs glBufferData
+  engine::gl::BufferHandle buffer = engine::gl::BufferHandle::Create();
+  glNamedBufferData(buffer.Get(), sizeof(ObjectBlock), nullptr, GL_DYNAMIC_DRAW);
+  state.BindBufferRange(GL_UNIFORM_BUFFER, ObjectBlock::kBinding, buffer.Get());
+
+  Measure("glBufferSubData, frame of 1000 draws", kFrames, [&]
+  {
+    for (const ObjectBlock& block : blocks) {
+      glNamedBufferSubData(buffer.Get(), 0, sizeof(ObjectBlock), &block);
+      glDrawArrays(GL_POINTS, 0, 1);
+    }
+    context.SwapBuffers();
+  }, 3);
+
+  Measure("glBufferData orphaning, frame of 1000 draws", kFrames, [&]
+  {
+    for (const ObjectBlock& block : blocks) {
+      glNamedBufferData(buffer.Get(), sizeof(ObjectBlock), &block, GL_STREAM_DRAW);
+      glDrawArrays(GL_POINTS, 0, 1);
+    }
+    context.SwapBuffers();
+  }, 3);
+
+  glFinish();
+  buffer.Reset();
+
+  {
+    engine::gl::RingBuffer ring(kDrawsPerFrame * 512);
+
+    Measure("persistent ring buffer, frame of 1000 draws", kFrames, [&]
+    {
+      ring.BeginFrame();
+      for (const ObjectBlock& block : blocks) {
+        ring.PushBlock(state, block);
+        glDrawArrays(GL_POINTS, 0, 1);
+      }
+      ring.EndFrame();
+      context.SwapBuffers();
+    }, 3);
+
+    glFinish();
+
+    const engine::gl::RingBuffer::Stats& stats = ring.GetStats();
+    std::printf("  ring: %llu frames, %llu stalls (%.2f ms), peak %lld of %lld bytes per frame\n",
+      static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.stalls), stats.stall_ms,
+      static_cast<long long>(stats.peak_usage), static_cast<long long>(ring.FrameSize()));
+  }
+}
+
+}  // namespace benchmarks
@@ -0,0 +1,122 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+#include "engine-benchmarks/gl-context.hxx"
+
+#include "gl/shader-program.hxx"
+#include "gl/state-cache.hxx"
+
+#include <glm/glm.hpp>
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t kIterations = 200'000;
+
+constexpr const char* kVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+uniform mat4 rotation_y;
+uniform mat4 rotation_z;
+uniform mat4 translation;
+uniform mat4 projection;
+uniform mat4 camera;
+uniform float scale;
+
+void main()
+{
+  gl_Position = projection * camera * translation * rotation_z * rotation_y * vec4(scale * aPos, 1.0);
+}
+)";
+
+constexpr const char* kFragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+uniform vec4 tint;
+uniform int mode;
+void main()
+{
+  FragColor = mode == 0 ? tint : vec4(1.0);
+}
+)";
+
+}  // namespace
+
+// The per-frame uniform update of hello-camera: eight uniforms by name
+void RunShaderProgramBenchmarks()
+{
+  PrintSuite("shader-program");
+
+  GlContext context;
+  if (!context.IsValid())
+    return;
+
+  engine::gl::ShaderProgram program({
+    {GL_VERTEX_SHADER, kVertexSource},
+    {GL_FRAGMENT_SHADER, kFragmentSource},
+  });
+  const GLuint handle = program.Get();
+  engine::gl::StateCache state;
+  program.Use(state);
+
+  Measure("glGetUniformLocation x8", kIterations, [handle]
+  {
+    GLint sum = 0;
+    for (const char* name : {"rotation_y", "rotation_z", "translation", "projection", "camera", "scale", "tint", "mode"})
+      sum += glGetUniformLocation(handle, name);
+    DoNotOptimize(sum);
+  });
+
+  Measure("ShaderProgram::Location x8", kIterations, [&program]
+  {
+    GLint sum = program.Location("rotation_y") + program.Location("rotation_z") + program.Location("translation")
+      + program.Location("projection") + program.Location("camera") + program.Location("scale")
+      + program.Location("tint") + program.Location("mode");
+    DoNotOptimize(sum);
+  });
+
+  const glm::mat4 matrix(1.f);
+  const glm::vec4 tint(1.f);
+
+  Measure("lookup by string + glUniform x8", kIterations, [handle, &matrix, &tint]
+  {
+    for (const char* name : {"rotation_y", "rotation_z", "translation", "projection", "camera"})
+      glUniformMatrix4fv(glGetUniformLocation(handle, name), 1, GL_TRUE, &matrix[0].x);
+    glUniform1f(glGetUniformLocation(handle, "scale"), 1.f);
+    glUniform4fv(glGetUniformLocation(handle, "tint"), 1, &tint.x);
+    glUniform1i(glGetUniformLocation(handle, "mode"), 0);
+  });
+
+  Measure("ShaderProgram::Set x8", kIterations, [&program, &matrix, &tint]
+  {
+    program.Set("rotation_y", matrix, true);
+    program.Set("rotation_z", matrix, true);
+    program.Set("translation", matrix, true);
+    program.Set("projection", matrix, true);
+    program.Set("camera", matrix, true);
+    program.Set("scale", 1.f);
+    program.Set("tint", tint);
+    program.Set("mode", 0);
+  });
+
+  glFinish();
+}
+
+}  // namespace benchmarks
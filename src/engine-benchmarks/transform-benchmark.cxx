@@ -0,0 +1,264 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "engine-benchmarks/benchmark.hxx"
+#include "engine-benchmarks/gl-context.hxx"
+
+#include "gl/buffer.hxx"
+#include "gl/handle.hxx"
+#include "gl/shader-program.hxx"
+#include "gl/vertex-array.hxx"
+#include "math/transform.hxx"
+#include "profiling/gpu-profiler.hxx"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace benchmarks
+{
+
+namespace
+{
+
+constexpr size_t kObjects = 10'000;
+constexpr uint32_t kGridSize = 1024;
+constexpr uint32_t kDraws = 20;
+constexpr uint32_t kFrames = 64;
+
+constexpr const char* kChainScope = "4 matrix products per vertex";
+constexpr const char* kComposedScope = "1 matrix product per vertex";
+
+// The chain hello-camera used to evaluate per vertex
+constexpr const char* kChainVertexSource = R"(
+#version 460 core
+layout (location = 0) in vec3 position;
+uniform mat4 projection;
+uniform mat4 camera;
+uniform mat4 translation;
+uniform mat4 rotation;
+void main()
+{
+  gl_Position = projection * camera * translation * rotation * vec4(position, 1.0);
+}
+)";
+
+constexpr const char* kComposedVertexSource = R"(
+#version 460 core
+layout (location = 0) in vec3 position;
+uniform mat4 world_view_projection;
+void main()
+{
+  gl_Position = world_view_projection * vec4(position, 1.0);
+}
+)";
+
+constexpr const char* kFragmentSource = R"(
+#version 460 core
+out vec4 FragColor;
+void main()
+{
+  FragColor = vec4(1.0);
+}
+)";
+
+glm::mat4 Rotation(float angle)
+{
+  glm::mat4 rotation(1.f);
+  rotation[0][0] = std::cos(angle);
+  rotation[0][2] = -std::sin(angle);
+  rotation[2][0] = std::sin(angle);
+  rotation[2][2] = std::cos(angle);
+  return rotation;
+}
+
+glm::mat4 Translation(float x, float y, float z)
+{
+  glm::mat4 translation(1.f);
+  translation[3] = glm::vec4(x, y, z, 1.f);
+  return translation;
+}
+
+glm::mat4 Projection()
+{
+  glm::mat4 projection(0.f);
+  projection[0][0] = 1.f;
+  projection[1][1] = 1.f;
+  projection[2][2] = 1.0002f;
+  projection[2][3] = 1.f;
+  projection[3][2] = -0.2f;
+  return projection;
+}
+
+void RunCpuBenchmarks()
+{
+  std::vector<glm::mat4> worlds(kObjects);
+  for (size_t i = 0; i < kObjects; ++i)
+    worlds[i] = Translation(i % 100 * 2.f, i / 100 * 2.f, 10.f) * Rotation(i * 0.01f);
+
+  const glm::mat4 view_projection = Projection() * Translation(-100.f, -100.f, 0.f);
+
+  std::vector<glm::mat4> clip(kObjects);
+  Measure("glm view_projection * world, 10k objects", 100, [&]
+  {
+    for (size_t i = 0; i < kObjects; ++i)
+      clip[i] = view_projection * worlds[i];
+    DoNotOptimize(clip.back());
+  });
+  Measure("ComposeWorldViewProjection, 10k objects", 100, [&]
+  {
+    engine::math::ComposeWorldViewProjection(view_projection, worlds, clip);
+    DoNotOptimize(clip.back());
+  });
+
+  std::vector<engine::math::ObjectTransforms> objects(kObjects);
+  Measure("glm clip, world and normal matrices, 10k objects", 100, [&]
+  {
+    for (size_t i = 0; i < kObjects; ++i) {
+      objects[i].world_view_projection = view_projection * worlds[i];
+      objects[i].world = worlds[i];
+      objects[i].normal = glm::mat4(glm::transpose(glm::inverse(glm::mat3(worlds[i]))));
+    }
+    DoNotOptimize(objects.back());
+  });
+  Measure("ComposeObjects, 10k objects", 100, [&]
+  {
+    engine::math::ComposeObjects(view_projection, worlds, objects);
+    DoNotOptimize(objects.back());
+  });
+}
+
+// Average GPU time of one draw of the mesh in the named profiler scope
+double DrawMs(const engine::profiling::GpuProfiler& profiler, const char* scope)
+{
+  for (const engine::profiling::GpuProfiler::Node& node : profiler.Nodes()) {
+    if (std::strcmp(node.name, scope) == 0)
+      return node.average_ms / kDraws;
+  }
+  return 0.0;
+}
+
+void RunGpuBenchmarks()
+{
+  GlContext context;
+  if (!context.IsValid())
+    return;
+
+  // Dense mesh: 1M vertices, 2M triangles of a few pixels each, so the vertex
+  // stage dominates over rasterization
+  std::vector<glm::vec3> vertices;
+  vertices.reserve(kGridSize * kGridSize);
+  for (uint32_t y = 0; y < kGridSize; ++y) {
+    for (uint32_t x = 0; x < kGridSize; ++x)
+      vertices.emplace_back(x / float(kGridSize) - 0.5f, y / float(kGridSize) - 0.5f, 0.f);
+  }
+
+  std::vector<GLuint> indices;
+  indices.reserve((kGridSize - 1) * (kGridSize - 1) * 6);
+  for (uint32_t y = 0; y + 1 < kGridSize; ++y) {
+    for (uint32_t x = 0; x + 1 < kGridSize; ++x) {
+      const GLuint corner = y * kGridSize + x;
+      for (GLuint index : {corner, corner + 1, corner + kGridSize, corner + 1, corner + kGridSize + 1, corner + kGridSize})
+        indices.push_back(index);
+    }
+  }
+
+  engine::gl::Buffer vertex_buffer{std::span<const glm::vec3>(vertices)};
+  engine::gl::Buffer index_buffer{std::span<const GLuint>(indices)};
+  engine::gl::VertexArray vertex_array;
+  vertex_array.SetVertexBuffer(0, vertex_buffer, 0, sizeof(glm::vec3));
+  vertex_array.SetElementBuffer(index_buffer);
+  vertex_array.SetAttribute(0, 0, 3, GL_FLOAT, 0);
+  glBindVertexArray(vertex_array.Get());
+
+  const glm::mat4 projection = Projection();
+  const glm::mat4 camera = Translation(0.f, 0.f, 2.f);
+  const glm::mat4 translation = Translation(0.1f, 0.2f, 0.3f);
+  const glm::mat4 rotation = Rotation(0.5f);
+
+  engine::gl::ShaderProgram chain({
+    {GL_VERTEX_SHADER, kChainVertexSource},
+    {GL_FRAGMENT_SHADER, kFragmentSource},
+  });
+  glUseProgram(chain.Get());
+  chain.Set("projection", projection);
+  chain.Set("camera", camera);
+  chain.Set("translation", translation);
+  chain.Set("rotation", rotation);
+
+  engine::gl::ShaderProgram composed({
+    {GL_VERTEX_SHADER, kComposedVertexSource},
+    {GL_FRAGMENT_SHADER, kFragmentSource},
+  });
+  glUseProgram(composed.Get());
+  const glm::mat4 view_projection = engine::math::Multiply(projection, camera);
+  composed.Set("world_view_projection",
+    engine::math::Multiply(view_projection, engine::math::Multiply(translation, rotation)));
+
+  const GLsizei index_count = static_cast<GLsizei>(indices.size());
+  auto draw = [index_count](const engine::gl::ShaderProgram& program)
+  {
+    glUseProgram(program.Get());
+    for (uint32_t i = 0; i < kDraws; ++i)
+      glDrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, nullptr);
+  };
+
+  // Both variants in every frame, so that clock changes hit them alike
+  engine::profiling::GpuProfiler profiler;
+  for (uint32_t frame = 0; frame < kFrames; ++frame) {
+    profiler.BeginFrame();
+    {
+      engine::profiling::GpuScope scope(profiler, kChainScope);
+      draw(chain);
+    }
+    {
+      engine::profiling::GpuScope scope(profiler, kComposedScope);
+      draw(composed);
+    }
+    profiler.EndFrame();
+    context.SwapBuffers();
+  }
+
+  // Results arrive kFramesInFlight frames late, empty frames collect the last ones
+  glFinish();
+  for (size_t frame = 0; frame < engine::profiling::GpuProfiler::kFramesInFlight; ++frame) {
+    profiler.BeginFrame();
+    profiler.EndFrame();
+  }
+
+  std::printf("  %-48s %12.3f ms/draw\n", "4 matrix products per vertex, 2M triangles", DrawMs(profiler, kChainScope));
+  std::printf("  %-48s %12.3f ms/draw\n", "1 matrix product per vertex, 2M triangles", DrawMs(profiler, kComposedScope));
+  std::printf("  gpu profiler: %llu frames resolved, %llu dropped\n",
+    static_cast<unsigned long long>(profiler.ResolvedFrames()), static_cast<unsigned long long>(profiler.DroppedFrames()));
+}
+
+}  // namespace
+
+// Per-object matrix composition on the CPU, SIMD against plain glm, and the GPU
+// time it saves by leaving one matrix product per vertex
+void RunTransformBenchmarks()
+{
+  PrintSuite("transform");
+
+  RunCpuBenchmarks();
+  RunGpuBenchmarks();
+}
+
+}  // namespace benchmarks
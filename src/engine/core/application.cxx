@@ -16,59 +16,524 @@
 
 #include "core/application.hxx"
 
+#include "core/camera.hxx"
+#include "core/camera-path.hxx"
+#include "core/frame-statistics.hxx"
+#include "core/imgui-input.hxx"
+#include "gl/handle.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 namespace engine {
 namespace glfw {
 
-static void FramebufferSizeCallback(GLFWwindow* window, int width, int height)
+static void PostEvent(GLFWwindow* window, InputEvent event)
 {
-  glViewport(0, 0, width, height);
+  event.time_ns = InputTimestamp();
+  static_cast<Application*>(glfwGetWindowUserPointer(window))->PostInput(event);
 }
 
 static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
-  IUserInputHandler* application = static_cast<IUserInputHandler*>(glfwGetWindowUserPointer(window));
-  application->OnKey(key, scancode, action, mods);
+  PostEvent(window, {.type = InputEventType::Key, .code = key, .scancode = scancode, .action = action, .mods = mods});
+}
+
+static void CharCallback(GLFWwindow* window, unsigned int codepoint)
+{
+  PostEvent(window, {.type = InputEventType::Char, .code = static_cast<int32_t>(codepoint)});
+}
+
+static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+  PostEvent(window, {.type = InputEventType::MouseButton, .code = button, .action = action, .mods = mods});
 }
 
 static void MouseCallback(GLFWwindow* window, double x, double y)
 {
-  IUserInputHandler* application = static_cast<IUserInputHandler*>(glfwGetWindowUserPointer(window));
-  application->OnMouse(x, y);
+  PostEvent(window, {.type = InputEventType::CursorPosition, .x = x, .y = y});
+}
+
+static void ScrollCallback(GLFWwindow* window, double x, double y)
+{
+  PostEvent(window, {.type = InputEventType::Scroll, .x = x, .y = y});
+}
+
+static void CursorEnterCallback(GLFWwindow* window, int entered)
+{
+  PostEvent(window, {.type = InputEventType::CursorEnter, .code = entered});
+}
+
+static void FocusCallback(GLFWwindow* window, int focused)
+{
+  PostEvent(window, {.type = InputEventType::Focus, .code = focused});
+}
+
+static void WindowSizeCallback(GLFWwindow* window, int width, int height)
+{
+  PostEvent(window, {.type = InputEventType::WindowSize, .x = double(width), .y = double(height)});
+}
+
+static void FramebufferSizeCallback(GLFWwindow* window, int width, int height)
+{
+  PostEvent(window, {.type = InputEventType::FramebufferSize, .x = double(width), .y = double(height)});
 }
 
 Application::Application()
 {
+  ENGINE_PROFILE_THREAD("main");
+  ENGINE_PROFILE_FUNCTION();
+
   if (!m_window.Get())
     throw WindowInitFail();
 
   
   glfwMakeContextCurrent(m_window.Get());
-  glfwSetFramebufferSizeCallback(m_window.Get(), FramebufferSizeCallback);
 
   if (gladLoadGL() == 0)
     throw LibraryInitFail("gladLoadGL failed!");
+
+  // ENGINE_GL_CAPTURE=<file> records GL calls from here on, see gl-replay
+  if (const char* capture_path = std::getenv("ENGINE_GL_CAPTURE")) {
+    uint32_t frames = 10;
+    if (const char* value = std::getenv("ENGINE_GL_CAPTURE_FRAMES")) {
+      const char* end = value + std::strlen(value);
+      auto [last, error] = std::from_chars(value, end, frames);
+      if (error != std::errc() || last != end || frames == 0)
+        throw RuntimeError(std::string("ENGINE_GL_CAPTURE_FRAMES must be a positive frame count, got ") + value);
+    }
+    m_capture = std::make_unique<gl::CommandCapture>(capture_path, frames);
+  }
+
+  m_program_cache = std::make_unique<gl::ProgramCache>(GetCurrentExecutableDirectory() / "program-cache");
+
+  InstallInputCallbacks();
 }
 
 Application::Application(IUserInputHandler& user_input_handler)
  : Application()
 {
-  glfwSetKeyCallback(m_window.Get(), KeyCallback);
-  glfwSetWindowUserPointer(m_window.Get(), &user_input_handler);
+  m_input_handler = &user_input_handler;
   glfwSetInputMode(m_window.Get(), GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-  glfwSetCursorPosCallback(m_window.Get(), MouseCallback);
   if (glfwRawMouseMotionSupported())
     glfwSetInputMode(m_window.Get(), GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
 }
 
+Application::~Application()
+{
+  if (m_program_cache && m_program_cache->GetStats().lookups > 0)
+    m_program_cache->Report(std::cout);
+
+#ifdef ENGINE_GL_TRACK_OBJECTS
+  // Members of the derived application are gone by now, whatever is still alive has leaked
+  const gl::ObjectRegistry& registry = gl::ObjectRegistry::Instance();
+  if (registry.LiveCount() > 0)
+    registry.Report(std::cerr);
+#endif
+}
+
+// The whole value must be a number greater than zero
+template<class T>
+static T ParsePositive(const char* option, const char* value)
+{
+  T result = 0;
+  const char* end = value + std::strlen(value);
+  auto [last, error] = std::from_chars(value, end, result);
+  bool finite = true;
+  if constexpr (std::is_floating_point_v<T>)
+    finite = std::isfinite(result);
+  if (error != std::errc() || last != end || !(result > 0) || !finite)
+    throw RuntimeError(std::string(option) + " must be a positive number, got " + value);
+  return result;
+}
+
+std::optional<BenchmarkOptions> BenchmarkOptions::Parse(int argc, char** argv)
+{
+  BenchmarkOptions options;
+  bool benchmark = false;
+
+  for (int i = 1; i < argc; ++i) {
+    auto value = [argc, argv, &i]() -> const char*
+    {
+      if (i + 1 >= argc)
+        throw RuntimeError(std::string("Missing value for ") + argv[i]);
+      return argv[++i];
+    };
+
+    if (std::strcmp(argv[i], "--benchmark") == 0) {
+      options.camera_path = value();
+      benchmark = true;
+    }
+    else if (std::strcmp(argv[i], "--replay-input") == 0) {
+      options.input_replay = value();
+      benchmark = true;
+    }
+    else if (std::strcmp(argv[i], "--replay-timing") == 0) {
+      const char* timing = value();
+      if (std::strcmp(timing, "original") == 0)
+        options.replay_timing = ReplayTiming::Original;
+      else if (std::strcmp(timing, "fixed") == 0)
+        options.replay_timing = ReplayTiming::Fixed;
+      else
+        throw RuntimeError(std::string("Unknown replay timing ") + timing + ", expected original or fixed");
+    }
+    else if (std::strcmp(argv[i], "--frames") == 0) {
+      options.frames = ParsePositive<uint32_t>("--frames", value());
+    }
+    else if (std::strcmp(argv[i], "--timestep") == 0) {
+      options.timestep = ParsePositive<float>("--timestep", value());
+    }
+    else if (std::strcmp(argv[i], "--headless") == 0) {
+      options.headless = true;
+    }
+    else if (std::strcmp(argv[i], "--benchmark-output") == 0) {
+      options.output_directory = value();
+    }
+  }
+
+  if (!benchmark)
+    return std::nullopt;
+  return options;
+}
+
+void Application::InstallInputCallbacks()
+{
+  GLFWwindow* window = GetWindow();
+  glfwSetWindowUserPointer(window, this);
+  glfwSetKeyCallback(window, KeyCallback);
+  glfwSetCharCallback(window, CharCallback);
+  glfwSetMouseButtonCallback(window, MouseButtonCallback);
+  glfwSetCursorPosCallback(window, MouseCallback);
+  glfwSetScrollCallback(window, ScrollCallback);
+  glfwSetCursorEnterCallback(window, CursorEnterCallback);
+  glfwSetWindowFocusCallback(window, FocusCallback);
+  glfwSetWindowSizeCallback(window, WindowSizeCallback);
+  glfwSetFramebufferSizeCallback(window, FramebufferSizeCallback);
+
+  // The callbacks only report changes, the first frame needs the sizes as well
+  int width = 0, height = 0;
+  glfwGetWindowSize(window, &width, &height);
+  WindowSizeCallback(window, width, height);
+  glfwGetFramebufferSize(window, &width, &height);
+  FramebufferSizeCallback(window, width, height);
+}
+
+void Application::PostInput(const InputEvent& event)
+{
+  m_input_queue.Push(event);
+}
+
+void Application::ProcessInput()
+{
+  m_input.BeginFrame();
+
+  InputEvent event;
+  while (m_input_queue.Pop(event)) {
+    if (m_replay_events && !IsWindowEvent(event.type))
+      continue;
+    m_input.Apply(event);
+  }
+
+  if (m_replay_events) {
+    for (const InputEvent& replayed : *m_replay_events)
+      m_input.Apply(replayed);
+  }
+
+  if (m_input_handler)
+    m_input_handler->OnInput(m_input);
+}
+
+void Application::Run(int argc, char** argv)
+{
+  if (std::optional<BenchmarkOptions> options = BenchmarkOptions::Parse(argc, argv)) {
+    RunBenchmark(*options);
+    return;
+  }
+
+  bool input_thread = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--input-thread") == 0) {
+      input_thread = true;
+    }
+    else if (std::strcmp(argv[i], "--record-input") == 0) {
+      if (i + 1 >= argc)
+        throw RuntimeError("Missing value for --record-input");
+      m_input_recorder = std::make_unique<InputRecorder>(argv[++i]);
+    }
+  }
+
+  if (input_thread)
+    RunWithInputThread();
+  else
+    Run();
+
+  if (m_input_recorder) {
+    m_input_recorder->Finish();
+    std::cout << "Recorded input of " << m_input_recorder->Frames() << " frames" << std::endl;
+    m_input_recorder.reset();
+  }
+}
+
 void Application::Run()
 {
+  auto previous = std::chrono::steady_clock::now();
   while (!glfwWindowShouldClose(GetWindow())) {
+    auto now = std::chrono::steady_clock::now();
+    m_delta_time = std::chrono::duration<float>(now - previous).count();
+    previous = now;
+
+    Frame();
+  }
+}
+
+// Keeps live input away from callbacks installed over the engine ones, e.g.
+// ImGui's, while it lives. The engine callbacks go back on top and only queue
+// events, the ones they replaced are restored afterwards.
+class EngineCallbacksOnTop
+{
+public:
+  explicit EngineCallbacksOnTop(GLFWwindow* window)
+   : m_window(window)
+  {
+    m_key = glfwSetKeyCallback(window, KeyCallback);
+    m_character = glfwSetCharCallback(window, CharCallback);
+    m_mouse_button = glfwSetMouseButtonCallback(window, MouseButtonCallback);
+    m_cursor_position = glfwSetCursorPosCallback(window, MouseCallback);
+    m_scroll = glfwSetScrollCallback(window, ScrollCallback);
+    m_cursor_enter = glfwSetCursorEnterCallback(window, CursorEnterCallback);
+    m_focus = glfwSetWindowFocusCallback(window, FocusCallback);
+  }
+
+  ~EngineCallbacksOnTop()
+  {
+    glfwSetKeyCallback(m_window, m_key);
+    glfwSetCharCallback(m_window, m_character);
+    glfwSetMouseButtonCallback(m_window, m_mouse_button);
+    glfwSetCursorPosCallback(m_window, m_cursor_position);
+    glfwSetScrollCallback(m_window, m_scroll);
+    glfwSetCursorEnterCallback(m_window, m_cursor_enter);
+    glfwSetWindowFocusCallback(m_window, m_focus);
+  }
+
+  EngineCallbacksOnTop(const EngineCallbacksOnTop&) = delete;
+  EngineCallbacksOnTop& operator=(const EngineCallbacksOnTop&) = delete;
+
+private:
+  GLFWwindow* m_window;
+  GLFWkeyfun m_key;
+  GLFWcharfun m_character;
+  GLFWmousebuttonfun m_mouse_button;
+  GLFWcursorposfun m_cursor_position;
+  GLFWscrollfun m_scroll;
+  GLFWcursorenterfun m_cursor_enter;
+  GLFWwindowfocusfun m_focus;
+};
+
+void Application::RunWithInputThread()
+{
+  GLFWwindow* window = GetWindow();
+
+  // ImGui's callbacks would change its state on this thread while the render
+  // thread draws with it, NewImGuiFrame() feeds it from the queue instead
+  EngineCallbacksOnTop callbacks(window);
+  m_input_thread = true;
+
+  std::atomic<bool> finished = false;
+  std::exception_ptr error;
+
+  glfwMakeContextCurrent(nullptr);
+  std::thread render([this, window, &finished, &error]
+  {
+    ENGINE_PROFILE_THREAD("render");
+    glfwMakeContextCurrent(window);
+    try {
+      Run();
+    }
+    catch (...) {
+      error = std::current_exception();
+    }
+    glfwMakeContextCurrent(nullptr);
+
+    finished = true;
+    glfwPostEmptyEvent();
+  });
+
+  // Sleeps until the OS has something, the callbacks stamp every event as it comes
+  while (!finished)
+    glfwWaitEvents();
+  render.join();
+
+  // GL objects of the derived application are destroyed on this thread
+  glfwMakeContextCurrent(window);
+  m_input_thread = false;
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void Application::NewImGuiFrame()
+{
+  if (m_input_thread)
+    NewImGuiFrameFromInput(m_input, m_delta_time);
+  else
+    ImGui_ImplGlfw_NewFrame();
+}
+
+// While replaying, the engine callbacks drop live events, and ImGui is told to
+// ignore the cursor it polls itself
+class LiveInputMute
+{
+public:
+  explicit LiveInputMute(GLFWwindow* window)
+   : m_callbacks(window)
+  {
+    if (ImGui::GetCurrentContext()) {
+      m_imgui_flags = ImGui::GetIO().ConfigFlags;
+      ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_NoMouse;
+    }
+  }
+
+  ~LiveInputMute()
+  {
+    if (m_imgui_flags && ImGui::GetCurrentContext())
+      ImGui::GetIO().ConfigFlags = *m_imgui_flags;
+  }
+
+  LiveInputMute(const LiveInputMute&) = delete;
+  LiveInputMute& operator=(const LiveInputMute&) = delete;
+
+private:
+  EngineCallbacksOnTop m_callbacks;
+  std::optional<ImGuiConfigFlags> m_imgui_flags;
+};
+
+static std::filesystem::path ResolveInputPath(std::filesystem::path path)
+{
+  if (path.is_relative() && !std::filesystem::exists(path))
+    path = GetCurrentExecutableDirectory() / path;
+  return path;
+}
+
+void Application::RunBenchmark(const BenchmarkOptions& options)
+{
+  std::optional<CameraPath> path;
+  if (!options.camera_path.empty())
+    path = CameraPath::Load(ResolveInputPath(options.camera_path));
+
+  std::optional<InputReplay> replay;
+  std::optional<LiveInputMute> mute;
+  if (!options.input_replay.empty()) {
+    replay.emplace(InputRecording::Load(ResolveInputPath(options.input_replay)), options.replay_timing, options.timestep);
+    // Live input reaching the UI would make runs differ
+    mute.emplace(GetWindow());
+  }
+
+  // A path sets the camera pose, a replay moves the camera through its input
+  Camera* camera = path ? GetCamera() : nullptr;
+  if (camera)
+    camera->SetInputEnabled(false);
+
+  if (options.headless)
+    glfwHideWindow(GetWindow());
+
+  // Uncapped, otherwise every sample measures the display refresh rate
+  glfwSwapInterval(0);
+  m_delta_time = options.timestep;
+
+  const uint32_t frames = options.frames.value_or(replay && !path ? static_cast<uint32_t>(replay->FrameCount()) : 1000);
+  std::vector<double> frame_times_ms;
+  frame_times_ms.reserve(frames);
+
+  for (uint32_t frame = 0; frame < frames && !glfwWindowShouldClose(GetWindow()); ++frame) {
+    auto start = std::chrono::steady_clock::now();
+
+    if (camera)
+      camera->SetPose(path->Evaluate(frame * options.timestep));
+    if (replay) {
+      // Past the end of the recording frames go on without input
+      const bool recorded = frame < replay->FrameCount();
+      m_delta_time = recorded ? replay->DeltaTime(frame) : options.timestep;
+      m_replay_events = recorded ? replay->Events(frame) : std::span<const InputEvent>();
+    }
+    Frame();
+
+    frame_times_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+  }
+
+  m_replay_events.reset();
+  mute.reset();
+  if (camera)
+    camera->SetInputEnabled(true);
+
+  FrameTimeSummary summary = SummarizeFrameTimes(frame_times_ms);
+  PrintFrameTimeSummary(std::cout, summary);
+
+  std::filesystem::create_directories(options.output_directory);
+  WriteFrameTimesCsv(options.output_directory / "frames.csv", frame_times_ms);
+  WriteFrameTimeSummaryCsv(options.output_directory / "summary.csv", summary);
+}
+
+void Application::Frame()
+{
+  ENGINE_PROFILE_FRAME();
+
+  if (m_capture)
+    m_capture->BeginFrame();
+
+  {
+    ENGINE_PROFILE_SCOPE("Input");
+    ProcessInput();
+    if (m_input_recorder)
+      m_input_recorder->WriteFrame(m_delta_time, m_input.Events());
+  }
+
+  // Follows framebuffer resizes, the cache drops the call while the size is unchanged
+  const glm::ivec2 framebuffer = m_input.FramebufferSize();
+  m_state_cache.Viewport(0, 0, framebuffer.x, framebuffer.y);
+
+  {
+    ENGINE_PROFILE_SCOPE("OnUpdate");
     OnUpdate();
+  }
+
+  {
+    ENGINE_PROFILE_SCOPE("OnRender");
     OnRender();
+  }
 
+  {
+    ENGINE_PROFILE_SCOPE("SwapBuffers");
     glfwSwapBuffers(GetWindow());
+  }
+
+  if (m_capture) {
+    m_capture->EndFrame();
+    if (m_capture->IsFinished())
+      m_capture.reset();
+  }
+
+  // Queued by the callbacks, processed at the start of the next frame. With an
+  // input thread the main thread pumps them as they arrive.
+  if (!m_input_thread) {
+    ENGINE_PROFILE_SCOPE("PollEvents");
     glfwPollEvents();
   }
+
+  m_frame_arena.EndFrame();
 }
 
 } // namespace glfw
@@ -0,0 +1,100 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "core/camera-path.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace engine::glfw
+{
+
+static glm::vec3 CatmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t)
+{
+  float t2 = t * t;
+  float t3 = t2 * t;
+  return 0.5f * ((2.f * p1) +
+                 (p2 - p0) * t +
+                 (2.f * p0 - 5.f * p1 + 4.f * p2 - p3) * t2 +
+                 (3.f * p1 - p0 - 3.f * p2 + p3) * t3);
+}
+
+CameraPath CameraPath::Load(const std::filesystem::path& path)
+{
+  std::ifstream stream(path);
+  if (!stream)
+    throw RuntimeError("Failed to open camera path " + path.string());
+
+  std::vector<CameraKeyframe> keyframes;
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream fields(line);
+    CameraKeyframe keyframe;
+    fields >> keyframe.time >> keyframe.pose.position.x >> keyframe.pose.position.y >> keyframe.pose.position.z
+           >> keyframe.pose.yaw >> keyframe.pose.pitch;
+    if (!fields)
+      throw RuntimeError("Malformed camera keyframe in " + path.string() + ": " + line);
+
+    keyframes.push_back(keyframe);
+  }
+
+  return CameraPath(std::move(keyframes));
+}
+
+CameraPath::CameraPath(std::vector<CameraKeyframe> keyframes)
+ : m_keyframes(std::move(keyframes))
+{
+  if (m_keyframes.empty())
+    throw RuntimeError("Camera path has no keyframes");
+
+  std::stable_sort(m_keyframes.begin(), m_keyframes.end(),
+    [](const CameraKeyframe& a, const CameraKeyframe& b) { return a.time < b.time; });
+}
+
+CameraPose CameraPath::Evaluate(float time) const
+{
+  if (time <= m_keyframes.front().time)
+    return m_keyframes.front().pose;
+  if (time >= m_keyframes.back().time)
+    return m_keyframes.back().pose;
+
+  auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+    [](float value, const CameraKeyframe& keyframe) { return value < keyframe.time; });
+  size_t i = std::distance(m_keyframes.begin(), next) - 1;
+
+  const CameraKeyframe& k1 = m_keyframes[i];
+  const CameraKeyframe& k2 = m_keyframes[i + 1];
+  const CameraKeyframe& k0 = m_keyframes[i > 0 ? i - 1 : i];
+  const CameraKeyframe& k3 = m_keyframes[std::min(i + 2, m_keyframes.size() - 1)];
+
+  float span = k2.time - k1.time;
+  float t = span > 0.f ? (time - k1.time) / span : 0.f;
+
+  CameraPose pose;
+  pose.position = CatmullRom(k0.pose.position, k1.pose.position, k2.pose.position, k3.pose.position, t);
+  pose.yaw = k1.pose.yaw + (k2.pose.yaw - k1.pose.yaw) * t;
+  pose.pitch = k1.pose.pitch + (k2.pose.pitch - k1.pose.pitch) * t;
+  return pose;
+}
+
+}  // namespace engine::glfw
@@ -16,6 +16,9 @@
 
 #include "core/camera.hxx"
 
+#include "math/kernels.hxx"
+#include "profiling/cpu-profiler.hxx"
+
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/detail/type_quat.hpp>
@@ -52,11 +55,11 @@ float CyclicClamp(float value, float minValue, float maxValue)
 
 void Camera::OnFrame(Application& application, float deltaTime)
 {
-  m_pressed.w = glfwGetKey(application.GetWindow(), GLFW_KEY_W) == GLFW_PRESS;
-  m_pressed.s = glfwGetKey(application.GetWindow(), GLFW_KEY_S) == GLFW_PRESS;
-  m_pressed.a = glfwGetKey(application.GetWindow(), GLFW_KEY_A) == GLFW_PRESS;
-  m_pressed.d = glfwGetKey(application.GetWindow(), GLFW_KEY_D) == GLFW_PRESS;
-  
+  ENGINE_PROFILE_FUNCTION();
+
+  if (!m_input_enabled)
+    return;
+
   glm::vec3 direction = glm::vec3(0.f);
   if (m_pressed.w) {
     direction += n;
@@ -80,52 +83,57 @@ void Camera::OnFrame(Application& application, float deltaTime)
 
   glm::vec3 velocity = m_speed * direction;
   m_position = m_position + velocity * deltaTime;
-
-  m_pressed = {};
 }
 
-void Camera::OnKey(int key, int scancode, int action, int mods)
-{}
-
 
 constexpr float Radians(float degrees)
 {
   return std::numbers::pi_v<float> / 180.f * degrees;
 }
 
-void Camera::OnMouse(double x, double y)
+void Camera::OnInput(const InputState& input)
 {
-  std::call_once(m_initialized_mouse_position, [&mouse_pos = m_mouse_pos ,x, y]
-  {
-      mouse_pos = {x , y};
-  });
+  ENGINE_PROFILE_FUNCTION();
 
-  glm::vec2 mouse_pos_diff = {x - m_mouse_pos.x, m_mouse_pos.y - y};
-  m_mouse_pos = {x, y};
+  m_pressed.w = input.IsKeyDown(GLFW_KEY_W);
+  m_pressed.s = input.IsKeyDown(GLFW_KEY_S);
+  m_pressed.a = input.IsKeyDown(GLFW_KEY_A);
+  m_pressed.d = input.IsKeyDown(GLFW_KEY_D);
 
-  m_pitch = glm::clamp(m_pitch + mouse_pos_diff.y, -45.f, 45.f);
-  m_yaw = CyclicClamp(m_yaw + mouse_pos_diff.x, 0.f, 360.f);
+  // Every mouse move of the frame at once, one orientation update per frame
+  const glm::dvec2 delta = input.CursorDelta();
+  if (!m_input_enabled || (delta.x == 0.0 && delta.y == 0.0))
+    return;
 
-  float quat_pitch = m_pitch / 2.f;
-  float quat_yaw = m_yaw / 2.f;
+  m_pitch = glm::clamp(m_pitch - static_cast<float>(delta.y), -45.f, 45.f);
+  m_yaw = CyclicClamp(m_yaw + static_cast<float>(delta.x), 0.f, 360.f);
 
-  glm::quat rotate_yaw = glm::quat(std::cos(Radians(quat_yaw)), 0.f, std::sin(Radians(quat_yaw)), 0.f);
-  glm::quat rotate_yaw_conjugate(rotate_yaw.w, -rotate_yaw.x, -rotate_yaw.y, -rotate_yaw.z);
-  glm::quat new_x_quat = rotate_yaw * glm::quat(0.f, 1.f, 0.f, 0.f) * rotate_yaw_conjugate;
-  glm::vec3 new_x = glm::normalize(glm::vec3(new_x_quat.x, new_x_quat.y, new_x_quat.z));
+  UpdateOrientation();
+}
 
-  glm::quat rotate_pitch(std::cos(Radians(quat_pitch)), new_x.x * std::sin(Radians(quat_pitch)), new_x.y * std::sin(Radians(quat_pitch)), new_x.z * std::sin(Radians(quat_pitch)));
-  glm::quat rotate_pitch_conjugate(rotate_pitch.w, -rotate_pitch.x, -rotate_pitch.y, -rotate_pitch.z);
-  glm::vec3 up_y(0.f, 1.f, 0.f);
-  glm::vec3 current_z = glm::cross(new_x, up_y);
-  glm::quat new_z_quat = rotate_pitch * glm::quat(0.f, current_z.x, current_z.y, current_z.z) * rotate_pitch_conjugate;
-  glm::vec3 new_z = glm::normalize(glm::vec3(new_z_quat.x, new_z_quat.y, new_z_quat.z));
+void Camera::SetPose(const CameraPose& pose)
+{
+  m_position = pose.position;
+  m_pitch = glm::clamp(pose.pitch, -45.f, 45.f);
+  m_yaw = pose.yaw;
 
-  glm::vec3 new_y = glm::normalize(glm::cross(new_x, new_z));
+  UpdateOrientation();
+}
 
-  u = new_x;
-  v = new_y;
-  n = new_z;
+void Camera::UpdateOrientation()
+{
+  // Yaw about the world up, then pitch about the yawed x axis: one quaternion
+  // product and one rotation matrix instead of two sandwich products per axis
+  const float half_pitch = Radians(m_pitch) / 2.f;
+  const float half_yaw = Radians(m_yaw) / 2.f;
+  const glm::quat rotate_yaw(std::cos(half_yaw), 0.f, std::sin(half_yaw), 0.f);
+  const glm::quat rotate_pitch(std::cos(half_pitch), std::sin(half_pitch), 0.f, 0.f);
+  const glm::mat4 rotation = math::QuaternionToMatrix(rotate_yaw * rotate_pitch);
+
+  u = glm::vec3(rotation[0]);
+  n = glm::vec3(rotation[2]);
+  // cross(u, n)
+  v = -glm::vec3(rotation[1]);
 }
 
 
@@ -0,0 +1,91 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "core/frame-statistics.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace engine
+{
+
+static double Percentile(const std::vector<double>& sorted, double percentile)
+{
+  size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+FrameTimeSummary SummarizeFrameTimes(std::vector<double> frame_times_ms)
+{
+  FrameTimeSummary summary;
+  if (frame_times_ms.empty())
+    return summary;
+
+  std::sort(frame_times_ms.begin(), frame_times_ms.end());
+
+  summary.frames = frame_times_ms.size();
+  summary.min_ms = frame_times_ms.front();
+  summary.max_ms = frame_times_ms.back();
+  summary.average_ms = std::accumulate(frame_times_ms.begin(), frame_times_ms.end(), 0.0) / frame_times_ms.size();
+  summary.p50_ms = Percentile(frame_times_ms, 50.0);
+  summary.p95_ms = Percentile(frame_times_ms, 95.0);
+  summary.p99_ms = Percentile(frame_times_ms, 99.0);
+  return summary;
+}
+
+void PrintFrameTimeSummary(std::ostream& stream, const FrameTimeSummary& summary)
+{
+  stream << summary.frames << " frames, ms:"
+         << " min " << summary.min_ms
+         << " avg " << summary.average_ms
+         << " p50 " << summary.p50_ms
+         << " p95 " << summary.p95_ms
+         << " p99 " << summary.p99_ms
+         << " max " << summary.max_ms << '\n';
+}
+
+void WriteFrameTimesCsv(const std::filesystem::path& path, const std::vector<double>& frame_times_ms)
+{
+  std::ofstream stream(path);
+  if (!stream)
+    throw RuntimeError("Failed to open " + path.string());
+
+  stream << "frame,ms\n";
+  for (size_t i = 0; i < frame_times_ms.size(); ++i)
+    stream << i << ',' << frame_times_ms[i] << '\n';
+}
+
+void WriteFrameTimeSummaryCsv(const std::filesystem::path& path, const FrameTimeSummary& summary)
+{
+  std::ofstream stream(path);
+  if (!stream)
+    throw RuntimeError("Failed to open " + path.string());
+
+  stream << "statistic,ms\n"
+         << "frames," << summary.frames << '\n'
+         << "min," << summary.min_ms << '\n'
+         << "avg," << summary.average_ms << '\n'
+         << "p50," << summary.p50_ms << '\n'
+         << "p95," << summary.p95_ms << '\n'
+         << "p99," << summary.p99_ms << '\n'
+         << "max," << summary.max_ms << '\n';
+}
+
+}  // namespace engine
@@ -0,0 +1,159 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "core/imgui-input.hxx"
+
+// Include in this order to prevent GL header & Windows redefenition errors
+#include "glad/glad.h"
+#include <GLFW/glfw3.h>
+//
+
+#include <imgui.h>
+
+#include <cfloat>
+
+namespace engine::glfw
+{
+
+namespace
+{
+
+ImGuiKey ToImGuiKey(int key)
+{
+  // Contiguous in both enumerations
+  if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z)
+    return static_cast<ImGuiKey>(ImGuiKey_A + (key - GLFW_KEY_A));
+  if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9)
+    return static_cast<ImGuiKey>(ImGuiKey_0 + (key - GLFW_KEY_0));
+  if (key >= GLFW_KEY_KP_0 && key <= GLFW_KEY_KP_9)
+    return static_cast<ImGuiKey>(ImGuiKey_Keypad0 + (key - GLFW_KEY_KP_0));
+  if (key >= GLFW_KEY_F1 && key <= GLFW_KEY_F12)
+    return static_cast<ImGuiKey>(ImGuiKey_F1 + (key - GLFW_KEY_F1));
+
+  switch (key) {
+  case GLFW_KEY_TAB: return ImGuiKey_Tab;
+  case GLFW_KEY_LEFT: return ImGuiKey_LeftArrow;
+  case GLFW_KEY_RIGHT: return ImGuiKey_RightArrow;
+  case GLFW_KEY_UP: return ImGuiKey_UpArrow;
+  case GLFW_KEY_DOWN: return ImGuiKey_DownArrow;
+  case GLFW_KEY_PAGE_UP: return ImGuiKey_PageUp;
+  case GLFW_KEY_PAGE_DOWN: return ImGuiKey_PageDown;
+  case GLFW_KEY_HOME: return ImGuiKey_Home;
+  case GLFW_KEY_END: return ImGuiKey_End;
+  case GLFW_KEY_INSERT: return ImGuiKey_Insert;
+  case GLFW_KEY_DELETE: return ImGuiKey_Delete;
+  case GLFW_KEY_BACKSPACE: return ImGuiKey_Backspace;
+  case GLFW_KEY_SPACE: return ImGuiKey_Space;
+  case GLFW_KEY_ENTER: return ImGuiKey_Enter;
+  case GLFW_KEY_ESCAPE: return ImGuiKey_Escape;
+  case GLFW_KEY_APOSTROPHE: return ImGuiKey_Apostrophe;
+  case GLFW_KEY_COMMA: return ImGuiKey_Comma;
+  case GLFW_KEY_MINUS: return ImGuiKey_Minus;
+  case GLFW_KEY_PERIOD: return ImGuiKey_Period;
+  case GLFW_KEY_SLASH: return ImGuiKey_Slash;
+  case GLFW_KEY_SEMICOLON: return ImGuiKey_Semicolon;
+  case GLFW_KEY_EQUAL: return ImGuiKey_Equal;
+  case GLFW_KEY_LEFT_BRACKET: return ImGuiKey_LeftBracket;
+  case GLFW_KEY_BACKSLASH: return ImGuiKey_Backslash;
+  case GLFW_KEY_RIGHT_BRACKET: return ImGuiKey_RightBracket;
+  case GLFW_KEY_GRAVE_ACCENT: return ImGuiKey_GraveAccent;
+  case GLFW_KEY_CAPS_LOCK: return ImGuiKey_CapsLock;
+  case GLFW_KEY_SCROLL_LOCK: return ImGuiKey_ScrollLock;
+  case GLFW_KEY_NUM_LOCK: return ImGuiKey_NumLock;
+  case GLFW_KEY_PRINT_SCREEN: return ImGuiKey_PrintScreen;
+  case GLFW_KEY_PAUSE: return ImGuiKey_Pause;
+  case GLFW_KEY_KP_DECIMAL: return ImGuiKey_KeypadDecimal;
+  case GLFW_KEY_KP_DIVIDE: return ImGuiKey_KeypadDivide;
+  case GLFW_KEY_KP_MULTIPLY: return ImGuiKey_KeypadMultiply;
+  case GLFW_KEY_KP_SUBTRACT: return ImGuiKey_KeypadSubtract;
+  case GLFW_KEY_KP_ADD: return ImGuiKey_KeypadAdd;
+  case GLFW_KEY_KP_ENTER: return ImGuiKey_KeypadEnter;
+  case GLFW_KEY_KP_EQUAL: return ImGuiKey_KeypadEqual;
+  case GLFW_KEY_LEFT_SHIFT: return ImGuiKey_LeftShift;
+  case GLFW_KEY_LEFT_CONTROL: return ImGuiKey_LeftCtrl;
+  case GLFW_KEY_LEFT_ALT: return ImGuiKey_LeftAlt;
+  case GLFW_KEY_LEFT_SUPER: return ImGuiKey_LeftSuper;
+  case GLFW_KEY_RIGHT_SHIFT: return ImGuiKey_RightShift;
+  case GLFW_KEY_RIGHT_CONTROL: return ImGuiKey_RightCtrl;
+  case GLFW_KEY_RIGHT_ALT: return ImGuiKey_RightAlt;
+  case GLFW_KEY_RIGHT_SUPER: return ImGuiKey_RightSuper;
+  case GLFW_KEY_MENU: return ImGuiKey_Menu;
+  default: return ImGuiKey_None;
+  }
+}
+
+// GLFW reports the modifiers with each event, ImGui wants them as key events of their own
+void AddModifiers(ImGuiIO& io, int mods)
+{
+  io.AddKeyEvent(ImGuiMod_Ctrl, (mods & GLFW_MOD_CONTROL) != 0);
+  io.AddKeyEvent(ImGuiMod_Shift, (mods & GLFW_MOD_SHIFT) != 0);
+  io.AddKeyEvent(ImGuiMod_Alt, (mods & GLFW_MOD_ALT) != 0);
+  io.AddKeyEvent(ImGuiMod_Super, (mods & GLFW_MOD_SUPER) != 0);
+}
+
+}  // namespace
+
+void NewImGuiFrameFromInput(const InputState& input, float delta_time)
+{
+  ImGuiIO& io = ImGui::GetIO();
+
+  const glm::ivec2 window = input.WindowSize();
+  const glm::ivec2 framebuffer = input.FramebufferSize();
+  io.DisplaySize = ImVec2(static_cast<float>(window.x), static_cast<float>(window.y));
+  if (window.x > 0 && window.y > 0)
+    io.DisplayFramebufferScale = ImVec2(static_cast<float>(framebuffer.x) / window.x,
+      static_cast<float>(framebuffer.y) / window.y);
+  // ImGui asserts on a zero delta, which the first frame has
+  io.DeltaTime = delta_time > 0.f ? delta_time : 1.f / 60.f;
+
+  for (const InputEvent& event : input.Events()) {
+    switch (event.type) {
+    case InputEventType::Key:
+      // Repeats are derived by ImGui itself
+      if (event.action == GLFW_REPEAT)
+        break;
+      AddModifiers(io, event.mods);
+      io.AddKeyEvent(ToImGuiKey(event.code), event.action == GLFW_PRESS);
+      break;
+    case InputEventType::Char:
+      io.AddInputCharacter(static_cast<unsigned int>(event.code));
+      break;
+    case InputEventType::MouseButton:
+      AddModifiers(io, event.mods);
+      if (event.code >= 0 && event.code < ImGuiMouseButton_COUNT)
+        io.AddMouseButtonEvent(event.code, event.action == GLFW_PRESS);
+      break;
+    case InputEventType::CursorPosition:
+      io.AddMousePosEvent(static_cast<float>(event.x), static_cast<float>(event.y));
+      break;
+    case InputEventType::Scroll:
+      io.AddMouseWheelEvent(static_cast<float>(event.x), static_cast<float>(event.y));
+      break;
+    case InputEventType::CursorEnter:
+      // A cursor outside the window hovers nothing
+      if (event.code == 0)
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+      break;
+    case InputEventType::Focus:
+      io.AddFocusEvent(event.code != 0);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+}  // namespace engine::glfw
@@ -0,0 +1,348 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "core/input-recording.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace engine::glfw
+{
+
+namespace
+{
+
+// File layout: header, then per frame {varint event count, float delta time}
+// followed by its events {uint8 type, zigzag varint time delta, payload}
+constexpr uint32_t kMagic = 0x50524e49;  // "INRP"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kFlushThreshold = 64u << 10;
+
+struct FileHeader
+{
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  // Left at 0 when the recording was not finished
+  uint32_t frames = 0;
+  uint32_t reserved = 0;
+};
+
+uint64_t ZigZag(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class Writer
+{
+public:
+  explicit Writer(std::vector<uint8_t>& buffer) : m_buffer(buffer) {}
+
+  template<class T>
+  void Write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteVarint(uint64_t value)
+  {
+    for (; value >= 0x80; value >>= 7)
+      m_buffer.push_back(static_cast<uint8_t>(value | 0x80));
+    m_buffer.push_back(static_cast<uint8_t>(value));
+  }
+
+  void WriteSigned(int64_t value) { WriteVarint(ZigZag(value)); }
+
+private:
+  std::vector<uint8_t>& m_buffer;
+};
+
+class Reader
+{
+public:
+  Reader(const std::vector<uint8_t>& data, size_t position, const std::filesystem::path& path)
+   : m_data(data), m_position(position), m_path(path)
+  {}
+
+  bool AtEnd() const { return m_position == m_data.size(); }
+
+  template<class T>
+  T Read()
+  {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = *Take(1);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+        return value;
+    }
+    throw InputRecordingFail("Malformed varint in " + m_path.string());
+  }
+
+  int64_t ReadSigned() { return UnZigZag(ReadVarint()); }
+
+private:
+  const uint8_t* Take(size_t size)
+  {
+    if (m_data.size() - m_position < size)
+      throw InputRecordingFail("Truncated input recording " + m_path.string());
+    const uint8_t* bytes = m_data.data() + m_position;
+    m_position += size;
+    return bytes;
+  }
+
+  const std::vector<uint8_t>& m_data;
+  size_t m_position = 0;
+  const std::filesystem::path& m_path;
+};
+
+void WriteEvent(Writer& writer, const InputEvent& event, int64_t time_delta_ns)
+{
+  writer.Write(static_cast<uint8_t>(event.type));
+  writer.WriteSigned(time_delta_ns);
+
+  switch (event.type) {
+  case InputEventType::Key:
+    writer.WriteSigned(event.code);
+    writer.WriteSigned(event.scancode);
+    writer.Write(static_cast<uint8_t>(event.action));
+    writer.Write(static_cast<uint8_t>(event.mods));
+    break;
+  case InputEventType::Char:
+    writer.WriteVarint(static_cast<uint32_t>(event.code));
+    break;
+  case InputEventType::MouseButton:
+    writer.Write(static_cast<uint8_t>(event.code));
+    writer.Write(static_cast<uint8_t>(event.action));
+    writer.Write(static_cast<uint8_t>(event.mods));
+    break;
+  case InputEventType::CursorPosition:
+  case InputEventType::Scroll:
+    // Exact, replayed positions have to produce the same deltas
+    writer.Write(event.x);
+    writer.Write(event.y);
+    break;
+  case InputEventType::CursorEnter:
+  case InputEventType::Focus:
+    writer.Write(static_cast<uint8_t>(event.code));
+    break;
+  case InputEventType::WindowSize:
+  case InputEventType::FramebufferSize:
+    break;
+  }
+}
+
+InputEvent ReadEvent(Reader& reader, int64_t& time_ns, const std::filesystem::path& path)
+{
+  InputEvent event;
+  const uint8_t type = reader.Read<uint8_t>();
+  if (type > static_cast<uint8_t>(InputEventType::Focus))
+    throw InputRecordingFail("Unknown input event in " + path.string());
+
+  event.type = static_cast<InputEventType>(type);
+  time_ns += reader.ReadSigned();
+  event.time_ns = time_ns;
+
+  switch (event.type) {
+  case InputEventType::Key:
+    event.code = static_cast<int32_t>(reader.ReadSigned());
+    event.scancode = static_cast<int32_t>(reader.ReadSigned());
+    event.action = reader.Read<uint8_t>();
+    event.mods = reader.Read<uint8_t>();
+    break;
+  case InputEventType::Char:
+    event.code = static_cast<int32_t>(reader.ReadVarint());
+    break;
+  case InputEventType::MouseButton:
+    event.code = reader.Read<uint8_t>();
+    event.action = reader.Read<uint8_t>();
+    event.mods = reader.Read<uint8_t>();
+    break;
+  case InputEventType::CursorPosition:
+  case InputEventType::Scroll:
+    event.x = reader.Read<double>();
+    event.y = reader.Read<double>();
+    break;
+  case InputEventType::CursorEnter:
+  case InputEventType::Focus:
+    event.code = reader.Read<uint8_t>();
+    break;
+  case InputEventType::WindowSize:
+  case InputEventType::FramebufferSize:
+    break;
+  }
+  return event;
+}
+
+}  // namespace
+
+InputRecorder::InputRecorder(const std::filesystem::path& path)
+ : m_stream(path, std::ios::binary), m_previous_time_ns(InputTimestamp())
+{
+  if (!m_stream)
+    throw InputRecordingFail("Failed to open " + path.string());
+
+  FileHeader header;
+  m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+InputRecorder::~InputRecorder()
+{
+  Finish();
+}
+
+void InputRecorder::WriteFrame(float delta_time, std::span<const InputEvent> events)
+{
+  if (m_finished)
+    return;
+
+  Writer writer(m_buffer);
+  writer.WriteVarint(events.size());
+  writer.Write(delta_time);
+
+  // Events queued before the recorder started get negative times
+  for (const InputEvent& event : events) {
+    WriteEvent(writer, event, event.time_ns - m_previous_time_ns);
+    m_previous_time_ns = event.time_ns;
+  }
+
+  ++m_frames;
+  if (m_buffer.size() > kFlushThreshold)
+    Flush();
+}
+
+void InputRecorder::Flush()
+{
+  m_stream.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+  m_stream.flush();
+  m_buffer.clear();
+}
+
+void InputRecorder::Finish()
+{
+  if (m_finished)
+    return;
+
+  m_finished = true;
+  Flush();
+
+  FileHeader header;
+  header.frames = m_frames;
+  m_stream.seekp(0);
+  m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_stream.close();
+}
+
+InputRecording InputRecording::Load(const std::filesystem::path& path)
+{
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream)
+    throw InputRecordingFail("Failed to open " + path.string());
+
+  const std::vector<uint8_t> data{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+
+  FileHeader header;
+  if (data.size() < sizeof(header))
+    throw InputRecordingFail("Not an input recording: " + path.string());
+
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion)
+    throw InputRecordingFail("Unsupported input recording: " + path.string());
+
+  // The header is not trusted with the size, a frame takes at least five bytes
+  InputRecording recording;
+  recording.m_frames.reserve(std::min<size_t>(header.frames, (data.size() - sizeof(header)) / 5));
+
+  // Read to the end rather than up to header.frames, unfinished files have no count
+  Reader reader(data, sizeof(header), path);
+  int64_t time_ns = 0;
+  while (!reader.AtEnd()) {
+    Frame frame;
+    frame.event_count = static_cast<uint32_t>(reader.ReadVarint());
+    frame.delta_time = reader.Read<float>();
+    frame.first_event = static_cast<uint32_t>(recording.m_events.size());
+    for (uint32_t i = 0; i < frame.event_count; ++i)
+      recording.m_events.push_back(ReadEvent(reader, time_ns, path));
+    recording.m_frames.push_back(frame);
+  }
+
+  return recording;
+}
+
+std::span<const InputEvent> InputRecording::FrameEvents(size_t frame) const
+{
+  const Frame& range = m_frames[frame];
+  return std::span(m_events).subspan(range.first_event, range.event_count);
+}
+
+InputReplay::InputReplay(const InputRecording& recording, ReplayTiming timing, float timestep)
+{
+  if (timing == ReplayTiming::Original) {
+    m_frames.assign(recording.Frames().begin(), recording.Frames().end());
+    m_events.assign(recording.Events().begin(), recording.Events().end());
+    return;
+  }
+
+  if (!(timestep > 0.f))
+    throw InputRecordingFail("Replay timestep must be positive");
+
+  // Integer nanoseconds, the split must not depend on float rounding. Frame
+  // k > 0 gets the events of [(k - 1) * step, k * step), frame 0 whatever was
+  // queued before the recording started.
+  const int64_t step_ns = std::llround(static_cast<double>(timestep) * 1e9);
+  std::span<const InputEvent> events = recording.Events();
+  const int64_t duration_ns = events.empty() ? 0 : std::max<int64_t>(events.back().time_ns, 0);
+  const size_t frame_count = static_cast<size_t>(duration_ns / step_ns) + 2;
+
+  m_frames.resize(frame_count);
+  m_events.assign(events.begin(), events.end());
+  size_t event = 0;
+  for (size_t k = 0; k < frame_count; ++k) {
+    InputRecording::Frame& frame = m_frames[k];
+    frame.delta_time = timestep;
+    frame.first_event = static_cast<uint32_t>(event);
+    const int64_t end_ns = static_cast<int64_t>(k) * step_ns;
+    while (event < m_events.size() && m_events[event].time_ns < end_ns)
+      ++event;
+    frame.event_count = static_cast<uint32_t>(event - frame.first_event);
+  }
+}
+
+std::span<const InputEvent> InputReplay::Events(size_t frame) const
+{
+  const InputRecording::Frame& range = m_frames[frame];
+  return std::span(m_events).subspan(range.first_event, range.event_count);
+}
+
+}  // namespace engine::glfw
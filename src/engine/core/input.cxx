@@ -0,0 +1,130 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "core/input.hxx"
+
+// Include in this order to prevent GL header & Windows redefenition errors
+#include "glad/glad.h"
+#include <GLFW/glfw3.h>
+//
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace engine::glfw
+{
+
+static_assert(GLFW_KEY_LAST < InputState::kKeyCount && GLFW_MOUSE_BUTTON_LAST < InputState::kButtonCount);
+
+int64_t InputTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+InputEventQueue::InputEventQueue(size_t capacity)
+ : m_events(std::bit_ceil(std::max<size_t>(capacity, 2))), m_mask(m_events.size() - 1)
+{}
+
+bool InputEventQueue::Push(const InputEvent& event)
+{
+  const size_t write = m_write.load(std::memory_order_relaxed);
+  if (write - m_read.load(std::memory_order_acquire) == m_events.size()) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  m_events[write & m_mask] = event;
+  m_write.store(write + 1, std::memory_order_release);
+  return true;
+}
+
+bool InputEventQueue::Pop(InputEvent& event)
+{
+  const size_t read = m_read.load(std::memory_order_relaxed);
+  if (read == m_write.load(std::memory_order_acquire))
+    return false;
+
+  event = m_events[read & m_mask];
+  m_read.store(read + 1, std::memory_order_release);
+  return true;
+}
+
+void InputState::BeginFrame()
+{
+  m_keys_pressed.reset();
+  m_keys_released.reset();
+  m_buttons_pressed.reset();
+  m_buttons_released.reset();
+  m_cursor_delta = glm::dvec2(0.0);
+  m_scroll_delta = glm::dvec2(0.0);
+  m_events.clear();
+}
+
+template<size_t N>
+void InputState::Update(std::bitset<N>& down, std::bitset<N>& pressed, std::bitset<N>& released, int index,
+  int action)
+{
+  // GLFW_KEY_UNKNOWN and anything else out of range only shows up in Events()
+  if (index < 0 || static_cast<size_t>(index) >= N)
+    return;
+
+  if (action == GLFW_PRESS) {
+    down.set(index);
+    pressed.set(index);
+  }
+  else if (action == GLFW_RELEASE) {
+    down.reset(index);
+    released.set(index);
+  }
+}
+
+void InputState::Apply(const InputEvent& event)
+{
+  if (!IsWindowEvent(event.type))
+    m_events.push_back(event);
+
+  switch (event.type) {
+  case InputEventType::Key:
+    Update(m_keys_down, m_keys_pressed, m_keys_released, event.code, event.action);
+    break;
+  case InputEventType::MouseButton:
+    Update(m_buttons_down, m_buttons_pressed, m_buttons_released, event.code, event.action);
+    break;
+  case InputEventType::CursorPosition: {
+    const glm::dvec2 position(event.x, event.y);
+    if (m_has_cursor)
+      m_cursor_delta += position - m_cursor;
+    m_cursor = position;
+    m_has_cursor = true;
+    break;
+  }
+  case InputEventType::Scroll:
+    m_scroll_delta += glm::dvec2(event.x, event.y);
+    break;
+  case InputEventType::WindowSize:
+    m_window_size = glm::ivec2(static_cast<int>(event.x), static_cast<int>(event.y));
+    break;
+  case InputEventType::FramebufferSize:
+    m_framebuffer_size = glm::ivec2(static_cast<int>(event.x), static_cast<int>(event.y));
+    break;
+  default:
+    break;
+  }
+}
+
+}  // namespace engine::glfw
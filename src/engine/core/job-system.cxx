@@ -0,0 +1,138 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "core/job-system.hxx"
+
+#include "profiling/cpu-profiler.hxx"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace engine
+{
+
+uint32_t JobSystem::DefaultWorkerCount()
+{
+  const uint32_t threads = std::thread::hardware_concurrency();
+  return threads > 1 ? threads - 1 : 0;
+}
+
+JobSystem::JobSystem(uint32_t workers)
+{
+  m_workers.reserve(workers);
+  for (uint32_t i = 0; i < workers; ++i)
+    m_workers.emplace_back([this] { WorkerLoop(); });
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const RangeFunction& function)
+{
+  if (count == 0)
+    return;
+
+  grain = std::max<size_t>(grain, 1);
+  if (m_workers.empty() || count <= grain) {
+    function(0, count);
+    return;
+  }
+
+  std::lock_guard call_lock(m_call_mutex);
+  {
+    std::lock_guard lock(m_mutex);
+    m_count = count;
+    m_grain = grain;
+    m_next.store(0, std::memory_order_relaxed);
+    m_function = &function;
+    m_error = nullptr;
+    ++m_generation;
+  }
+  m_wake.notify_all();
+
+  RunRanges();
+
+  // Workers still in a range keep the function alive until they leave, late
+  // ones find it cleared and go back to sleep
+  std::exception_ptr error;
+  {
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_active == 0; });
+    m_function = nullptr;
+    error = std::exchange(m_error, nullptr);
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void JobSystem::RunRanges()
+{
+  try {
+    for (;;) {
+      const size_t begin = m_next.fetch_add(m_grain, std::memory_order_relaxed);
+      if (begin >= m_count)
+        return;
+      (*m_function)(begin, std::min(begin + m_grain, m_count));
+    }
+  }
+  catch (...) {
+    // The first exception is rethrown by ParallelFor, the remaining ranges are skipped
+    m_next.store(m_count, std::memory_order_relaxed);
+    std::lock_guard lock(m_mutex);
+    if (!m_error)
+      m_error = std::current_exception();
+  }
+}
+
+void JobSystem::WorkerLoop()
+{
+  ENGINE_PROFILE_THREAD("job worker");
+
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(m_mutex);
+      m_wake.wait(lock, [this, seen] { return m_stop || m_generation != seen; });
+      if (m_stop)
+        return;
+      seen = m_generation;
+      if (!m_function)
+        continue;
+      ++m_active;
+    }
+
+    RunRanges();
+
+    {
+      std::lock_guard lock(m_mutex);
+      --m_active;
+    }
+    m_idle.notify_one();
+  }
+}
+
+}  // namespace engine
@@ -0,0 +1,49 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/buffer.hxx"
+
+namespace engine::gl
+{
+
+Buffer::Buffer(GLsizeiptr size, const void* data, GLbitfield flags, const std::source_location& location)
+ : m_buffer(BufferHandle::Create(location)), m_size(size)
+{
+  glNamedBufferStorage(m_buffer.Get(), size, data, flags);
+  m_buffer.SetBytes(static_cast<size_t>(size));
+}
+
+void Buffer::Update(GLintptr offset, GLsizeiptr size, const void* data)
+{
+  glNamedBufferSubData(m_buffer.Get(), offset, size, data);
+}
+
+void* Buffer::Map(GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+  return glMapNamedBufferRange(m_buffer.Get(), offset, length, access);
+}
+
+void Buffer::FlushMappedRange(GLintptr offset, GLsizeiptr length)
+{
+  glFlushMappedNamedBufferRange(m_buffer.Get(), offset, length);
+}
+
+void Buffer::Unmap()
+{
+  glUnmapNamedBuffer(m_buffer.Get());
+}
+
+}  // namespace engine::gl
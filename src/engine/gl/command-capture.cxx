@@ -0,0 +1,1870 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/command-capture.hxx"
+
+#include "core/exceptions.hxx"
+#include "gl/extensions.hxx"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+// File layout: header, then records of {uint16 call, uint32 payload size, payload}
+constexpr uint32_t kMagic = 0x50434c47;  // "GLCP"
+constexpr uint32_t kVersion = 6;
+constexpr uint64_t kNullBlob = ~uint64_t(0);
+constexpr size_t kFlushThreshold = 16u << 20;
+
+struct FileHeader
+{
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint32_t frames = 0;
+  uint32_t reserved = 0;
+};
+
+enum class ObjectType : uint8_t
+{
+  Buffer,
+  Texture,
+  VertexArray,
+  Shader,
+  Program,
+  Query,
+  Sampler,
+  Framebuffer,
+  Count,
+};
+
+class Recorder
+{
+public:
+  void Begin(uint16_t call)
+  {
+    m_record_start = m_buffer.size();
+    Write(call);
+    Write(uint32_t(0));
+  }
+
+  void End()
+  {
+    uint32_t size = static_cast<uint32_t>(m_buffer.size() - m_record_start - sizeof(uint16_t) - sizeof(uint32_t));
+    std::memcpy(m_buffer.data() + m_record_start + sizeof(uint16_t), &size, sizeof(size));
+  }
+
+  template<class T>
+  void Write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void WriteBlob(const void* data, size_t size)
+  {
+    Write(data ? uint64_t(size) : kNullBlob);
+    if (data) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+  }
+
+  std::vector<uint8_t>& Buffer() { return m_buffer; }
+
+private:
+  std::vector<uint8_t> m_buffer;
+  size_t m_record_start = 0;
+};
+
+Recorder g_recorder;
+bool g_capturing = false;
+
+// Live mappings by buffer, the written bytes are read back from them
+struct Mapping
+{
+  const uint8_t* data = nullptr;
+  GLsizeiptr length = 0;
+  GLbitfield access = 0;
+};
+
+std::unordered_map<GLuint, Mapping> g_mappings;
+
+class Reader
+{
+public:
+  Reader(const uint8_t* data, size_t size, size_t position)
+   : m_data(data), m_size(size), m_position(position)
+  {}
+
+  template<class T>
+  T Read()
+  {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  // Returns nullptr for a blob recorded from a null pointer
+  const uint8_t* ReadBlob(size_t& size)
+  {
+    uint64_t recorded = Read<uint64_t>();
+    if (recorded == kNullBlob) {
+      size = 0;
+      return nullptr;
+    }
+    size = static_cast<size_t>(recorded);
+    return Take(size);
+  }
+
+  template<class T>
+  std::vector<T> ReadArray()
+  {
+    size_t size = 0;
+    const uint8_t* bytes = ReadBlob(size);
+    std::vector<T> values(size / sizeof(T));
+    if (bytes && size > 0)
+      std::memcpy(values.data(), bytes, values.size() * sizeof(T));
+    return values;
+  }
+
+  size_t Position() const { return m_position; }
+  void Seek(size_t position) { m_position = position; }
+
+private:
+  const uint8_t* Take(size_t size)
+  {
+    if (m_position + size > m_size)
+      throw CaptureFail("Truncated GL capture");
+    const uint8_t* data = m_data + m_position;
+    m_position += size;
+    return data;
+  }
+
+  const uint8_t* m_data;
+  size_t m_size;
+  size_t m_position;
+};
+
+struct ReplayState
+{
+  GLuint Map(ObjectType type, GLuint name) const
+  {
+    if (name == 0)
+      return 0;
+    const auto& map = names[static_cast<size_t>(type)];
+    auto it = map.find(name);
+    return it == map.end() ? name : it->second;
+  }
+
+  static uint64_t LocationKey(GLuint program, GLint location)
+  {
+    return (uint64_t(program) << 32) | uint32_t(location);
+  }
+
+  // Non-DSA uniform calls target the program in use
+  GLint MapLocation(GLint location) const
+  {
+    if (location < 0)
+      return location;
+    auto it = locations.find(LocationKey(program, location));
+    return it == locations.end() ? location : it->second;
+  }
+
+  template<class Function>
+  void Invoke(uint16_t call, Function&& function)
+  {
+    if (!measure) {
+      function();
+      return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+
+    CommandReplayer::CallStats& call_stats = (*stats)[call];
+    ++call_stats.count;
+    call_stats.total_ns += std::chrono::duration<double, std::nano>(end - start).count();
+  }
+
+  GLsync MapSync(uint64_t sync) const
+  {
+    auto it = syncs.find(sync);
+    return it == syncs.end() ? nullptr : it->second;
+  }
+
+  // Bindless handles are driver values stored in buffer data: every 64-bit word
+  // aligned in the buffer that equals a recorded handle is taken for one
+  const uint8_t* RemapHandles(const uint8_t* data, size_t size, GLintptr offset)
+  {
+    if (handles.empty() || data == nullptr)
+      return data;
+
+    remapped.assign(data, data + size);
+    for (size_t i = (sizeof(GLuint64) - offset % sizeof(GLuint64)) % sizeof(GLuint64); i + sizeof(GLuint64) <= size;
+         i += sizeof(GLuint64)) {
+      GLuint64 value;
+      std::memcpy(&value, remapped.data() + i, sizeof(value));
+      auto it = handles.find(value);
+      if (it != handles.end())
+        std::memcpy(remapped.data() + i, &it->second, sizeof(it->second));
+    }
+    return remapped.data();
+  }
+
+  struct Mapping
+  {
+    uint8_t* data = nullptr;
+    GLintptr offset = 0;
+  };
+
+  std::array<std::unordered_map<GLuint, GLuint>, static_cast<size_t>(ObjectType::Count)> names;
+  std::unordered_map<uint64_t, GLint> locations;
+  GLuint program = 0;
+
+  // Keyed by replayed buffer name
+  std::unordered_map<GLuint, Mapping> mappings;
+  std::unordered_map<uint64_t, GLsync> syncs;
+  std::unordered_map<GLuint64, GLuint64> handles;
+  std::vector<uint8_t> remapped;
+
+  std::vector<CommandReplayer::CallStats>* stats = nullptr;
+  bool measure = true;
+};
+
+// Argument kinds of generically recorded calls
+struct Value {};
+struct Offset {};
+struct Location {};
+template<ObjectType kType> struct Name {};
+
+template<class T>
+void EncodeArg(Value, const T& value) { g_recorder.Write(value); }
+inline void EncodeArg(Offset, const void* offset) { g_recorder.Write(uint64_t(reinterpret_cast<uintptr_t>(offset))); }
+inline void EncodeArg(Location, GLint location) { g_recorder.Write(location); }
+template<ObjectType kType>
+void EncodeArg(Name<kType>, GLuint name) { g_recorder.Write(name); }
+
+template<class T>
+T DecodeArg(Value, Reader& reader, ReplayState&) { return reader.Read<T>(); }
+template<class T>
+T DecodeArg(Offset, Reader& reader, ReplayState&) { return reinterpret_cast<T>(static_cast<uintptr_t>(reader.Read<uint64_t>())); }
+template<class T>
+T DecodeArg(Location, Reader& reader, ReplayState& state) { return state.MapLocation(reader.Read<GLint>()); }
+template<class T, ObjectType kType>
+T DecodeArg(Name<kType>, Reader& reader, ReplayState& state) { return state.Map(kType, reader.Read<GLuint>()); }
+
+// Every call type provides: original, Hook (same signature as the glad pointer) and Replay
+
+template<uint16_t kId, auto* kPointer, class Pfn, class... Kinds>
+struct GenericCall;
+
+template<uint16_t kId, auto* kPointer, class R, class... A, class... Kinds>
+struct GenericCall<kId, kPointer, R (APIENTRYP)(A...), Kinds...>
+{
+  static_assert(sizeof...(A) == sizeof...(Kinds), "Every argument needs a kind");
+
+  static inline R (APIENTRYP original)(A...) = nullptr;
+
+  static R APIENTRY Hook(A... args)
+  {
+    g_recorder.Begin(kId);
+    (EncodeArg(Kinds{}, args), ...);
+    g_recorder.End();
+    return original(args...);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    // Braced initialization keeps the left-to-right decode order
+    std::tuple<A...> args{DecodeArg<A>(Kinds{}, reader, state)...};
+    state.Invoke(kId, [&args] { std::apply(*kPointer, args); });
+  }
+};
+
+template<class... Kinds>
+struct Generic
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = GenericCall<kId, kPointer, std::remove_pointer_t<decltype(kPointer)>, Kinds...>;
+};
+
+template<uint16_t kId, auto* kPointer, ObjectType kType>
+struct GenCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLsizei n, GLuint* names)
+  {
+    original(n, names);
+    g_recorder.Begin(kId);
+    g_recorder.WriteBlob(names, n * sizeof(GLuint));
+    g_recorder.End();
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    std::vector<GLuint> captured = reader.ReadArray<GLuint>();
+    std::vector<GLuint> replayed(captured.size());
+    state.Invoke(kId, [&replayed] { (*kPointer)(static_cast<GLsizei>(replayed.size()), replayed.data()); });
+
+    for (size_t i = 0; i < captured.size(); ++i)
+      state.names[static_cast<size_t>(kType)][captured[i]] = replayed[i];
+  }
+};
+
+// glCreateTextures and glCreateQueries take a target ahead of the names
+template<uint16_t kId, auto* kPointer, ObjectType kType>
+struct CreateTargetedCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLenum target, GLsizei n, GLuint* names)
+  {
+    original(target, n, names);
+    g_recorder.Begin(kId);
+    g_recorder.Write(target);
+    g_recorder.WriteBlob(names, n * sizeof(GLuint));
+    g_recorder.End();
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum target = reader.Read<GLenum>();
+    std::vector<GLuint> captured = reader.ReadArray<GLuint>();
+    std::vector<GLuint> replayed(captured.size());
+    state.Invoke(kId, [target, &replayed] { (*kPointer)(target, static_cast<GLsizei>(replayed.size()), replayed.data()); });
+
+    for (size_t i = 0; i < captured.size(); ++i)
+      state.names[static_cast<size_t>(kType)][captured[i]] = replayed[i];
+  }
+};
+
+template<uint16_t kId, auto* kPointer, ObjectType kType>
+struct DeleteCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLsizei n, const GLuint* names)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.WriteBlob(names, n * sizeof(GLuint));
+    g_recorder.End();
+    original(n, names);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    std::vector<GLuint> names = reader.ReadArray<GLuint>();
+    auto& map = state.names[static_cast<size_t>(kType)];
+    for (GLuint& name : names) {
+      GLuint captured = name;
+      name = state.Map(kType, captured);
+      map.erase(captured);
+    }
+    state.Invoke(kId, [&names] { (*kPointer)(static_cast<GLsizei>(names.size()), names.data()); });
+  }
+};
+
+template<ObjectType kType>
+struct Gen
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = GenCall<kId, kPointer, kType>;
+};
+
+template<ObjectType kType>
+struct CreateTargeted
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = CreateTargetedCall<kId, kPointer, kType>;
+};
+
+template<ObjectType kType>
+struct Delete
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = DeleteCall<kId, kPointer, kType>;
+};
+
+template<uint16_t kId, auto* kPointer>
+struct CreateShaderCall
+{
+  static inline PFNGLCREATESHADERPROC original = nullptr;
+
+  static GLuint APIENTRY Hook(GLenum type)
+  {
+    GLuint shader = original(type);
+    g_recorder.Begin(kId);
+    g_recorder.Write(type);
+    g_recorder.Write(shader);
+    g_recorder.End();
+    return shader;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum type = reader.Read<GLenum>();
+    GLuint captured = reader.Read<GLuint>();
+    GLuint replayed = 0;
+    state.Invoke(kId, [&replayed, type] { replayed = (*kPointer)(type); });
+    state.names[static_cast<size_t>(ObjectType::Shader)][captured] = replayed;
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct CreateProgramCall
+{
+  static inline PFNGLCREATEPROGRAMPROC original = nullptr;
+
+  static GLuint APIENTRY Hook()
+  {
+    GLuint program = original();
+    g_recorder.Begin(kId);
+    g_recorder.Write(program);
+    g_recorder.End();
+    return program;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint captured = reader.Read<GLuint>();
+    GLuint replayed = 0;
+    state.Invoke(kId, [&replayed] { replayed = (*kPointer)(); });
+    state.names[static_cast<size_t>(ObjectType::Program)][captured] = replayed;
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct UseProgramCall
+{
+  static inline PFNGLUSEPROGRAMPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint program)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(program);
+    g_recorder.End();
+    original(program);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    state.program = reader.Read<GLuint>();
+    GLuint program = state.Map(ObjectType::Program, state.program);
+    state.Invoke(kId, [program] { (*kPointer)(program); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct ShaderSourceCall
+{
+  static inline PFNGLSHADERSOURCEPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+  {
+    // Stored as a single string, which is what the compiler sees anyway
+    std::string source;
+    for (GLsizei i = 0; i < count; ++i) {
+      if (lengths && lengths[i] >= 0)
+        source.append(strings[i], lengths[i]);
+      else
+        source.append(strings[i]);
+    }
+
+    g_recorder.Begin(kId);
+    g_recorder.Write(shader);
+    g_recorder.WriteBlob(source.data(), source.size());
+    g_recorder.End();
+    original(shader, count, strings, lengths);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint shader = state.Map(ObjectType::Shader, reader.Read<GLuint>());
+    size_t size = 0;
+    const GLchar* source = reinterpret_cast<const GLchar*>(reader.ReadBlob(size));
+    GLint length = static_cast<GLint>(size);
+    state.Invoke(kId, [shader, source, length] { (*kPointer)(shader, 1, &source, &length); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct GetUniformLocationCall
+{
+  static inline PFNGLGETUNIFORMLOCATIONPROC original = nullptr;
+
+  static GLint APIENTRY Hook(GLuint program, const GLchar* name)
+  {
+    GLint location = original(program, name);
+    g_recorder.Begin(kId);
+    g_recorder.Write(program);
+    g_recorder.WriteBlob(name, std::strlen(name));
+    g_recorder.Write(location);
+    g_recorder.End();
+    return location;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint program = reader.Read<GLuint>();
+    size_t size = 0;
+    const uint8_t* bytes = reader.ReadBlob(size);
+    std::string name(reinterpret_cast<const char*>(bytes), size);
+    GLint captured = reader.Read<GLint>();
+
+    GLint replayed = -1;
+    GLuint mapped = state.Map(ObjectType::Program, program);
+    state.Invoke(kId, [&replayed, mapped, &name] { replayed = (*kPointer)(mapped, name.c_str()); });
+    if (captured >= 0)
+      state.locations[ReplayState::LocationKey(program, captured)] = replayed;
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct BufferDataCall
+{
+  static inline PFNGLBUFFERDATAPROC original = nullptr;
+
+  static void APIENTRY Hook(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(target);
+    g_recorder.Write(size);
+    g_recorder.WriteBlob(data, size);
+    g_recorder.Write(usage);
+    g_recorder.End();
+    original(target, size, data, usage);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum target = reader.Read<GLenum>();
+    GLsizeiptr size = reader.Read<GLsizeiptr>();
+    size_t blob_size = 0;
+    const uint8_t* data = state.RemapHandles(reader.ReadBlob(blob_size), blob_size, 0);
+    GLenum usage = reader.Read<GLenum>();
+    state.Invoke(kId, [=] { (*kPointer)(target, size, data, usage); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct BufferSubDataCall
+{
+  static inline PFNGLBUFFERSUBDATAPROC original = nullptr;
+
+  static void APIENTRY Hook(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(target);
+    g_recorder.Write(offset);
+    g_recorder.WriteBlob(data, size);
+    g_recorder.End();
+    original(target, offset, size, data);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum target = reader.Read<GLenum>();
+    GLintptr offset = reader.Read<GLintptr>();
+    size_t size = 0;
+    const uint8_t* data = reader.ReadBlob(size);
+    data = state.RemapHandles(data, size, offset);
+    state.Invoke(kId, [=] { (*kPointer)(target, offset, static_cast<GLsizeiptr>(size), data); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct NamedBufferStorageCall
+{
+  static inline PFNGLNAMEDBUFFERSTORAGEPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(buffer);
+    g_recorder.Write(size);
+    g_recorder.WriteBlob(data, size);
+    g_recorder.Write(flags);
+    g_recorder.End();
+    // Written mappings are read back when flushed, the replay gets the recorded flags
+    original(buffer, size, data, (flags & GL_MAP_WRITE_BIT) ? flags | GL_MAP_READ_BIT : flags);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint buffer = state.Map(ObjectType::Buffer, reader.Read<GLuint>());
+    GLsizeiptr size = reader.Read<GLsizeiptr>();
+    size_t blob_size = 0;
+    const uint8_t* data = state.RemapHandles(reader.ReadBlob(blob_size), blob_size, 0);
+    GLbitfield flags = reader.Read<GLbitfield>();
+    state.Invoke(kId, [=] { (*kPointer)(buffer, size, data, flags); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct NamedBufferSubDataCall
+{
+  static inline PFNGLNAMEDBUFFERSUBDATAPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(buffer);
+    g_recorder.Write(offset);
+    g_recorder.WriteBlob(data, size);
+    g_recorder.End();
+    original(buffer, offset, size, data);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint buffer = state.Map(ObjectType::Buffer, reader.Read<GLuint>());
+    GLintptr offset = reader.Read<GLintptr>();
+    size_t size = 0;
+    const uint8_t* data = reader.ReadBlob(size);
+    data = state.RemapHandles(data, size, offset);
+    state.Invoke(kId, [=] { (*kPointer)(buffer, offset, static_cast<GLsizeiptr>(size), data); });
+  }
+};
+
+// Mapped memory is written by the client without a call to record. The bytes are
+// recorded where the GL is told about them: glFlushMappedNamedBufferRange for
+// explicitly flushed mappings, glUnmapNamedBuffer for the others. A persistent
+// mapping without GL_MAP_FLUSH_EXPLICIT_BIT has no such point and is refused.
+template<uint16_t kId, auto* kPointer>
+struct MapNamedBufferRangeCall
+{
+  static inline PFNGLMAPNAMEDBUFFERRANGEPROC original = nullptr;
+
+  static void* APIENTRY Hook(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access)
+  {
+    const bool written = (access & GL_MAP_WRITE_BIT) != 0;
+    if (written && (access & GL_MAP_PERSISTENT_BIT) && !(access & GL_MAP_FLUSH_EXPLICIT_BIT))
+      throw CaptureFail("Writes to a persistent mapping are recorded when flushed, map it with "
+        "GL_MAP_FLUSH_EXPLICIT_BIT");
+
+    // Reading the bytes back needs GL_MAP_READ_BIT, which the invalidate and
+    // unsynchronized bits exclude: the capture keeps the contents and synchronizes
+    GLbitfield readable = access;
+    if (written) {
+      readable |= GL_MAP_READ_BIT;
+      readable &= ~(GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+
+    void* data = original(buffer, offset, length, readable);
+    if (data == nullptr)
+      return nullptr;
+
+    g_mappings[buffer] = {static_cast<const uint8_t*>(data), length, access};
+    g_recorder.Begin(kId);
+    g_recorder.Write(buffer);
+    g_recorder.Write(offset);
+    g_recorder.Write(length);
+    g_recorder.Write(access);
+    g_recorder.End();
+    return data;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint buffer = state.Map(ObjectType::Buffer, reader.Read<GLuint>());
+    GLintptr offset = reader.Read<GLintptr>();
+    GLsizeiptr length = reader.Read<GLsizeiptr>();
+    GLbitfield access = reader.Read<GLbitfield>();
+
+    void* data = nullptr;
+    state.Invoke(kId, [&data, buffer, offset, length, access] { data = (*kPointer)(buffer, offset, length, access); });
+    if (data == nullptr)
+      throw CaptureFail("Failed to map a buffer the capture mapped");
+    state.mappings[buffer] = {static_cast<uint8_t*>(data), offset};
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct FlushMappedNamedBufferRangeCall
+{
+  static inline PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint buffer, GLintptr offset, GLsizeiptr length)
+  {
+    auto it = g_mappings.find(buffer);
+    if (it == g_mappings.end())
+      throw CaptureFail("Buffer " + std::to_string(buffer) + " was mapped before the capture started");
+
+    g_recorder.Begin(kId);
+    g_recorder.Write(buffer);
+    g_recorder.Write(offset);
+    g_recorder.WriteBlob(it->second.data + offset, length);
+    g_recorder.End();
+    original(buffer, offset, length);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint buffer = state.Map(ObjectType::Buffer, reader.Read<GLuint>());
+    GLintptr offset = reader.Read<GLintptr>();
+    size_t size = 0;
+    const uint8_t* data = reader.ReadBlob(size);
+
+    auto it = state.mappings.find(buffer);
+    if (it == state.mappings.end())
+      throw CaptureFail("Flushed a buffer that is not mapped");
+    uint8_t* mapped = it->second.data + offset;
+    data = state.RemapHandles(data, size, it->second.offset + offset);
+    state.Invoke(kId, [=]
+    {
+      std::memcpy(mapped, data, size);
+      (*kPointer)(buffer, offset, static_cast<GLsizeiptr>(size));
+    });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct UnmapNamedBufferCall
+{
+  static inline PFNGLUNMAPNAMEDBUFFERPROC original = nullptr;
+
+  static GLboolean APIENTRY Hook(GLuint buffer)
+  {
+    // Written mappings that were not flushed explicitly are complete now
+    const uint8_t* written = nullptr;
+    GLsizeiptr size = 0;
+    auto it = g_mappings.find(buffer);
+    if (it != g_mappings.end()) {
+      const Mapping& mapping = it->second;
+      if ((mapping.access & GL_MAP_WRITE_BIT) && !(mapping.access & GL_MAP_FLUSH_EXPLICIT_BIT)) {
+        written = mapping.data;
+        size = mapping.length;
+      }
+    }
+
+    g_recorder.Begin(kId);
+    g_recorder.Write(buffer);
+    g_recorder.WriteBlob(written, size);
+    g_recorder.End();
+
+    if (it != g_mappings.end())
+      g_mappings.erase(it);
+    return original(buffer);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint buffer = state.Map(ObjectType::Buffer, reader.Read<GLuint>());
+    size_t size = 0;
+    const uint8_t* data = reader.ReadBlob(size);
+
+    auto it = state.mappings.find(buffer);
+    if (it == state.mappings.end())
+      return;
+    uint8_t* mapped = it->second.data;
+    data = state.RemapHandles(data, size, it->second.offset);
+    state.mappings.erase(it);
+    state.Invoke(kId, [=]
+    {
+      if (data != nullptr)
+        std::memcpy(mapped, data, size);
+      (*kPointer)(buffer);
+    });
+  }
+};
+
+inline void EncodeSync(GLsync sync) { g_recorder.Write(uint64_t(reinterpret_cast<uintptr_t>(sync))); }
+
+template<uint16_t kId, auto* kPointer>
+struct FenceSyncCall
+{
+  static inline PFNGLFENCESYNCPROC original = nullptr;
+
+  static GLsync APIENTRY Hook(GLenum condition, GLbitfield flags)
+  {
+    GLsync sync = original(condition, flags);
+    g_recorder.Begin(kId);
+    g_recorder.Write(condition);
+    g_recorder.Write(flags);
+    EncodeSync(sync);
+    g_recorder.End();
+    return sync;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum condition = reader.Read<GLenum>();
+    GLbitfield flags = reader.Read<GLbitfield>();
+    uint64_t captured = reader.Read<uint64_t>();
+    GLsync replayed = nullptr;
+    state.Invoke(kId, [&replayed, condition, flags] { replayed = (*kPointer)(condition, flags); });
+    state.syncs[captured] = replayed;
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct ClientWaitSyncCall
+{
+  static inline PFNGLCLIENTWAITSYNCPROC original = nullptr;
+
+  static GLenum APIENTRY Hook(GLsync sync, GLbitfield flags, GLuint64 timeout)
+  {
+    GLenum result = original(sync, flags, timeout);
+    g_recorder.Begin(kId);
+    EncodeSync(sync);
+    g_recorder.Write(flags);
+    g_recorder.Write(timeout);
+    g_recorder.Write(result);
+    g_recorder.End();
+    return result;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLsync sync = state.MapSync(reader.Read<uint64_t>());
+    GLbitfield flags = reader.Read<GLbitfield>();
+    GLuint64 timeout = reader.Read<GLuint64>();
+    GLenum result = reader.Read<GLenum>();
+    if (sync == nullptr)
+      return;
+
+    // The captured frame only went on once the fence had signaled, whatever the
+    // timeout was: the replay waits as long, mapped writes depend on it
+    if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+      state.Invoke(kId, [sync]
+      {
+        while ((*kPointer)(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED) {}
+      });
+    }
+    else {
+      state.Invoke(kId, [sync, flags, timeout] { (*kPointer)(sync, flags, timeout); });
+    }
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct DeleteSyncCall
+{
+  static inline PFNGLDELETESYNCPROC original = nullptr;
+
+  static void APIENTRY Hook(GLsync sync)
+  {
+    g_recorder.Begin(kId);
+    EncodeSync(sync);
+    g_recorder.End();
+    original(sync);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    uint64_t captured = reader.Read<uint64_t>();
+    GLsync sync = state.MapSync(captured);
+    state.syncs.erase(captured);
+    if (sync != nullptr)
+      state.Invoke(kId, [sync] { (*kPointer)(sync); });
+  }
+};
+
+// Binaries are driver specific, a capture using them replays on the driver that recorded it
+template<uint16_t kId, auto* kPointer>
+struct ProgramBinaryCall
+{
+  static inline PFNGLPROGRAMBINARYPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint program, GLenum format, const void* binary, GLsizei length)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(program);
+    g_recorder.Write(format);
+    g_recorder.WriteBlob(binary, length);
+    g_recorder.End();
+    original(program, format, binary, length);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint program = state.Map(ObjectType::Program, reader.Read<GLuint>());
+    GLenum format = reader.Read<GLenum>();
+    size_t size = 0;
+    const uint8_t* binary = reader.ReadBlob(size);
+    state.Invoke(kId, [=] { (*kPointer)(program, format, binary, static_cast<GLsizei>(size)); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct ShaderBinaryCall
+{
+  static inline PFNGLSHADERBINARYPROC original = nullptr;
+
+  static void APIENTRY Hook(GLsizei count, const GLuint* shaders, GLenum format, const void* binary, GLsizei length)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.WriteBlob(shaders, count * sizeof(GLuint));
+    g_recorder.Write(format);
+    g_recorder.WriteBlob(binary, length);
+    g_recorder.End();
+    original(count, shaders, format, binary, length);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    std::vector<GLuint> shaders = reader.ReadArray<GLuint>();
+    for (GLuint& shader : shaders)
+      shader = state.Map(ObjectType::Shader, shader);
+    GLenum format = reader.Read<GLenum>();
+    size_t size = 0;
+    const uint8_t* binary = reader.ReadBlob(size);
+    state.Invoke(kId, [&shaders, format, binary, size]
+      { (*kPointer)(static_cast<GLsizei>(shaders.size()), shaders.data(), format, binary, static_cast<GLsizei>(size)); });
+  }
+};
+
+size_t PixelSize(GLenum format, GLenum type)
+{
+  switch (type) {
+    case GL_UNSIGNED_BYTE_3_3_2:
+    case GL_UNSIGNED_BYTE_2_3_3_REV:
+      return 1;
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_5_6_5_REV:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+    case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+      return 2;
+    case GL_UNSIGNED_INT_8_8_8_8:
+    case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_10_10_10_2:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_24_8:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_5_9_9_9_REV:
+      return 4;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+      return 8;
+  }
+
+  size_t component_size = 1;
+  switch (type) {
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:
+      component_size = 2;
+      break;
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:
+      component_size = 4;
+      break;
+  }
+
+  size_t components = 4;
+  switch (format) {
+    case GL_RED:
+    case GL_GREEN:
+    case GL_BLUE:
+    case GL_RED_INTEGER:
+    case GL_DEPTH_COMPONENT:
+    case GL_STENCIL_INDEX:
+      components = 1;
+      break;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_DEPTH_STENCIL:
+      components = 2;
+      break;
+    case GL_RGB:
+    case GL_BGR:
+    case GL_RGB_INTEGER:
+    case GL_BGR_INTEGER:
+      components = 3;
+      break;
+  }
+
+  return components * component_size;
+}
+
+// Client memory read by a texture upload, honoring the unpack alignment, row length and image height
+void EncodePixels(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels, GLsizei depth = 1)
+{
+  GLint unpack_buffer = 0;
+  glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpack_buffer);
+  g_recorder.Write(uint8_t(unpack_buffer != 0));
+  if (unpack_buffer != 0) {
+    EncodeArg(Offset{}, pixels);
+    return;
+  }
+
+  GLint alignment = 4;
+  GLint row_length = 0;
+  GLint image_height = 0;
+  glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+  glGetIntegerv(GL_UNPACK_ROW_LENGTH, &row_length);
+  glGetIntegerv(GL_UNPACK_IMAGE_HEIGHT, &image_height);
+
+  size_t pixel_size = PixelSize(format, type);
+  size_t row_pixels = row_length > 0 ? row_length : width;
+  size_t stride = (row_pixels * pixel_size + alignment - 1) / alignment * alignment;
+  size_t image_stride = stride * (image_height > 0 ? image_height : height);
+  size_t image_size = height > 0 ? stride * (height - 1) + width * pixel_size : 0;
+  size_t size = depth > 0 && image_size > 0 ? image_stride * (depth - 1) + image_size : 0;
+  g_recorder.WriteBlob(pixels, size);
+}
+
+const void* DecodePixels(Reader& reader)
+{
+  // Offset into the bound pixel unpack buffer
+  if (reader.Read<uint8_t>() != 0)
+    return reinterpret_cast<const void*>(static_cast<uintptr_t>(reader.Read<uint64_t>()));
+
+  size_t size = 0;
+  return reader.ReadBlob(size);
+}
+
+template<uint16_t kId, auto* kPointer>
+struct TexImage2DCall
+{
+  static inline PFNGLTEXIMAGE2DPROC original = nullptr;
+
+  static void APIENTRY Hook(GLenum target, GLint level, GLint internal_format, GLsizei width, GLsizei height,
+    GLint border, GLenum format, GLenum type, const void* pixels)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(target);
+    g_recorder.Write(level);
+    g_recorder.Write(internal_format);
+    g_recorder.Write(width);
+    g_recorder.Write(height);
+    g_recorder.Write(border);
+    g_recorder.Write(format);
+    g_recorder.Write(type);
+    EncodePixels(width, height, format, type, pixels);
+    g_recorder.End();
+    original(target, level, internal_format, width, height, border, format, type, pixels);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum target = reader.Read<GLenum>();
+    GLint level = reader.Read<GLint>();
+    GLint internal_format = reader.Read<GLint>();
+    GLsizei width = reader.Read<GLsizei>();
+    GLsizei height = reader.Read<GLsizei>();
+    GLint border = reader.Read<GLint>();
+    GLenum format = reader.Read<GLenum>();
+    GLenum type = reader.Read<GLenum>();
+    const void* pixels = DecodePixels(reader);
+    state.Invoke(kId, [=] { (*kPointer)(target, level, internal_format, width, height, border, format, type, pixels); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct TexSubImage2DCall
+{
+  static inline PFNGLTEXSUBIMAGE2DPROC original = nullptr;
+
+  static void APIENTRY Hook(GLenum target, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+    GLenum format, GLenum type, const void* pixels)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(target);
+    g_recorder.Write(level);
+    g_recorder.Write(x);
+    g_recorder.Write(y);
+    g_recorder.Write(width);
+    g_recorder.Write(height);
+    g_recorder.Write(format);
+    g_recorder.Write(type);
+    EncodePixels(width, height, format, type, pixels);
+    g_recorder.End();
+    original(target, level, x, y, width, height, format, type, pixels);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLenum target = reader.Read<GLenum>();
+    GLint level = reader.Read<GLint>();
+    GLint x = reader.Read<GLint>();
+    GLint y = reader.Read<GLint>();
+    GLsizei width = reader.Read<GLsizei>();
+    GLsizei height = reader.Read<GLsizei>();
+    GLenum format = reader.Read<GLenum>();
+    GLenum type = reader.Read<GLenum>();
+    const void* pixels = DecodePixels(reader);
+    state.Invoke(kId, [=] { (*kPointer)(target, level, x, y, width, height, format, type, pixels); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct TextureSubImage2DCall
+{
+  static inline PFNGLTEXTURESUBIMAGE2DPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint texture, GLint level, GLint x, GLint y, GLsizei width, GLsizei height,
+    GLenum format, GLenum type, const void* pixels)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(texture);
+    g_recorder.Write(level);
+    g_recorder.Write(x);
+    g_recorder.Write(y);
+    g_recorder.Write(width);
+    g_recorder.Write(height);
+    g_recorder.Write(format);
+    g_recorder.Write(type);
+    EncodePixels(width, height, format, type, pixels);
+    g_recorder.End();
+    original(texture, level, x, y, width, height, format, type, pixels);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint texture = state.Map(ObjectType::Texture, reader.Read<GLuint>());
+    GLint level = reader.Read<GLint>();
+    GLint x = reader.Read<GLint>();
+    GLint y = reader.Read<GLint>();
+    GLsizei width = reader.Read<GLsizei>();
+    GLsizei height = reader.Read<GLsizei>();
+    GLenum format = reader.Read<GLenum>();
+    GLenum type = reader.Read<GLenum>();
+    const void* pixels = DecodePixels(reader);
+    state.Invoke(kId, [=] { (*kPointer)(texture, level, x, y, width, height, format, type, pixels); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct TextureSubImage3DCall
+{
+  static inline PFNGLTEXTURESUBIMAGE3DPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint texture, GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height,
+    GLsizei depth, GLenum format, GLenum type, const void* pixels)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(texture);
+    g_recorder.Write(level);
+    g_recorder.Write(x);
+    g_recorder.Write(y);
+    g_recorder.Write(z);
+    g_recorder.Write(width);
+    g_recorder.Write(height);
+    g_recorder.Write(depth);
+    g_recorder.Write(format);
+    g_recorder.Write(type);
+    EncodePixels(width, height, format, type, pixels, depth);
+    g_recorder.End();
+    original(texture, level, x, y, z, width, height, depth, format, type, pixels);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint texture = state.Map(ObjectType::Texture, reader.Read<GLuint>());
+    GLint level = reader.Read<GLint>();
+    GLint x = reader.Read<GLint>();
+    GLint y = reader.Read<GLint>();
+    GLint z = reader.Read<GLint>();
+    GLsizei width = reader.Read<GLsizei>();
+    GLsizei height = reader.Read<GLsizei>();
+    GLsizei depth = reader.Read<GLsizei>();
+    GLenum format = reader.Read<GLenum>();
+    GLenum type = reader.Read<GLenum>();
+    const void* pixels = DecodePixels(reader);
+    state.Invoke(kId, [=] { (*kPointer)(texture, level, x, y, z, width, height, depth, format, type, pixels); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer>
+struct NamedFramebufferDrawBuffersCall
+{
+  static inline PFNGLNAMEDFRAMEBUFFERDRAWBUFFERSPROC original = nullptr;
+
+  static void APIENTRY Hook(GLuint framebuffer, GLsizei n, const GLenum* buffers)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(framebuffer);
+    g_recorder.WriteBlob(buffers, n * sizeof(GLenum));
+    g_recorder.End();
+    original(framebuffer, n, buffers);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint framebuffer = state.Map(ObjectType::Framebuffer, reader.Read<GLuint>());
+    std::vector<GLenum> buffers = reader.ReadArray<GLenum>();
+    state.Invoke(kId, [framebuffer, &buffers] { (*kPointer)(framebuffer, static_cast<GLsizei>(buffers.size()), buffers.data()); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer, class T, size_t kComponents>
+struct UniformArrayCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLint location, GLsizei count, const T* values)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(location);
+    g_recorder.WriteBlob(values, count * kComponents * sizeof(T));
+    g_recorder.End();
+    original(location, count, values);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLint location = state.MapLocation(reader.Read<GLint>());
+    std::vector<T> values = reader.ReadArray<T>();
+    GLsizei count = static_cast<GLsizei>(values.size() / kComponents);
+    state.Invoke(kId, [location, count, &values] { (*kPointer)(location, count, values.data()); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer, size_t kComponents>
+struct UniformMatrixCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLint location, GLsizei count, GLboolean transpose, const GLfloat* values)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(location);
+    g_recorder.Write(transpose);
+    g_recorder.WriteBlob(values, count * kComponents * sizeof(GLfloat));
+    g_recorder.End();
+    original(location, count, transpose, values);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLint location = state.MapLocation(reader.Read<GLint>());
+    GLboolean transpose = reader.Read<GLboolean>();
+    std::vector<GLfloat> values = reader.ReadArray<GLfloat>();
+    GLsizei count = static_cast<GLsizei>(values.size() / kComponents);
+    state.Invoke(kId, [location, count, transpose, &values] { (*kPointer)(location, count, transpose, values.data()); });
+  }
+};
+
+// DSA uniform calls name their program, locations come from reflection and are
+// replayed as recorded: the same sources link to the same locations on one driver
+template<uint16_t kId, auto* kPointer, class T, size_t kComponents>
+struct ProgramUniformArrayCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLuint program, GLint location, GLsizei count, const T* values)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(program);
+    g_recorder.Write(location);
+    g_recorder.WriteBlob(values, count * kComponents * sizeof(T));
+    g_recorder.End();
+    original(program, location, count, values);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint program = state.Map(ObjectType::Program, reader.Read<GLuint>());
+    GLint location = reader.Read<GLint>();
+    std::vector<T> values = reader.ReadArray<T>();
+    GLsizei count = static_cast<GLsizei>(values.size() / kComponents);
+    state.Invoke(kId, [program, location, count, &values] { (*kPointer)(program, location, count, values.data()); });
+  }
+};
+
+template<uint16_t kId, auto* kPointer, size_t kComponents>
+struct ProgramUniformMatrixCall
+{
+  static inline std::remove_pointer_t<decltype(kPointer)> original = nullptr;
+
+  static void APIENTRY Hook(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* values)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(program);
+    g_recorder.Write(location);
+    g_recorder.Write(transpose);
+    g_recorder.WriteBlob(values, count * kComponents * sizeof(GLfloat));
+    g_recorder.End();
+    original(program, location, count, transpose, values);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    GLuint program = state.Map(ObjectType::Program, reader.Read<GLuint>());
+    GLint location = reader.Read<GLint>();
+    GLboolean transpose = reader.Read<GLboolean>();
+    std::vector<GLfloat> values = reader.ReadArray<GLfloat>();
+    GLsizei count = static_cast<GLsizei>(values.size() / kComponents);
+    state.Invoke(kId, [program, location, count, transpose, &values]
+      { (*kPointer)(program, location, count, transpose, values.data()); });
+  }
+};
+
+// Extension calls are hooked in the tables of extensions.hxx and replayed
+// through them, a driver without the extension cannot replay the capture
+
+template<class Table>
+const Table& RequireTable(const Table* table, const char* extension)
+{
+  if (table == nullptr)
+    throw CaptureFail(std::string("The capture needs ") + extension + ", which the driver does not expose");
+  return *table;
+}
+
+template<uint16_t kId>
+struct GetTextureHandleCall
+{
+  static inline decltype(BindlessTextureFunctions::GetTextureHandle) original = nullptr;
+
+  static GLuint64 APIENTRY Hook(GLuint texture)
+  {
+    GLuint64 handle = original(texture);
+    g_recorder.Begin(kId);
+    g_recorder.Write(texture);
+    g_recorder.Write(handle);
+    g_recorder.End();
+    return handle;
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    const auto& bindless = RequireTable(GetBindlessTextureFunctions(), "GL_ARB_bindless_texture");
+    GLuint texture = state.Map(ObjectType::Texture, reader.Read<GLuint>());
+    GLuint64 captured = reader.Read<GLuint64>();
+    GLuint64 replayed = 0;
+    state.Invoke(kId, [&replayed, &bindless, texture] { replayed = bindless.GetTextureHandle(texture); });
+    state.handles[captured] = replayed;
+  }
+};
+
+template<uint16_t kId, auto BindlessTextureFunctions::* kMember>
+struct TextureHandleCall
+{
+  static inline std::remove_cvref_t<decltype(std::declval<BindlessTextureFunctions>().*kMember)> original = nullptr;
+
+  static void APIENTRY Hook(GLuint64 handle)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(handle);
+    g_recorder.End();
+    original(handle);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    const auto& bindless = RequireTable(GetBindlessTextureFunctions(), "GL_ARB_bindless_texture");
+    GLuint64 captured = reader.Read<GLuint64>();
+    auto it = state.handles.find(captured);
+    GLuint64 handle = it == state.handles.end() ? captured : it->second;
+    state.Invoke(kId, [&bindless, handle] { (bindless.*kMember)(handle); });
+  }
+};
+
+template<uint16_t kId>
+using MakeTextureHandleResidentCall = TextureHandleCall<kId, &BindlessTextureFunctions::MakeTextureHandleResident>;
+template<uint16_t kId>
+using MakeTextureHandleNonResidentCall = TextureHandleCall<kId, &BindlessTextureFunctions::MakeTextureHandleNonResident>;
+
+template<uint16_t kId>
+struct SpecializeShaderCall
+{
+  static inline decltype(SpirvFunctions::SpecializeShader) original = nullptr;
+
+  static void APIENTRY Hook(GLuint shader, const GLchar* entry_point, GLuint count, const GLuint* constant_ids,
+    const GLuint* constant_values)
+  {
+    g_recorder.Begin(kId);
+    g_recorder.Write(shader);
+    g_recorder.WriteBlob(entry_point, std::strlen(entry_point));
+    g_recorder.WriteBlob(constant_ids, count * sizeof(GLuint));
+    g_recorder.WriteBlob(constant_values, count * sizeof(GLuint));
+    g_recorder.End();
+    original(shader, entry_point, count, constant_ids, constant_values);
+  }
+
+  static void Replay(Reader& reader, ReplayState& state)
+  {
+    const auto& spirv = RequireTable(GetSpirvFunctions(), "SPIR-V shaders");
+    GLuint shader = state.Map(ObjectType::Shader, reader.Read<GLuint>());
+    size_t size = 0;
+    const uint8_t* bytes = reader.ReadBlob(size);
+    std::string entry_point(reinterpret_cast<const char*>(bytes), size);
+    std::vector<GLuint> ids = reader.ReadArray<GLuint>();
+    std::vector<GLuint> values = reader.ReadArray<GLuint>();
+    state.Invoke(kId, [&]
+      { spirv.SpecializeShader(shader, entry_point.c_str(), static_cast<GLuint>(ids.size()), ids.data(), values.data()); });
+  }
+};
+
+#define ENGINE_GL_SPECIAL_CALL(type)                  \
+  struct type                                         \
+  {                                                   \
+    template<uint16_t kId, auto* kPointer>            \
+    using Call = type##Call<kId, kPointer>;           \
+  }
+
+ENGINE_GL_SPECIAL_CALL(CreateShader);
+ENGINE_GL_SPECIAL_CALL(CreateProgram);
+ENGINE_GL_SPECIAL_CALL(UseProgram);
+ENGINE_GL_SPECIAL_CALL(ShaderSource);
+ENGINE_GL_SPECIAL_CALL(GetUniformLocation);
+ENGINE_GL_SPECIAL_CALL(BufferData);
+ENGINE_GL_SPECIAL_CALL(BufferSubData);
+ENGINE_GL_SPECIAL_CALL(NamedBufferStorage);
+ENGINE_GL_SPECIAL_CALL(NamedBufferSubData);
+ENGINE_GL_SPECIAL_CALL(TexImage2D);
+ENGINE_GL_SPECIAL_CALL(TexSubImage2D);
+ENGINE_GL_SPECIAL_CALL(TextureSubImage2D);
+ENGINE_GL_SPECIAL_CALL(TextureSubImage3D);
+ENGINE_GL_SPECIAL_CALL(NamedFramebufferDrawBuffers);
+ENGINE_GL_SPECIAL_CALL(MapNamedBufferRange);
+ENGINE_GL_SPECIAL_CALL(FlushMappedNamedBufferRange);
+ENGINE_GL_SPECIAL_CALL(UnmapNamedBuffer);
+ENGINE_GL_SPECIAL_CALL(FenceSync);
+ENGINE_GL_SPECIAL_CALL(ClientWaitSync);
+ENGINE_GL_SPECIAL_CALL(DeleteSync);
+ENGINE_GL_SPECIAL_CALL(ProgramBinary);
+ENGINE_GL_SPECIAL_CALL(ShaderBinary);
+
+#undef ENGINE_GL_SPECIAL_CALL
+
+template<class T, size_t kComponents>
+struct UniformArray
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = UniformArrayCall<kId, kPointer, T, kComponents>;
+};
+
+template<size_t kComponents>
+struct UniformMatrix
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = UniformMatrixCall<kId, kPointer, kComponents>;
+};
+
+template<class T, size_t kComponents>
+struct ProgramUniformArray
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = ProgramUniformArrayCall<kId, kPointer, T, kComponents>;
+};
+
+template<size_t kComponents>
+struct ProgramUniformMatrix
+{
+  template<uint16_t kId, auto* kPointer>
+  using Call = ProgramUniformMatrixCall<kId, kPointer, kComponents>;
+};
+
+using BufferName = Name<ObjectType::Buffer>;
+using TextureName = Name<ObjectType::Texture>;
+using VertexArrayName = Name<ObjectType::VertexArray>;
+using ShaderName = Name<ObjectType::Shader>;
+using ProgramName = Name<ObjectType::Program>;
+using QueryName = Name<ObjectType::Query>;
+using SamplerName = Name<ObjectType::Sampler>;
+using FramebufferName = Name<ObjectType::Framebuffer>;
+
+// Captured calls: glad function name without the gl prefix, then how it is recorded.
+// Append new entries at the end, the position is the call id stored in capture files.
+#define ENGINE_GL_CAPTURED_CALLS(X) \
+  X(ActiveTexture, Generic<Value>) \
+  X(AttachShader, Generic<ProgramName, ShaderName>) \
+  X(BeginQuery, Generic<Value, QueryName>) \
+  X(BindBuffer, Generic<Value, BufferName>) \
+  X(BindBufferBase, Generic<Value, Value, BufferName>) \
+  X(BindBufferRange, Generic<Value, Value, BufferName, Value, Value>) \
+  X(BindFramebuffer, Generic<Value, FramebufferName>) \
+  X(BindSampler, Generic<Value, SamplerName>) \
+  X(BindTexture, Generic<Value, TextureName>) \
+  X(BindTextureUnit, Generic<Value, TextureName>) \
+  X(BindVertexArray, Generic<VertexArrayName>) \
+  X(BlendFunc, Generic<Value, Value>) \
+  X(BufferData, BufferData) \
+  X(BufferSubData, BufferSubData) \
+  X(Clear, Generic<Value>) \
+  X(ClearColor, Generic<Value, Value, Value, Value>) \
+  X(ColorMask, Generic<Value, Value, Value, Value>) \
+  X(CompileShader, Generic<ShaderName>) \
+  X(CreateBuffers, Gen<ObjectType::Buffer>) \
+  X(CreateFramebuffers, Gen<ObjectType::Framebuffer>) \
+  X(CreateProgram, CreateProgram) \
+  X(CreateQueries, CreateTargeted<ObjectType::Query>) \
+  X(CreateSamplers, Gen<ObjectType::Sampler>) \
+  X(CreateShader, CreateShader) \
+  X(CreateTextures, CreateTargeted<ObjectType::Texture>) \
+  X(CreateVertexArrays, Gen<ObjectType::VertexArray>) \
+  X(CullFace, Generic<Value>) \
+  X(DeleteBuffers, Delete<ObjectType::Buffer>) \
+  X(DeleteFramebuffers, Delete<ObjectType::Framebuffer>) \
+  X(DeleteProgram, Generic<ProgramName>) \
+  X(DeleteQueries, Delete<ObjectType::Query>) \
+  X(DeleteSamplers, Delete<ObjectType::Sampler>) \
+  X(DeleteShader, Generic<ShaderName>) \
+  X(DeleteTextures, Delete<ObjectType::Texture>) \
+  X(DeleteVertexArrays, Delete<ObjectType::VertexArray>) \
+  X(DepthFunc, Generic<Value>) \
+  X(DepthMask, Generic<Value>) \
+  X(DetachShader, Generic<ProgramName, ShaderName>) \
+  X(Disable, Generic<Value>) \
+  X(DisableVertexAttribArray, Generic<Value>) \
+  X(DrawArrays, Generic<Value, Value, Value>) \
+  X(DrawArraysInstanced, Generic<Value, Value, Value, Value>) \
+  X(DrawElements, Generic<Value, Value, Value, Offset>) \
+  X(DrawElementsInstanced, Generic<Value, Value, Value, Offset, Value>) \
+  X(DrawElementsInstancedBaseVertex, Generic<Value, Value, Value, Offset, Value, Value>) \
+  X(Enable, Generic<Value>) \
+  X(EnableVertexAttribArray, Generic<Value>) \
+  X(EnableVertexArrayAttrib, Generic<VertexArrayName, Value>) \
+  X(EndQuery, Generic<Value>) \
+  X(Finish, Generic<>) \
+  X(Flush, Generic<>) \
+  X(FrontFace, Generic<Value>) \
+  X(GenBuffers, Gen<ObjectType::Buffer>) \
+  X(GenFramebuffers, Gen<ObjectType::Framebuffer>) \
+  X(GenQueries, Gen<ObjectType::Query>) \
+  X(GenSamplers, Gen<ObjectType::Sampler>) \
+  X(GenTextures, Gen<ObjectType::Texture>) \
+  X(GenVertexArrays, Gen<ObjectType::VertexArray>) \
+  X(GenerateMipmap, Generic<Value>) \
+  X(GenerateTextureMipmap, Generic<TextureName>) \
+  X(GetUniformLocation, GetUniformLocation) \
+  X(LinkProgram, Generic<ProgramName>) \
+  X(MultiDrawArraysIndirect, Generic<Value, Offset, Value, Value>) \
+  X(MultiDrawElementsIndirect, Generic<Value, Value, Offset, Value, Value>) \
+  X(NamedBufferStorage, NamedBufferStorage) \
+  X(NamedBufferSubData, NamedBufferSubData) \
+  X(NamedFramebufferDrawBuffers, NamedFramebufferDrawBuffers) \
+  X(NamedFramebufferTexture, Generic<FramebufferName, Value, TextureName, Value>) \
+  X(NamedFramebufferTextureLayer, Generic<FramebufferName, Value, TextureName, Value, Value>) \
+  X(PixelStorei, Generic<Value, Value>) \
+  X(PolygonMode, Generic<Value, Value>) \
+  X(ProgramUniform1f, Generic<ProgramName, Value, Value>) \
+  X(ProgramUniform1i, Generic<ProgramName, Value, Value>) \
+  X(ProgramUniform1ui, Generic<ProgramName, Value, Value>) \
+  X(ProgramUniform2fv, ProgramUniformArray<GLfloat, 2>) \
+  X(ProgramUniform3fv, ProgramUniformArray<GLfloat, 3>) \
+  X(ProgramUniform4fv, ProgramUniformArray<GLfloat, 4>) \
+  X(ProgramUniformMatrix3fv, ProgramUniformMatrix<9>) \
+  X(ProgramUniformMatrix4fv, ProgramUniformMatrix<16>) \
+  X(QueryCounter, Generic<QueryName, Value>) \
+  X(Scissor, Generic<Value, Value, Value, Value>) \
+  X(ShaderSource, ShaderSource) \
+  X(TexImage2D, TexImage2D) \
+  X(TexParameterf, Generic<Value, Value, Value>) \
+  X(TexParameteri, Generic<Value, Value, Value>) \
+  X(TexSubImage2D, TexSubImage2D) \
+  X(TextureParameterf, Generic<TextureName, Value, Value>) \
+  X(TextureParameteri, Generic<TextureName, Value, Value>) \
+  X(TextureStorage2D, Generic<TextureName, Value, Value, Value, Value>) \
+  X(TextureStorage3D, Generic<TextureName, Value, Value, Value, Value, Value>) \
+  X(TextureSubImage2D, TextureSubImage2D) \
+  X(TextureSubImage3D, TextureSubImage3D) \
+  X(Uniform1f, Generic<Location, Value>) \
+  X(Uniform1fv, UniformArray<GLfloat, 1>) \
+  X(Uniform1i, Generic<Location, Value>) \
+  X(Uniform1iv, UniformArray<GLint, 1>) \
+  X(Uniform1ui, Generic<Location, Value>) \
+  X(Uniform2f, Generic<Location, Value, Value>) \
+  X(Uniform2fv, UniformArray<GLfloat, 2>) \
+  X(Uniform3f, Generic<Location, Value, Value, Value>) \
+  X(Uniform3fv, UniformArray<GLfloat, 3>) \
+  X(Uniform4f, Generic<Location, Value, Value, Value, Value>) \
+  X(Uniform4fv, UniformArray<GLfloat, 4>) \
+  X(UniformMatrix3fv, UniformMatrix<9>) \
+  X(UniformMatrix4fv, UniformMatrix<16>) \
+  X(UseProgram, UseProgram) \
+  X(VertexArrayAttribBinding, Generic<VertexArrayName, Value, Value>) \
+  X(VertexArrayAttribFormat, Generic<VertexArrayName, Value, Value, Value, Value, Value>) \
+  X(VertexArrayAttribIFormat, Generic<VertexArrayName, Value, Value, Value, Value>) \
+  X(VertexArrayBindingDivisor, Generic<VertexArrayName, Value, Value>) \
+  X(VertexArrayElementBuffer, Generic<VertexArrayName, BufferName>) \
+  X(VertexArrayVertexBuffer, Generic<VertexArrayName, Value, BufferName, Value, Value>) \
+  X(VertexAttribDivisor, Generic<Value, Value>) \
+  X(VertexAttribIPointer, Generic<Value, Value, Value, Value, Offset>) \
+  X(VertexAttribPointer, Generic<Value, Value, Value, Value, Value, Offset>) \
+  X(Viewport, Generic<Value, Value, Value, Value>) \
+  X(BlitNamedFramebuffer, Generic<FramebufferName, FramebufferName, Value, Value, Value, Value, Value, Value, Value, \
+    Value, Value, Value>) \
+  X(MapNamedBufferRange, MapNamedBufferRange) \
+  X(FlushMappedNamedBufferRange, FlushMappedNamedBufferRange) \
+  X(UnmapNamedBuffer, UnmapNamedBuffer) \
+  X(FenceSync, FenceSync) \
+  X(ClientWaitSync, ClientWaitSync) \
+  X(DeleteSync, DeleteSync) \
+  X(ProgramBinary, ProgramBinary) \
+  X(ProgramParameteri, Generic<ProgramName, Value, Value>) \
+  X(ShaderBinary, ShaderBinary)
+
+// Extension calls: name, table in extensions.hxx, entry. Their ids follow the
+// glad calls, appending to either list changes them and needs a new kVersion.
+#define ENGINE_GL_CAPTURED_EXTENSION_CALLS(X) \
+  X(GetTextureHandleARB, BindlessTextureTable, GetTextureHandle) \
+  X(MakeTextureHandleResidentARB, BindlessTextureTable, MakeTextureHandleResident) \
+  X(MakeTextureHandleNonResidentARB, BindlessTextureTable, MakeTextureHandleNonResident) \
+  X(SpecializeShader, SpirvTable, SpecializeShader)
+
+enum CallId : uint16_t
+{
+  kBeginFrame,
+  kEndFrame,
+#define ENGINE_GL_CALL_ID(name, ...) kCall##name,
+  ENGINE_GL_CAPTURED_CALLS(ENGINE_GL_CALL_ID)
+  ENGINE_GL_CAPTURED_EXTENSION_CALLS(ENGINE_GL_CALL_ID)
+#undef ENGINE_GL_CALL_ID
+  kCallCount,
+};
+
+#define ENGINE_GL_CALL_TYPE(name, ...) __VA_ARGS__::Call<kCall##name, &glad_gl##name>
+#define ENGINE_GL_EXTENSION_CALL_TYPE(name, table, entry) entry##Call<kCall##name>
+
+template<class Call, class Pointer>
+void Install(Pointer& pointer)
+{
+  // Functions the driver does not expose stay null and are never called
+  if (pointer && pointer != &Call::Hook) {
+    Call::original = pointer;
+    pointer = &Call::Hook;
+  }
+}
+
+template<class Call, class Pointer>
+void Uninstall(Pointer& pointer)
+{
+  if (pointer == &Call::Hook)
+    pointer = Call::original;
+}
+
+void InstallHooks()
+{
+#define ENGINE_GL_INSTALL(name, ...) Install<ENGINE_GL_CALL_TYPE(name, __VA_ARGS__)>(glad_gl##name);
+  ENGINE_GL_CAPTURED_CALLS(ENGINE_GL_INSTALL)
+#undef ENGINE_GL_INSTALL
+
+#define ENGINE_GL_INSTALL(name, table, entry) \
+  if (auto* functions = detail::table()) \
+    Install<ENGINE_GL_EXTENSION_CALL_TYPE(name, table, entry)>(functions->entry);
+  ENGINE_GL_CAPTURED_EXTENSION_CALLS(ENGINE_GL_INSTALL)
+#undef ENGINE_GL_INSTALL
+}
+
+void UninstallHooks()
+{
+#define ENGINE_GL_UNINSTALL(name, ...) Uninstall<ENGINE_GL_CALL_TYPE(name, __VA_ARGS__)>(glad_gl##name);
+  ENGINE_GL_CAPTURED_CALLS(ENGINE_GL_UNINSTALL)
+#undef ENGINE_GL_UNINSTALL
+
+#define ENGINE_GL_UNINSTALL(name, table, entry) \
+  if (auto* functions = detail::table()) \
+    Uninstall<ENGINE_GL_EXTENSION_CALL_TYPE(name, table, entry)>(functions->entry);
+  ENGINE_GL_CAPTURED_EXTENSION_CALLS(ENGINE_GL_UNINSTALL)
+#undef ENGINE_GL_UNINSTALL
+
+  g_mappings.clear();
+}
+
+using ReplayFunction = void (*)(Reader&, ReplayState&);
+
+const ReplayFunction kReplayFunctions[kCallCount] = {
+  nullptr,
+  nullptr,
+#define ENGINE_GL_REPLAY(name, ...) &ENGINE_GL_CALL_TYPE(name, __VA_ARGS__)::Replay,
+  ENGINE_GL_CAPTURED_CALLS(ENGINE_GL_REPLAY)
+#undef ENGINE_GL_REPLAY
+#define ENGINE_GL_REPLAY(name, table, entry) &ENGINE_GL_EXTENSION_CALL_TYPE(name, table, entry)::Replay,
+  ENGINE_GL_CAPTURED_EXTENSION_CALLS(ENGINE_GL_REPLAY)
+#undef ENGINE_GL_REPLAY
+};
+
+constexpr std::string_view kCallNames[kCallCount] = {
+  "<begin frame>",
+  "<end frame>",
+#define ENGINE_GL_NAME(name, ...) "gl" #name,
+  ENGINE_GL_CAPTURED_CALLS(ENGINE_GL_NAME)
+  ENGINE_GL_CAPTURED_EXTENSION_CALLS(ENGINE_GL_NAME)
+#undef ENGINE_GL_NAME
+};
+
+}  // namespace
+
+CommandCapture::CommandCapture(const std::filesystem::path& path, uint32_t frames)
+ : m_stream(path, std::ios::binary), m_requested_frames(frames)
+{
+  if (g_capturing)
+    throw CaptureFail("A GL capture is already running");
+  if (frames == 0)
+    throw CaptureFail("A GL capture needs at least one frame");
+  if (!m_stream)
+    throw CaptureFail("Failed to open " + path.string());
+
+  FileHeader header;
+  m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  g_recorder.Buffer().clear();
+  g_capturing = true;
+  m_installed = true;
+  InstallHooks();
+}
+
+CommandCapture::~CommandCapture()
+{
+  Finish();
+}
+
+void CommandCapture::BeginFrame()
+{
+  if (!m_installed)
+    return;
+
+  g_recorder.Begin(kBeginFrame);
+  g_recorder.End();
+}
+
+void CommandCapture::EndFrame()
+{
+  if (!m_installed)
+    return;
+
+  g_recorder.Begin(kEndFrame);
+  g_recorder.End();
+  ++m_frames;
+
+  if (m_frames >= m_requested_frames)
+    Finish();
+  else if (g_recorder.Buffer().size() > kFlushThreshold)
+    Flush();
+}
+
+void CommandCapture::Flush()
+{
+  std::vector<uint8_t>& buffer = g_recorder.Buffer();
+  m_stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  buffer.clear();
+}
+
+void CommandCapture::Finish()
+{
+  if (!m_installed)
+    return;
+
+  UninstallHooks();
+  m_installed = false;
+  g_capturing = false;
+  Flush();
+
+  FileHeader header;
+  header.frames = m_frames;
+  m_stream.seekp(0);
+  m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_stream.close();
+}
+
+struct CommandReplayer::State : ReplayState
+{};
+
+CommandReplayer::CommandReplayer(const std::filesystem::path& path)
+ : m_state(std::make_unique<State>()), m_stats(kCallCount)
+{
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream)
+    throw CaptureFail("Failed to open " + path.string());
+
+  m_data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+  FileHeader header;
+  if (m_data.size() < sizeof(header))
+    throw CaptureFail("Not a GL capture: " + path.string());
+
+  std::memcpy(&header, m_data.data(), sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion)
+    throw CaptureFail("Unsupported GL capture: " + path.string());
+
+  m_frame_count = header.frames;
+
+  // Setup is everything before the first frame starts
+  Reader reader(m_data.data(), m_data.size(), sizeof(header));
+  m_frames_offset = m_data.size();
+  while (reader.Position() < m_data.size()) {
+    size_t record = reader.Position();
+    uint16_t call = reader.Read<uint16_t>();
+    uint32_t size = reader.Read<uint32_t>();
+    if (call == kBeginFrame) {
+      m_frames_offset = record;
+      break;
+    }
+    reader.Seek(reader.Position() + size);
+  }
+}
+
+CommandReplayer::~CommandReplayer() = default;
+
+void CommandReplayer::ReplaySetup()
+{
+  Replay(sizeof(FileHeader), m_frames_offset, {});
+}
+
+void CommandReplayer::ReplayFrames(const std::function<void()>& on_frame)
+{
+  Replay(m_frames_offset, m_data.size(), on_frame);
+}
+
+void CommandReplayer::ResetStats()
+{
+  m_stats.assign(kCallCount, {});
+}
+
+void CommandReplayer::Replay(size_t begin, size_t end, const std::function<void()>& on_frame)
+{
+  m_state->stats = &m_stats;
+  m_state->measure = m_measure;
+
+  Reader reader(m_data.data(), end, begin);
+  while (reader.Position() < end) {
+    uint16_t call = reader.Read<uint16_t>();
+    uint32_t size = reader.Read<uint32_t>();
+    size_t next = reader.Position() + size;
+
+    if (call == kEndFrame) {
+      if (on_frame)
+        on_frame();
+    }
+    else if (call < kCallCount && kReplayFunctions[call]) {
+      kReplayFunctions[call](reader, *m_state);
+    }
+
+    // Unknown calls from newer captures are skipped
+    reader.Seek(next);
+  }
+}
+
+size_t CommandReplayer::CallCount()
+{
+  return kCallCount;
+}
+
+std::string_view CommandReplayer::CallName(size_t call)
+{
+  return call < kCallCount ? kCallNames[call] : std::string_view("<unknown>");
+}
+
+}  // namespace engine::gl
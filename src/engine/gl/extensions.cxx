@@ -0,0 +1,133 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/extensions.hxx"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+template<typename Function>
+bool Load(Function& function, const char* name)
+{
+  function = reinterpret_cast<Function>(glfwGetProcAddress(name));
+  return function != nullptr;
+}
+
+}  // namespace
+
+bool HasExtension(std::string_view name)
+{
+  // The engine runs a single context, the list is read once
+  static const std::vector<std::string> extensions = []
+  {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (GLint i = 0; i < count; ++i)
+      names.emplace_back(reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i)));
+    return names;
+  }();
+
+  return std::find(extensions.begin(), extensions.end(), name) != extensions.end();
+}
+
+const BindlessTextureFunctions* GetBindlessTextureFunctions()
+{
+  return detail::BindlessTextureTable();
+}
+
+const ParallelShaderCompileFunctions* GetParallelShaderCompileFunctions()
+{
+  static const std::optional<ParallelShaderCompileFunctions> functions = []()
+    -> std::optional<ParallelShaderCompileFunctions>
+  {
+    ParallelShaderCompileFunctions table;
+    if (HasExtension("GL_KHR_parallel_shader_compile")
+      && Load(table.MaxShaderCompilerThreads, "glMaxShaderCompilerThreadsKHR"))
+      return table;
+    if (HasExtension("GL_ARB_parallel_shader_compile")
+      && Load(table.MaxShaderCompilerThreads, "glMaxShaderCompilerThreadsARB"))
+      return table;
+    return std::nullopt;
+  }();
+
+  return functions ? &*functions : nullptr;
+}
+
+const SpirvFunctions* GetSpirvFunctions()
+{
+  return detail::SpirvTable();
+}
+
+namespace detail
+{
+
+BindlessTextureFunctions* BindlessTextureTable()
+{
+  static std::optional<BindlessTextureFunctions> functions = []() -> std::optional<BindlessTextureFunctions>
+  {
+    BindlessTextureFunctions table;
+    if (!HasExtension("GL_ARB_bindless_texture")
+      || !Load(table.GetTextureHandle, "glGetTextureHandleARB")
+      || !Load(table.MakeTextureHandleResident, "glMakeTextureHandleResidentARB")
+      || !Load(table.MakeTextureHandleNonResident, "glMakeTextureHandleNonResidentARB"))
+      return std::nullopt;
+    return table;
+  }();
+
+  return functions ? &*functions : nullptr;
+}
+
+SpirvFunctions* SpirvTable()
+{
+  static std::optional<SpirvFunctions> functions = []() -> std::optional<SpirvFunctions>
+  {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &count);
+    std::vector<GLint> formats(count);
+    if (count > 0)
+      glGetIntegerv(GL_SHADER_BINARY_FORMATS, formats.data());
+    if (std::find(formats.begin(), formats.end(), GL_SHADER_BINARY_FORMAT_SPIR_V) == formats.end())
+      return std::nullopt;
+
+    SpirvFunctions table;
+    if (GLAD_GL_VERSION_4_6 && glSpecializeShader) {
+      table.SpecializeShader = glSpecializeShader;
+      return table;
+    }
+    if (HasExtension("GL_ARB_gl_spirv") && Load(table.SpecializeShader, "glSpecializeShaderARB"))
+      return table;
+    return std::nullopt;
+  }();
+
+  return functions ? &*functions : nullptr;
+}
+
+}  // namespace detail
+
+}  // namespace engine::gl
@@ -0,0 +1,72 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/framebuffer.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <string>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+std::string StatusName(GLenum status)
+{
+  switch (status) {
+  case GL_FRAMEBUFFER_UNDEFINED: return "undefined";
+  case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT: return "incomplete attachment";
+  case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: return "missing attachment";
+  case GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER: return "incomplete draw buffer";
+  case GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER: return "incomplete read buffer";
+  case GL_FRAMEBUFFER_UNSUPPORTED: return "unsupported";
+  case GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE: return "incomplete multisample";
+  case GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS: return "incomplete layer targets";
+  default: return "status " + std::to_string(status);
+  }
+}
+
+}  // namespace
+
+Framebuffer::Framebuffer(const std::source_location& location)
+ : m_framebuffer(FramebufferHandle::Create(location))
+{}
+
+void Framebuffer::AttachTexture(GLenum attachment, const Texture& texture, GLint level)
+{
+  glNamedFramebufferTexture(m_framebuffer.Get(), attachment, texture.Get(), level);
+}
+
+void Framebuffer::AttachLayer(GLenum attachment, const Texture& texture, GLint layer, GLint level)
+{
+  glNamedFramebufferTextureLayer(m_framebuffer.Get(), attachment, texture.Get(), level, layer);
+}
+
+void Framebuffer::SetDrawBuffers(std::initializer_list<GLenum> attachments)
+{
+  glNamedFramebufferDrawBuffers(m_framebuffer.Get(), static_cast<GLsizei>(attachments.size()), attachments.begin());
+}
+
+void Framebuffer::Validate() const
+{
+  GLenum status = glCheckNamedFramebufferStatus(m_framebuffer.Get(), GL_FRAMEBUFFER);
+  if (status != GL_FRAMEBUFFER_COMPLETE)
+    throw FramebufferIncomplete("Framebuffer " + std::to_string(m_framebuffer.Get()) + " is incomplete: " + StatusName(status));
+}
+
+}  // namespace engine::gl
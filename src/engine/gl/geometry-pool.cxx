@@ -0,0 +1,59 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/geometry-pool.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <string>
+
+namespace engine::gl
+{
+
+GeometryPool::GeometryPool(GLsizei vertex_stride, uint32_t max_vertices, uint32_t max_indices)
+ : m_vertices(GLsizeiptr(vertex_stride) * max_vertices, nullptr, GL_DYNAMIC_STORAGE_BIT),
+   m_indices(GLsizeiptr(sizeof(uint32_t)) * max_indices, nullptr, GL_DYNAMIC_STORAGE_BIT),
+   m_vertex_stride(vertex_stride), m_max_vertices(max_vertices), m_max_indices(max_indices)
+{}
+
+MeshRange GeometryPool::Add(const void* vertices, uint32_t vertex_count, std::span<const uint32_t> indices)
+{
+  const uint32_t index_count = static_cast<uint32_t>(indices.size());
+  if (vertex_count > m_max_vertices - m_vertex_count || index_count > m_max_indices - m_index_count)
+    throw GeometryPoolFull("Geometry pool is full: " + std::to_string(m_vertex_count) + " of "
+      + std::to_string(m_max_vertices) + " vertices, " + std::to_string(m_index_count) + " of "
+      + std::to_string(m_max_indices) + " indices used");
+
+  m_vertices.Update(GLintptr(m_vertex_stride) * m_vertex_count, GLsizeiptr(m_vertex_stride) * vertex_count, vertices);
+  m_indices.Update(indices, GLintptr(sizeof(uint32_t)) * m_index_count);
+
+  MeshRange range;
+  range.first = m_index_count;
+  range.count = index_count;
+  range.base_vertex = static_cast<int32_t>(m_vertex_count);
+
+  m_vertex_count += vertex_count;
+  m_index_count += index_count;
+  return range;
+}
+
+void GeometryPool::Attach(VertexArray& vertex_array, GLuint binding) const
+{
+  vertex_array.SetVertexBuffer(binding, m_vertices, 0, m_vertex_stride);
+  vertex_array.SetElementBuffer(m_indices);
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,133 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/handle.hxx"
+
+#include <algorithm>
+#include <array>
+
+namespace engine::gl
+{
+
+std::string_view ObjectKindName(ObjectKind kind)
+{
+  switch (kind) {
+  case ObjectKind::Buffer: return "buffer";
+  case ObjectKind::Texture: return "texture";
+  case ObjectKind::VertexArray: return "vertex array";
+  case ObjectKind::Framebuffer: return "framebuffer";
+  case ObjectKind::Renderbuffer: return "renderbuffer";
+  case ObjectKind::Sampler: return "sampler";
+  case ObjectKind::Query: return "query";
+  case ObjectKind::ProgramPipeline: return "program pipeline";
+  case ObjectKind::TransformFeedback: return "transform feedback";
+  case ObjectKind::Shader: return "shader";
+  case ObjectKind::Program: return "program";
+  default: return "unknown";
+  }
+}
+
+ObjectRegistry& ObjectRegistry::Instance()
+{
+  static ObjectRegistry registry;
+  return registry;
+}
+
+void ObjectRegistry::Track(ObjectKind kind, GLuint name, const std::source_location& location)
+{
+  std::lock_guard lock(m_mutex);
+  m_entries[Key(kind, name)] = {kind, name, 0, location};
+}
+
+void ObjectRegistry::Untrack(ObjectKind kind, GLuint name)
+{
+  std::lock_guard lock(m_mutex);
+  m_entries.erase(Key(kind, name));
+}
+
+void ObjectRegistry::SetBytes(ObjectKind kind, GLuint name, size_t bytes)
+{
+  std::lock_guard lock(m_mutex);
+  auto it = m_entries.find(Key(kind, name));
+  if (it != m_entries.end())
+    it->second.bytes = bytes;
+}
+
+std::vector<ObjectRegistry::Entry> ObjectRegistry::Snapshot() const
+{
+  std::vector<Entry> entries;
+  {
+    std::lock_guard lock(m_mutex);
+    entries.reserve(m_entries.size());
+    for (const auto& [key, entry] : m_entries)
+      entries.push_back(entry);
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+    {
+      return a.kind != b.kind ? a.kind < b.kind : a.name < b.name;
+    });
+  return entries;
+}
+
+size_t ObjectRegistry::LiveCount() const
+{
+  std::lock_guard lock(m_mutex);
+  return m_entries.size();
+}
+
+size_t ObjectRegistry::LiveBytes() const
+{
+  std::lock_guard lock(m_mutex);
+  size_t bytes = 0;
+  for (const auto& [key, entry] : m_entries)
+    bytes += entry.bytes;
+  return bytes;
+}
+
+void ObjectRegistry::Report(std::ostream& stream) const
+{
+  std::vector<Entry> entries = Snapshot();
+
+  struct Total
+  {
+    size_t count = 0;
+    size_t bytes = 0;
+  };
+  std::array<Total, static_cast<size_t>(ObjectKind::Count)> totals = {};
+  for (const Entry& entry : entries) {
+    Total& total = totals[static_cast<size_t>(entry.kind)];
+    ++total.count;
+    total.bytes += entry.bytes;
+  }
+
+  stream << entries.size() << " live GL objects\n";
+  for (size_t kind = 0; kind < totals.size(); ++kind) {
+    if (totals[kind].count > 0)
+      stream << "  " << ObjectKindName(static_cast<ObjectKind>(kind)) << ": " << totals[kind].count << ", "
+             << totals[kind].bytes << " bytes\n";
+  }
+
+  for (const Entry& entry : entries) {
+    stream << "  " << ObjectKindName(entry.kind) << " " << entry.name;
+    if (entry.bytes > 0)
+      stream << " (" << entry.bytes << " bytes)";
+    stream << " created at " << entry.location.file_name() << ":" << entry.location.line() << " in "
+           << entry.location.function_name() << "\n";
+  }
+}
+
+}  // namespace engine::gl
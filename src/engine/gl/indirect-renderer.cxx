@@ -0,0 +1,116 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/indirect-renderer.hxx"
+
+#include "core/exceptions.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <cstring>
+#include <span>
+#include <string>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+// Upper bound of GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT the specification allows
+constexpr GLsizeiptr kMaxStorageAlignment = 256;
+
+GLsizeiptr FrameSize(GLsizeiptr object_size, uint32_t max_objects, uint32_t max_batches)
+{
+  const GLsizeiptr per_object = object_size + GLsizeiptr(sizeof(DrawElementsIndirectCommand));
+  const GLsizeiptr per_batch = kMaxStorageAlignment + GLsizeiptr(alignof(DrawElementsIndirectCommand));
+  return per_object * max_objects + per_batch * max_batches;
+}
+
+}  // namespace
+
+IndirectRenderer::IndirectRenderer(GLsizeiptr object_size, GLuint object_binding, uint32_t max_objects,
+  uint32_t max_batches)
+ : m_object_size(object_size), m_object_binding(object_binding), m_max_batches(max_batches),
+   m_ring(FrameSize(object_size, max_objects, max_batches))
+{}
+
+uint16_t IndirectRenderer::AddBatch(const Pipeline& pipeline, const Material& material)
+{
+  if (m_batches.size() == m_max_batches)
+    throw RenderQueueLimit("Indirect renderer is limited to " + std::to_string(m_max_batches) + " batches");
+
+  m_batches.push_back({pipeline, material, {}, {}});
+  return static_cast<uint16_t>(m_batches.size() - 1);
+}
+
+void IndirectRenderer::BeginFrame()
+{
+  m_ring.BeginFrame();
+  for (Batch& batch : m_batches) {
+    batch.commands.clear();
+    batch.objects.clear();
+  }
+}
+
+void IndirectRenderer::Submit(uint16_t batch_index, const MeshRange& mesh, const void* object)
+{
+  Batch& batch = m_batches[batch_index];
+
+  // gl_DrawID is the command's position in the batch, so is the object's
+  DrawElementsIndirectCommand command;
+  command.count = mesh.count;
+  command.instance_count = mesh.instance_count;
+  command.first_index = mesh.first;
+  command.base_vertex = mesh.base_vertex;
+  batch.commands.push_back(command);
+
+  const size_t offset = batch.objects.size();
+  batch.objects.resize(offset + m_object_size);
+  std::memcpy(batch.objects.data() + offset, object, m_object_size);
+}
+
+void IndirectRenderer::Execute(StateCache& state)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  m_stats = {};
+  for (const Batch& batch : m_batches) {
+    if (batch.commands.empty())
+      continue;
+
+    RingBuffer::Allocation objects = m_ring.Push(std::span<const std::byte>(batch.objects), m_ring.StorageAlignment());
+    RingBuffer::Allocation commands = m_ring.Push(std::span<const DrawElementsIndirectCommand>(batch.commands));
+
+    ApplyPipeline(state, batch.pipeline);
+    ApplyMaterial(state, batch.material);
+    state.BindBufferRange(GL_SHADER_STORAGE_BUFFER, m_object_binding, m_ring.Get(), objects.offset, objects.size);
+    state.BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_ring.Get());
+
+    glMultiDrawElementsIndirect(batch.pipeline.mode, GL_UNSIGNED_INT, reinterpret_cast<const void*>(commands.offset),
+      static_cast<GLsizei>(batch.commands.size()), 0);
+
+    m_stats.objects += static_cast<uint32_t>(batch.commands.size());
+    ++m_stats.batches;
+    ++m_stats.draw_calls;
+  }
+}
+
+void IndirectRenderer::EndFrame()
+{
+  m_ring.EndFrame();
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,94 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/instancing.hxx"
+
+#include <cstddef>
+
+namespace engine::gl
+{
+
+InstanceBuffer::InstanceBuffer(uint32_t capacity, const std::source_location& location)
+ : m_buffer(GLsizeiptr(sizeof(Instance)) * capacity, nullptr, GL_DYNAMIC_STORAGE_BIT, location), m_capacity(capacity)
+{}
+
+void InstanceBuffer::Update(std::span<const Instance> instances, uint32_t first)
+{
+  m_buffer.Update(instances, GLintptr(sizeof(Instance)) * first);
+}
+
+void InstanceBuffer::AttachAttributes(VertexArray& vertex_array, GLuint binding, GLuint attribute) const
+{
+  vertex_array.SetVertexBuffer(binding, m_buffer, 0, sizeof(Instance));
+  vertex_array.SetBindingDivisor(binding, 1);
+  vertex_array.SetAttribute(attribute, binding, 4, GL_FLOAT, offsetof(Instance, position));
+  vertex_array.SetAttribute(attribute + 1, binding, 4, GL_FLOAT, offsetof(Instance, rotation));
+}
+
+void InstanceBuffer::BindStorage(StateCache& state, GLuint binding) const
+{
+  state.BindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, m_buffer.Get());
+}
+
+std::string InstanceBuffer::Glsl(InstanceFetch fetch, GLuint slot)
+{
+  std::string text = R"(
+struct Instance
+{
+  vec3 position;
+  float scale;
+  vec4 rotation;
+};
+)";
+
+  if (fetch == InstanceFetch::Attributes) {
+    text += "layout (location = " + std::to_string(slot) + ") in vec4 instance_position_scale;\n";
+    text += "layout (location = " + std::to_string(slot + 1) + ") in vec4 instance_rotation;\n";
+    text += R"(
+Instance LoadInstance()
+{
+  return Instance(instance_position_scale.xyz, instance_position_scale.w, instance_rotation);
+}
+)";
+  }
+  else {
+    text += "layout (std430, binding = " + std::to_string(slot) + ") readonly buffer InstanceArray\n";
+    text += R"({
+  Instance instances[];
+};
+
+Instance LoadInstance()
+{
+  return instances[gl_BaseInstance + gl_InstanceID];
+}
+)";
+  }
+
+  text += R"(
+vec3 RotateByQuaternion(vec3 v, vec4 q)
+{
+  return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+vec3 InstanceToWorld(Instance instance, vec3 position)
+{
+  return instance.position + RotateByQuaternion(instance.scale * position, instance.rotation);
+}
+)";
+  return text;
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,192 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/program-builder.hxx"
+
+#include "core/exceptions.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <utility>
+
+namespace engine::gl
+{
+
+ProgramBuilder::ProgramBuilder(ProgramCache* cache, GLuint compiler_threads)
+ : m_cache(cache)
+{
+  if (const ParallelShaderCompileFunctions* parallel = GetParallelShaderCompileFunctions()) {
+    parallel->MaxShaderCompilerThreads(compiler_threads);
+    m_parallel = true;
+  }
+}
+
+std::vector<ShaderStage> ProgramBuilder::Stages(const Job& job) const
+{
+  std::vector<ShaderStage> stages;
+  stages.reserve(job.types.size());
+  for (size_t i = 0; i < job.types.size(); ++i)
+    stages.push_back({job.types[i], job.sources[i], job.hashes[i]});
+  return stages;
+}
+
+ProgramBuilder::Ticket ProgramBuilder::Submit(std::initializer_list<ShaderStage> stages,
+  const std::source_location& location)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  const Ticket ticket = static_cast<Ticket>(m_jobs.size());
+  Job& job = m_jobs.emplace_back();
+  job.location = location;
+  job.start = std::chrono::steady_clock::now();
+  for (const ShaderStage& stage : stages) {
+    job.types.push_back(stage.type);
+    job.sources.emplace_back(stage.source);
+    job.hashes.push_back(stage.hash);
+  }
+
+  if (m_cache) {
+    if (std::optional<ProgramHandle> program = m_cache->Find(Stages(job), location)) {
+      job.program = std::move(*program);
+      job.sources = {};
+      job.step = Step::Done;
+      job.status = ProgramStatus::Ready;
+      return ticket;
+    }
+  }
+
+  // Only issued here, nothing is queried until Poll
+  for (size_t i = 0; i < job.types.size(); ++i) {
+    const GLchar* data = job.sources[i].data();
+    const GLint length = static_cast<GLint>(job.sources[i].size());
+
+    ShaderHandle shader = ShaderHandle::Create(job.types[i], location);
+    glShaderSource(shader.Get(), 1, &data, &length);
+    glCompileShader(shader.Get());
+    job.shaders.push_back(std::move(shader));
+  }
+
+  ++m_pending;
+  return ticket;
+}
+
+bool ProgramBuilder::IsComplete(GLuint object, bool program) const
+{
+  if (!m_parallel)
+    return true;
+
+  GLint complete = GL_FALSE;
+  if (program)
+    glGetProgramiv(object, ParallelShaderCompileFunctions::kCompletionStatus, &complete);
+  else
+    glGetShaderiv(object, ParallelShaderCompileFunctions::kCompletionStatus, &complete);
+  return complete == GL_TRUE;
+}
+
+void ProgramBuilder::Fail(Job& job, std::string log)
+{
+  job.log = std::move(log);
+  job.step = Step::Done;
+  job.status = ProgramStatus::Failed;
+  job.shaders.clear();
+  job.program.Reset();
+  --m_pending;
+}
+
+void ProgramBuilder::Advance(Job& job)
+{
+  if (job.step == Step::Compiling) {
+    for (const ShaderHandle& shader : job.shaders) {
+      if (!IsComplete(shader.Get(), false))
+        return;
+    }
+
+    // Every stage is reported, not only the first one that failed
+    std::string log;
+    for (size_t i = 0; i < job.shaders.size(); ++i) {
+      GLint status = GL_FALSE;
+      glGetShaderiv(job.shaders[i].Get(), GL_COMPILE_STATUS, &status);
+      if (status != GL_TRUE)
+        log += "Failed to compile " + std::string(ShaderStageName(job.types[i])) + " shader:\n"
+          + ShaderInfoLog(job.shaders[i].Get());
+    }
+    if (!log.empty())
+      return Fail(job, std::move(log));
+
+    job.program = ProgramHandle::Create(job.location);
+    if (m_cache && m_cache->IsEnabled())
+      glProgramParameteri(job.program.Get(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    for (const ShaderHandle& shader : job.shaders)
+      glAttachShader(job.program.Get(), shader.Get());
+    glLinkProgram(job.program.Get());
+    job.step = Step::Linking;
+  }
+
+  if (job.step == Step::Linking) {
+    if (!IsComplete(job.program.Get(), true))
+      return;
+
+    for (const ShaderHandle& shader : job.shaders)
+      glDetachShader(job.program.Get(), shader.Get());
+    job.shaders.clear();
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(job.program.Get(), GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+      return Fail(job, "Failed to link program:\n" + ProgramInfoLog(job.program.Get()));
+
+    // Submit to here spans idle frames, it is latency rather than compile cost
+    job.latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job.start).count();
+    if (m_cache)
+      m_cache->Insert(Stages(job), job.program.Get(), std::nullopt);
+
+    // The sources are only needed to key the cache
+    job.sources = {};
+    job.step = Step::Done;
+    job.status = ProgramStatus::Ready;
+    --m_pending;
+  }
+}
+
+void ProgramBuilder::Poll()
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  if (m_pending == 0)
+    return;
+
+  for (Job& job : m_jobs) {
+    if (job.step != Step::Done)
+      Advance(job);
+  }
+}
+
+void ProgramBuilder::Finish()
+{
+  while (m_pending > 0)
+    Poll();
+}
+
+ShaderProgram ProgramBuilder::Take(Ticket ticket)
+{
+  Job& job = m_jobs[ticket];
+  if (job.status != ProgramStatus::Ready)
+    throw ProgramLinkFail("Program " + std::to_string(ticket) + " is not ready to be taken");
+
+  job.status = ProgramStatus::Taken;
+  return ShaderProgram(std::move(job.program));
+}
+
+}  // namespace engine::gl
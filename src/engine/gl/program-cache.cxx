@@ -0,0 +1,241 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/program-cache.hxx"
+
+#include "profiling/cpu-profiler.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+constexpr uint32_t kMagic = 0x43504245;  // "EBPC"
+// 2: asynchronous builds store kUnmeasured, version 1 entries stored their latency
+constexpr uint32_t kVersion = 2;
+constexpr double kUnmeasured = -1.0;
+
+struct EntryHeader
+{
+  uint32_t magic = kMagic;
+  uint32_t version = kVersion;
+  uint64_t key = 0;
+  uint32_t format = 0;
+  uint32_t size = 0;
+  double compile_ms = 0.0;
+};
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+// 64-bit FNV-1a, collisions across a few thousand programs are not a concern
+uint64_t Hash(uint64_t hash, std::string_view text)
+{
+  for (char c : text)
+    hash = (hash ^ static_cast<uint8_t>(c)) * kFnvPrime;
+  // Terminate every field so that ("ab", "c") and ("a", "bc") differ
+  return (hash ^ 0xff) * kFnvPrime;
+}
+
+std::string_view GlString(GLenum name)
+{
+  const GLubyte* value = glGetString(name);
+  return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+ProgramCache::ProgramCache(std::filesystem::path directory, bool enabled)
+ : m_directory(std::move(directory))
+{
+  GLint formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+  std::error_code error;
+  m_enabled = enabled && formats > 0 && (std::filesystem::create_directories(m_directory, error) || !error);
+
+  m_driver_hash = Hash(Hash(Hash(kFnvOffset, GlString(GL_VENDOR)), GlString(GL_RENDERER)), GlString(GL_VERSION));
+}
+
+uint64_t ProgramCache::Key(std::span<const ShaderStage> stages) const
+{
+  uint64_t hash = m_driver_hash;
+  for (const ShaderStage& stage : stages) {
+    hash = (hash ^ stage.type) * kFnvPrime;
+    hash = stage.hash != 0 ? (hash ^ stage.hash) * kFnvPrime : Hash(hash, stage.source);
+  }
+  return hash;
+}
+
+std::filesystem::path ProgramCache::EntryPath(uint64_t key) const
+{
+  char name[24];
+  std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+  return m_directory / name;
+}
+
+ShaderProgram ProgramCache::Link(std::initializer_list<ShaderStage> stages, const std::source_location& location)
+{
+  return Link(std::span<const ShaderStage>(stages.begin(), stages.size()), location);
+}
+
+ShaderProgram ProgramCache::Link(std::span<const ShaderStage> stages, const std::source_location& location)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  if (std::optional<ProgramHandle> program = Find(stages, location))
+    return ShaderProgram(std::move(*program));
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<ShaderHandle> shaders;
+  shaders.reserve(stages.size());
+  for (const ShaderStage& stage : stages)
+    shaders.push_back(CompileShader(stage.type, stage.source, location));
+  ProgramHandle program = LinkProgram(shaders, m_enabled, location);
+
+  Insert(stages, program.Get(), MillisecondsSince(start));
+  return ShaderProgram(std::move(program));
+}
+
+std::optional<ProgramHandle> ProgramCache::Find(std::span<const ShaderStage> stages,
+  const std::source_location& location)
+{
+  if (!m_enabled)
+    return std::nullopt;
+
+  ++m_stats.lookups;
+
+  auto start = std::chrono::steady_clock::now();
+  std::optional<ProgramHandle> program = Load(Key(stages), location);
+  if (program)
+    m_stats.load_ms += MillisecondsSince(start);
+  return program;
+}
+
+void ProgramCache::Insert(std::span<const ShaderStage> stages, GLuint program, std::optional<double> compile_ms)
+{
+  if (!m_enabled)
+    return;
+
+  if (compile_ms)
+    m_stats.compile_ms += *compile_ms;
+  Store(Key(stages), program, compile_ms.value_or(kUnmeasured));
+}
+
+std::optional<ProgramHandle> ProgramCache::Load(uint64_t key, const std::source_location& location)
+{
+  const std::filesystem::path path = EntryPath(key);
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream)
+    return std::nullopt;
+
+  // The size on disk bounds the binary, a corrupt header must not allocate more
+  std::error_code error;
+  const uintmax_t file_size = std::filesystem::file_size(path, error);
+
+  EntryHeader header;
+  std::vector<char> binary;
+  if (stream.read(reinterpret_cast<char*>(&header), sizeof(header))
+      && header.magic == kMagic && header.version == kVersion && header.key == key
+      && !error && header.size <= file_size - sizeof(header)) {
+    binary.resize(header.size);
+    stream.read(binary.data(), header.size);
+  }
+
+  if (binary.empty() || !stream) {
+    ++m_stats.rejected;
+    return std::nullopt;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  ProgramHandle program = ProgramHandle::Create(location);
+  glProgramBinary(program.Get(), header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  // A driver that no longer accepts the format fails the link, not the call
+  GLint status = GL_FALSE;
+  glGetProgramiv(program.Get(), GL_LINK_STATUS, &status);
+  if (status != GL_TRUE) {
+    ++m_stats.rejected;
+    return std::nullopt;
+  }
+
+  ++m_stats.hits;
+  if (header.compile_ms >= 0.0)
+    m_stats.saved_ms += header.compile_ms - MillisecondsSince(start);
+  else
+    ++m_stats.unmeasured_hits;
+  return program;
+}
+
+void ProgramCache::Store(uint64_t key, GLuint program, double compile_ms) const
+{
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return;
+
+  EntryHeader header;
+  header.key = key;
+  header.compile_ms = compile_ms;
+
+  std::vector<char> binary(length);
+  GLenum format = 0;
+  glGetProgramBinary(program, length, nullptr, &format, binary.data());
+  header.format = format;
+  header.size = static_cast<uint32_t>(binary.size());
+
+  // Written aside and renamed, a concurrent launch never reads half an entry
+  const std::filesystem::path path = EntryPath(key);
+  std::filesystem::path temporary = path;
+  temporary += ".tmp";
+  {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(binary.data(), binary.size());
+    if (!stream)
+      return;
+  }
+
+  // A cache that cannot be written only costs the next launch a compile
+  std::error_code error;
+  std::filesystem::rename(temporary, path, error);
+}
+
+void ProgramCache::Report(std::ostream& stream) const
+{
+  const double hit_rate = m_stats.lookups > 0 ? 100.0 * m_stats.hits / m_stats.lookups : 0.0;
+  stream << "Program cache: " << m_stats.hits << "/" << m_stats.lookups << " hits (" << hit_rate << "%), "
+         << m_stats.rejected << " rejected, " << m_stats.compile_ms << " ms compiling, "
+         << m_stats.load_ms << " ms loading, " << m_stats.saved_ms << " ms saved";
+  if (m_stats.unmeasured_hits > 0)
+    stream << " (" << m_stats.unmeasured_hits << " hits built asynchronously, cost unknown)";
+  stream << "\n";
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,216 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/render-queue.hxx"
+
+#include "core/exceptions.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <algorithm>
+#include <string>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+constexpr uint32_t kRadixBits = 8;
+constexpr uint32_t kRadixPasses = 64 / kRadixBits;
+constexpr uint32_t kBuckets = 1u << kRadixBits;
+
+size_t IndexSize(GLenum type)
+{
+  return type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT ? 2 : 4;
+}
+
+}  // namespace
+
+void ApplyPipeline(StateCache& state, const Pipeline& pipeline)
+{
+  state.UseProgram(pipeline.program);
+  state.BindVertexArray(pipeline.vertex_array);
+
+  if (pipeline.depth_test) {
+    state.Enable(GL_DEPTH_TEST);
+    state.DepthFunc(pipeline.depth_func);
+  }
+  else {
+    state.Disable(GL_DEPTH_TEST);
+  }
+  state.DepthMask(pipeline.depth_write);
+
+  if (pipeline.blend) {
+    state.Enable(GL_BLEND);
+    state.BlendFunc(pipeline.blend_source, pipeline.blend_destination);
+  }
+  else {
+    state.Disable(GL_BLEND);
+  }
+
+  if (pipeline.cull_face != GL_NONE) {
+    state.Enable(GL_CULL_FACE);
+    state.CullFace(pipeline.cull_face);
+  }
+  else {
+    state.Disable(GL_CULL_FACE);
+  }
+}
+
+void ApplyMaterial(StateCache& state, const Material& material)
+{
+  for (uint32_t unit = 0; unit < Material::kTextureUnits; ++unit)
+    state.BindTextureUnit(unit, material.textures[unit]);
+}
+
+uint32_t SortKey::QuantizeDepth(float depth, float near, float far)
+{
+  float normalized = far > near ? (depth - near) / (far - near) : 0.f;
+  return static_cast<uint32_t>(std::clamp(normalized, 0.f, 1.f) * kMaxDepth);
+}
+
+uint16_t RenderQueue::AddPipeline(const Pipeline& pipeline)
+{
+  if (m_pipelines.size() == SortKey::kMaxPipelines)
+    throw RenderQueueLimit("Render queue is limited to " + std::to_string(SortKey::kMaxPipelines) + " pipelines");
+
+  m_pipelines.push_back(pipeline);
+  return static_cast<uint16_t>(m_pipelines.size() - 1);
+}
+
+uint16_t RenderQueue::AddMaterial(const Material& material)
+{
+  if (m_materials.size() == SortKey::kMaxMaterials)
+    throw RenderQueueLimit("Render queue is limited to " + std::to_string(SortKey::kMaxMaterials) + " materials");
+
+  m_materials.push_back(material);
+  return static_cast<uint16_t>(m_materials.size() - 1);
+}
+
+void RenderQueue::SetDepthRange(float near, float far)
+{
+  m_near = near;
+  m_far = far;
+}
+
+void RenderQueue::SetObjectBuffer(GLenum target, GLuint binding, GLuint buffer, GLsizeiptr size)
+{
+  m_object_target = target;
+  m_object_binding = binding;
+  m_object_buffer = buffer;
+  m_object_size = size;
+}
+
+void RenderQueue::Submit(DrawPacket packet, float depth, uint32_t layer)
+{
+  const uint32_t quantized = SortKey::QuantizeDepth(depth, m_near, m_far);
+  packet.key = m_pipelines[packet.pipeline].blend
+    ? SortKey::Translucent(layer, packet.pipeline, packet.material, quantized)
+    : SortKey::Opaque(layer, packet.pipeline, packet.material, quantized);
+
+  m_order.push_back({packet.key, static_cast<uint32_t>(m_packets.size())});
+  m_packets.push_back(packet);
+  m_sorted = false;
+}
+
+void RenderQueue::Sort()
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  // LSD radix sort, stable, so equal keys keep their submission order.
+  // All histograms are built in one pass, a pass whose digit is the same for
+  // every key (the unused low byte, a single layer) is skipped.
+  const size_t count = m_order.size();
+  std::array<std::array<uint32_t, kBuckets>, kRadixPasses> histograms = {};
+  for (const SortEntry& entry : m_order) {
+    for (uint32_t pass = 0; pass < kRadixPasses; ++pass)
+      ++histograms[pass][(entry.key >> (pass * kRadixBits)) & (kBuckets - 1)];
+  }
+
+  m_scratch.resize(count);
+  for (uint32_t pass = 0; pass < kRadixPasses; ++pass) {
+    std::array<uint32_t, kBuckets>& histogram = histograms[pass];
+    const uint32_t first_digit = count > 0 ? (m_order[0].key >> (pass * kRadixBits)) & (kBuckets - 1) : 0;
+    if (histogram[first_digit] == count)
+      continue;
+
+    // Counts to starting positions
+    uint32_t offset = 0;
+    for (uint32_t& bucket : histogram) {
+      uint32_t size = bucket;
+      bucket = offset;
+      offset += size;
+    }
+
+    for (const SortEntry& entry : m_order)
+      m_scratch[histogram[(entry.key >> (pass * kRadixBits)) & (kBuckets - 1)]++] = entry;
+    m_order.swap(m_scratch);
+  }
+
+  m_sorted = true;
+}
+
+void RenderQueue::Execute(StateCache& state)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  if (!m_sorted)
+    Sort();
+
+  m_stats = {};
+  uint32_t pipeline_index = ~0u;
+  uint32_t material_index = ~0u;
+
+  for (const SortEntry& entry : m_order) {
+    const DrawPacket& packet = m_packets[entry.index];
+    const Pipeline& pipeline = m_pipelines[packet.pipeline];
+
+    if (packet.pipeline != pipeline_index) {
+      pipeline_index = packet.pipeline;
+      ApplyPipeline(state, pipeline);
+      ++m_stats.pipeline_changes;
+    }
+
+    if (packet.material != material_index) {
+      material_index = packet.material;
+      ApplyMaterial(state, m_materials[packet.material]);
+      ++m_stats.material_changes;
+    }
+
+    if (m_object_buffer != 0)
+      state.BindBufferRange(m_object_target, m_object_binding, m_object_buffer, packet.object_offset, m_object_size);
+
+    const MeshRange& mesh = packet.mesh;
+    if (pipeline.index_type == GL_NONE) {
+      glDrawArraysInstanced(pipeline.mode, mesh.first, mesh.count, mesh.instance_count);
+    }
+    else {
+      const void* indices = reinterpret_cast<const void*>(mesh.first * IndexSize(pipeline.index_type));
+      glDrawElementsInstancedBaseVertex(pipeline.mode, mesh.count, pipeline.index_type, indices, mesh.instance_count,
+        mesh.base_vertex);
+    }
+    ++m_stats.draws;
+  }
+}
+
+void RenderQueue::Clear()
+{
+  m_packets.clear();
+  m_order.clear();
+  m_sorted = true;
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,112 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/ring-buffer.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+constexpr GLbitfield kStorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+constexpr GLbitfield kMapFlags = kStorageFlags | GL_MAP_FLUSH_EXPLICIT_BIT;
+constexpr GLuint64 kWaitTimeoutNs = 1'000'000;
+
+}  // namespace
+
+RingBuffer::RingBuffer(GLsizeiptr frame_size, uint32_t frames_in_flight)
+ : m_fences(frames_in_flight, nullptr)
+{
+  GLint alignment = 0;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  m_uniform_alignment = std::max(alignment, 1);
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  m_storage_alignment = std::max(alignment, 1);
+
+  // Every region starts aligned for any kind of binding
+  const GLsizeiptr region_alignment = std::max<GLsizeiptr>({m_uniform_alignment, m_storage_alignment, 256});
+  m_frame_size = (frame_size + region_alignment - 1) / region_alignment * region_alignment;
+
+  const GLsizeiptr size = m_frame_size * frames_in_flight;
+  m_buffer = Buffer(size, nullptr, kStorageFlags);
+  m_data = static_cast<uint8_t*>(m_buffer.Map(0, size, kMapFlags));
+  if (m_data == nullptr)
+    throw RuntimeError("Failed to map a " + std::to_string(size) + " byte ring buffer");
+}
+
+RingBuffer::~RingBuffer()
+{
+  for (GLsync fence : m_fences) {
+    if (fence != nullptr)
+      glDeleteSync(fence);
+  }
+
+  if (m_data != nullptr)
+    m_buffer.Unmap();
+}
+
+void RingBuffer::BeginFrame()
+{
+  m_region = static_cast<uint32_t>(m_stats.frames % m_fences.size());
+  m_region_offset = m_region * m_frame_size;
+  m_head = 0;
+
+  GLsync& fence = m_fences[m_region];
+  if (fence == nullptr)
+    return;
+
+  GLenum result = glClientWaitSync(fence, 0, 0);
+  if (result == GL_TIMEOUT_EXPIRED) {
+    auto start = std::chrono::steady_clock::now();
+    // Flush once so the fence is guaranteed to reach the GPU
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    do {
+      result = glClientWaitSync(fence, flags, kWaitTimeoutNs);
+      flags = 0;
+    } while (result == GL_TIMEOUT_EXPIRED);
+
+    ++m_stats.stalls;
+    m_stats.stall_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
+
+  if (result == GL_WAIT_FAILED)
+    throw RuntimeError("Waiting on a ring buffer fence failed");
+}
+
+void RingBuffer::EndFrame()
+{
+  m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  m_stats.peak_usage = std::max(m_stats.peak_usage, m_head);
+  ++m_stats.frames;
+}
+
+void RingBuffer::Overflow(GLsizeiptr size) const
+{
+  throw RingBufferOverflow("Ring buffer frame region of " + std::to_string(m_frame_size) + " bytes cannot fit "
+    + std::to_string(size) + " more bytes after " + std::to_string(m_head));
+}
+
+}  // namespace engine::gl
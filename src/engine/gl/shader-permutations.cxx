@@ -0,0 +1,136 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/shader-permutations.hxx"
+
+#include "core/exceptions.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <algorithm>
+#include <utility>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+constexpr std::string_view kFeaturePragma = "#pragma feature ";
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+void CollectFeatures(std::string_view source, std::vector<std::string>& features)
+{
+  size_t position = 0;
+  while ((position = source.find(kFeaturePragma, position)) != std::string_view::npos) {
+    position += kFeaturePragma.size();
+
+    size_t end = source.find_first_of(" \t\r\n", position);
+    std::string name(source.substr(position, end - position));
+    if (!name.empty() && std::find(features.begin(), features.end(), name) == features.end())
+      features.push_back(std::move(name));
+  }
+}
+
+}  // namespace
+
+ShaderPermutations::ShaderPermutations(std::initializer_list<ShaderStage> stages, ProgramCache* cache)
+ : m_cache(cache)
+{
+  for (const ShaderStage& stage : stages) {
+    m_types.push_back(stage.type);
+    m_sources.emplace_back(stage.source);
+    m_hashes.push_back(stage.hash);
+    CollectFeatures(stage.source, m_features);
+  }
+
+  if (m_features.size() > kMaxFeatures)
+    throw ShaderFeatureFail("Shader declares " + std::to_string(m_features.size()) + " features, at most "
+      + std::to_string(kMaxFeatures) + " fit in a variant key");
+}
+
+ShaderPermutations::Key ShaderPermutations::Variant(std::initializer_list<std::string_view> features) const
+{
+  Key key = 0;
+  for (std::string_view feature : features) {
+    auto found = std::find(m_features.begin(), m_features.end(), feature);
+    if (found == m_features.end())
+      throw ShaderFeatureFail("Shader declares no feature \"" + std::string(feature) + "\"");
+    key |= Key(1) << (found - m_features.begin());
+  }
+  return key;
+}
+
+std::vector<std::string> ShaderPermutations::Sources(Key key) const
+{
+  std::string defines;
+  for (size_t i = 0; i < m_features.size(); ++i) {
+    if (key & (Key(1) << i))
+      defines += "#define " + m_features[i] + " 1\n";
+  }
+
+  std::vector<std::string> sources = m_sources;
+  for (std::string& source : sources) {
+    // #version has to stay first, a source without one gets the defines on top
+    size_t insert = 0;
+    if (size_t version = source.find("#version"); version != std::string::npos) {
+      size_t line_end = source.find('\n', version);
+      if (line_end == std::string::npos) {
+        line_end = source.size();
+        source += '\n';
+      }
+      insert = line_end + 1;
+    }
+    source.insert(insert, defines);
+  }
+  return sources;
+}
+
+const ShaderProgram& ShaderPermutations::Get(Key key, const std::source_location& location)
+{
+  if (auto found = m_variants.find(key); found != m_variants.end())
+    return found->second;
+
+  ENGINE_PROFILE_SCOPE("ShaderPermutations::Compile");
+
+  const std::vector<std::string> sources = Sources(key);
+  std::vector<ShaderStage> stages;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    // The defines follow from the key, a precomputed hash stays exact
+    const uint64_t hash = m_hashes[i] != 0 ? (m_hashes[i] ^ key) * kFnvPrime : 0;
+    stages.push_back({m_types[i], sources[i], hash});
+  }
+
+  ShaderProgram program;
+  if (m_cache) {
+    program = m_cache->Link(stages, location);
+  }
+  else {
+    std::vector<ShaderHandle> shaders;
+    for (const ShaderStage& stage : stages)
+      shaders.push_back(CompileShader(stage.type, stage.source, location));
+    program = ShaderProgram(LinkProgram(shaders, false, location));
+  }
+
+  return m_variants.emplace(key, std::move(program)).first->second;
+}
+
+void ShaderPermutations::Precompile(std::span<const Key> keys)
+{
+  for (Key key : keys)
+    Get(key);
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,279 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/shader-program.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <bit>
+#include <utility>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+std::string ResourceName(GLuint program, GLenum interface, GLuint index, GLint length)
+{
+  std::string name(length > 0 ? length - 1 : 0, '\0');
+  if (length > 0)
+    glGetProgramResourceName(program, interface, index, length, nullptr, name.data());
+  return name;
+}
+
+std::vector<ShaderProgram::Block> ReflectBlocks(GLuint program, GLenum interface)
+{
+  GLint count = 0;
+  glGetProgramInterfaceiv(program, interface, GL_ACTIVE_RESOURCES, &count);
+
+  std::vector<ShaderProgram::Block> blocks(count);
+  for (GLint i = 0; i < count; ++i) {
+    const GLenum properties[] = {GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+    GLint values[std::size(properties)] = {};
+    glGetProgramResourceiv(program, interface, i, std::size(properties), properties, std::size(values), nullptr, values);
+
+    ShaderProgram::Block& block = blocks[i];
+    block.name = ResourceName(program, interface, i, values[0]);
+    block.hash = Fnv1a(block.name);
+    block.index = i;
+    block.binding = values[1];
+    block.data_size = values[2];
+  }
+
+  return blocks;
+}
+
+}  // namespace
+
+std::string_view ShaderStageName(GLenum type)
+{
+  switch (type) {
+  case GL_VERTEX_SHADER: return "vertex";
+  case GL_FRAGMENT_SHADER: return "fragment";
+  case GL_GEOMETRY_SHADER: return "geometry";
+  case GL_TESS_CONTROL_SHADER: return "tessellation control";
+  case GL_TESS_EVALUATION_SHADER: return "tessellation evaluation";
+  case GL_COMPUTE_SHADER: return "compute";
+  default: return "unknown";
+  }
+}
+
+std::string ShaderInfoLog(GLuint shader)
+{
+  GLint length = 0;
+  glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+  std::string log(length > 0 ? length - 1 : 0, '\0');
+  if (length > 0)
+    glGetShaderInfoLog(shader, length, nullptr, log.data());
+  return log;
+}
+
+std::string ProgramInfoLog(GLuint program)
+{
+  GLint length = 0;
+  glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+  std::string log(length > 0 ? length - 1 : 0, '\0');
+  if (length > 0)
+    glGetProgramInfoLog(program, length, nullptr, log.data());
+  return log;
+}
+
+ShaderHandle CompileShader(GLenum type, std::string_view source, const std::source_location& location)
+{
+  const GLchar* data = source.data();
+  const GLint length = static_cast<GLint>(source.size());
+
+  ShaderHandle shader = ShaderHandle::Create(type, location);
+  glShaderSource(shader.Get(), 1, &data, &length);
+  glCompileShader(shader.Get());
+
+  GLint status = GL_FALSE;
+  glGetShaderiv(shader.Get(), GL_COMPILE_STATUS, &status);
+  if (status != GL_TRUE) {
+    std::string log = ShaderInfoLog(shader.Get());
+    throw ShaderCompileFail("Failed to compile " + std::string(ShaderStageName(type)) + " shader:\n" + log);
+  }
+
+  return shader;
+}
+
+ProgramHandle LinkProgram(std::span<const ShaderHandle> shaders, bool retrievable_binary,
+  const std::source_location& location)
+{
+  ProgramHandle program = ProgramHandle::Create(location);
+  if (retrievable_binary)
+    glProgramParameteri(program.Get(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  for (const ShaderHandle& shader : shaders)
+    glAttachShader(program.Get(), shader.Get());
+
+  glLinkProgram(program.Get());
+
+  for (const ShaderHandle& shader : shaders)
+    glDetachShader(program.Get(), shader.Get());
+
+  GLint status = GL_FALSE;
+  glGetProgramiv(program.Get(), GL_LINK_STATUS, &status);
+  if (status != GL_TRUE) {
+    std::string log = ProgramInfoLog(program.Get());
+    throw ProgramLinkFail("Failed to link program:\n" + log);
+  }
+
+  return program;
+}
+
+ShaderProgram::ShaderProgram(std::initializer_list<ShaderStage> stages, const std::source_location& location)
+{
+  std::vector<ShaderHandle> shaders;
+  shaders.reserve(stages.size());
+  for (const ShaderStage& stage : stages)
+    shaders.push_back(CompileShader(stage.type, stage.source, location));
+
+  m_program = LinkProgram(shaders, false, location);
+  Reflect();
+}
+
+ShaderProgram::ShaderProgram(ProgramHandle program)
+ : m_program(std::move(program))
+{
+  Reflect();
+}
+
+ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
+ : m_program(std::move(other.m_program)),
+   m_slots(std::exchange(other.m_slots, std::vector<Slot>(1))),
+   m_mask(std::exchange(other.m_mask, 0)),
+   m_uniforms(std::move(other.m_uniforms)),
+   m_uniform_blocks(std::move(other.m_uniform_blocks)),
+   m_storage_blocks(std::move(other.m_storage_blocks)),
+   m_attributes(std::move(other.m_attributes))
+{}
+
+ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
+{
+  if (this != &other) {
+    m_program = std::move(other.m_program);
+    m_slots = std::exchange(other.m_slots, std::vector<Slot>(1));
+    m_mask = std::exchange(other.m_mask, 0);
+    m_uniforms = std::move(other.m_uniforms);
+    m_uniform_blocks = std::move(other.m_uniform_blocks);
+    m_storage_blocks = std::move(other.m_storage_blocks);
+    m_attributes = std::move(other.m_attributes);
+  }
+  return *this;
+}
+
+void ShaderProgram::Reflect()
+{
+  GLint count = 0;
+  glGetProgramInterfaceiv(m_program.Get(), GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+
+  m_uniforms.clear();
+  m_uniforms.reserve(count);
+  for (GLint i = 0; i < count; ++i) {
+    const GLenum properties[] = {GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE, GL_BLOCK_INDEX};
+    GLint values[std::size(properties)] = {};
+    glGetProgramResourceiv(m_program.Get(), GL_UNIFORM, i, std::size(properties), properties, std::size(values), nullptr, values);
+
+    Uniform& uniform = m_uniforms.emplace_back();
+    uniform.name = ResourceName(m_program.Get(), GL_UNIFORM, i, values[0]);
+    uniform.type = static_cast<GLenum>(values[1]);
+    uniform.location = values[2];
+    uniform.array_size = values[3];
+    uniform.block_index = values[4];
+  }
+
+  // Block members have no location. Arrays are reported as "name[0]" and are
+  // reachable by the bare name too, like glGetUniformLocation allows.
+  size_t entries = 0;
+  for (const Uniform& uniform : m_uniforms)
+    entries += uniform.location < 0 ? 0 : uniform.name.ends_with("[0]") ? 2 : 1;
+
+  const size_t capacity = std::bit_ceil(std::max<size_t>(entries * 2, 8));
+  m_slots.assign(capacity, Slot{});
+  m_mask = static_cast<uint32_t>(capacity - 1);
+
+  for (const Uniform& uniform : m_uniforms) {
+    if (uniform.location < 0)
+      continue;
+
+    Insert(uniform.name, uniform.location);
+    if (uniform.name.ends_with("[0]"))
+      Insert(std::string_view(uniform.name).substr(0, uniform.name.size() - 3), uniform.location);
+  }
+
+  m_uniform_blocks = ReflectBlocks(m_program.Get(), GL_UNIFORM_BLOCK);
+  m_storage_blocks = ReflectBlocks(m_program.Get(), GL_SHADER_STORAGE_BLOCK);
+
+  glGetProgramInterfaceiv(m_program.Get(), GL_PROGRAM_INPUT, GL_ACTIVE_RESOURCES, &count);
+  m_attributes.clear();
+  m_attributes.reserve(count);
+  for (GLint i = 0; i < count; ++i) {
+    const GLenum properties[] = {GL_NAME_LENGTH, GL_TYPE, GL_LOCATION};
+    GLint values[std::size(properties)] = {};
+    glGetProgramResourceiv(m_program.Get(), GL_PROGRAM_INPUT, i, std::size(properties), properties, std::size(values), nullptr, values);
+
+    Attribute& attribute = m_attributes.emplace_back();
+    attribute.name = ResourceName(m_program.Get(), GL_PROGRAM_INPUT, i, values[0]);
+    attribute.hash = Fnv1a(attribute.name);
+    attribute.type = static_cast<GLenum>(values[1]);
+    attribute.location = values[2];
+  }
+}
+
+void ShaderProgram::Insert(std::string_view name, GLint location)
+{
+  const uint32_t hash = Fnv1a(name);
+  for (uint32_t index = hash & m_mask;; index = (index + 1) & m_mask) {
+    Slot& slot = m_slots[index];
+    if (slot.location == kEmptySlot) {
+      slot = {hash, location};
+      return;
+    }
+    // Only hashes are compared on lookup, two names sharing one would alias silently
+    if (slot.hash == hash)
+      throw ReflectionFail("Uniform name hash collision on \"" + std::string(name) + "\"");
+  }
+}
+
+const ShaderProgram::Block* ShaderProgram::FindUniformBlock(HashedName name) const
+{
+  for (const Block& block : m_uniform_blocks) {
+    if (block.hash == name.hash)
+      return &block;
+  }
+  return nullptr;
+}
+
+const ShaderProgram::Block* ShaderProgram::FindStorageBlock(HashedName name) const
+{
+  for (const Block& block : m_storage_blocks) {
+    if (block.hash == name.hash)
+      return &block;
+  }
+  return nullptr;
+}
+
+GLint ShaderProgram::AttributeLocation(HashedName name) const
+{
+  for (const Attribute& attribute : m_attributes) {
+    if (attribute.hash == name.hash)
+      return attribute.location;
+  }
+  return -1;
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,194 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/spirv.hxx"
+
+#include "core/exceptions.hxx"
+#include "gl/extensions.hxx"
+#include "gl/shader-program.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <vector>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+constexpr std::string_view kConstantId = "constant_id";
+constexpr std::string_view kBlank = " \t\r\n";
+
+void SkipBlank(std::string_view source, size_t& position)
+{
+  position = std::min(source.find_first_not_of(kBlank, position), source.size());
+}
+
+bool IsBlank(std::string_view text)
+{
+  return text.find_first_not_of(kBlank) == std::string_view::npos;
+}
+
+bool Expect(std::string_view source, size_t& position, std::string_view token)
+{
+  SkipBlank(source, position);
+  if (source.substr(position, token.size()) != token)
+    return false;
+  position += token.size();
+  return true;
+}
+
+std::string_view Word(std::string_view source, size_t& position)
+{
+  SkipBlank(source, position);
+  const size_t begin = position;
+  while (position < source.size()
+    && (std::isalnum(static_cast<unsigned char>(source[position])) || source[position] == '_'))
+    ++position;
+  return source.substr(begin, position - begin);
+}
+
+// Exact for every bit pattern, uintBitsToFloat of a literal is a constant expression
+std::string FormatValue(std::string_view type, GLuint value)
+{
+  char text[32] = {};
+  if (type == "bool")
+    return value != 0 ? "true" : "false";
+  if (type == "int")
+    std::snprintf(text, sizeof(text), "%d", static_cast<GLint>(value));
+  else if (type == "uint")
+    std::snprintf(text, sizeof(text), "%uu", value);
+  else if (type == "float")
+    std::snprintf(text, sizeof(text), "uintBitsToFloat(0x%08xu)", value);
+  else
+    throw ShaderCompileFail("Specialization constant of unsupported type " + std::string(type));
+  return text;
+}
+
+}  // namespace
+
+bool IsSpirvSupported()
+{
+  return GetSpirvFunctions() != nullptr;
+}
+
+ShaderHandle SpecializeShader(GLenum type, std::span<const uint32_t> module,
+  std::span<const SpecializationConstant> constants, const char* entry_point, const std::source_location& location)
+{
+  const SpirvFunctions* functions = GetSpirvFunctions();
+  if (!functions)
+    throw ShaderCompileFail("SPIR-V shaders are not supported by the driver");
+
+  std::vector<GLuint> ids;
+  std::vector<GLuint> values;
+  ids.reserve(constants.size());
+  values.reserve(constants.size());
+  for (const SpecializationConstant& constant : constants) {
+    ids.push_back(constant.id);
+    values.push_back(constant.value);
+  }
+
+  ShaderHandle shader = ShaderHandle::Create(type, location);
+  const GLuint name = shader.Get();
+  glShaderBinary(1, &name, GL_SHADER_BINARY_FORMAT_SPIR_V, module.data(),
+    static_cast<GLsizei>(module.size_bytes()));
+  functions->SpecializeShader(name, entry_point, static_cast<GLuint>(ids.size()), ids.data(), values.data());
+
+  GLint status = GL_FALSE;
+  glGetShaderiv(name, GL_COMPILE_STATUS, &status);
+  if (status != GL_TRUE) {
+    std::string log = ShaderInfoLog(name);
+    throw ShaderCompileFail("Failed to specialize " + std::string(ShaderStageName(type)) + " shader:\n" + log);
+  }
+
+  return shader;
+}
+
+std::string SpecializeSource(std::string_view source, std::span<const SpecializationConstant> constants)
+{
+  std::string result;
+  result.reserve(source.size());
+
+  size_t copied = 0;
+  size_t search = 0;
+  while ((search = source.find(kConstantId, search)) != std::string_view::npos) {
+    // Back to the opening "layout (" of the qualifier, only blanks in between
+    const size_t open = source.rfind('(', search);
+    const size_t layout = open == std::string_view::npos ? open : source.rfind("layout", open);
+    const size_t id_begin = search;
+    search += kConstantId.size();
+    if (layout == std::string_view::npos || layout < copied
+      || !IsBlank(source.substr(layout + 6, open - layout - 6)) || !IsBlank(source.substr(open + 1, id_begin - open - 1)))
+      continue;
+
+    // layout (constant_id = N) const T NAME = X;
+    size_t position = search;
+    GLuint id = 0;
+    if (!Expect(source, position, "="))
+      continue;
+    SkipBlank(source, position);
+    const auto [id_end, error] = std::from_chars(source.data() + position, source.data() + source.size(), id);
+    if (error != std::errc())
+      continue;
+    position = id_end - source.data();
+    if (!Expect(source, position, ")") || Word(source, position) != "const")
+      continue;
+    const std::string_view type = Word(source, position);
+    const std::string_view name = Word(source, position);
+    if (!Expect(source, position, "="))
+      continue;
+    const size_t end = source.find(';', position);
+    if (end == std::string_view::npos)
+      continue;
+
+    std::string value(source.substr(position, end - position));
+    auto found = std::find_if(constants.begin(), constants.end(),
+      [id](const SpecializationConstant& constant) { return constant.id == id; });
+    if (found != constants.end())
+      value = FormatValue(type, found->value);
+
+    result.append(source.substr(copied, layout - copied));
+    result.append("const ").append(type).append(" ").append(name).append(" = ").append(value).append(";");
+    copied = end + 1;
+    search = copied;
+  }
+
+  result.append(source.substr(copied));
+  return result;
+}
+
+bool UsesSpirv(const EmbeddedShader& shader)
+{
+  return !shader.spirv.empty() && IsSpirvSupported();
+}
+
+ShaderHandle CompileEmbeddedShader(const EmbeddedShader& shader, std::span<const SpecializationConstant> constants,
+  const std::source_location& location)
+{
+  if (UsesSpirv(shader)) {
+    ENGINE_PROFILE_SCOPE("SpecializeShader");
+    return SpecializeShader(shader.type, shader.spirv, constants, "main", location);
+  }
+
+  ENGINE_PROFILE_SCOPE("CompileShader");
+  return CompileShader(shader.type, SpecializeSource(shader.source, constants), location);
+}
+
+}  // namespace engine::gl
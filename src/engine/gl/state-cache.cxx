@@ -0,0 +1,70 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/state-cache.hxx"
+
+namespace engine::gl
+{
+
+void StateCache::Invalidate()
+{
+  m_program = kUnknown;
+  m_vertex_array = kUnknown;
+  m_buffers.fill(kUnknown);
+  for (auto& bindings : m_indexed)
+    bindings.fill(IndexedBinding{});
+  m_textures.fill(kUnknown);
+  m_samplers.fill(kUnknown);
+  m_capabilities.fill(kUnknown);
+  m_depth_func = kUnknown;
+  m_depth_mask = kUnknown;
+  m_blend_func.fill(kUnknown);
+  m_cull_face = kUnknown;
+  m_front_face = kUnknown;
+  m_viewport = {-1, -1, -1, -1};
+}
+
+StateCache::Counter StateCache::Total() const
+{
+  Counter total;
+  for (const Counter& counter : m_counters) {
+    total.issued += counter.issued;
+    total.elided += counter.elided;
+  }
+  return total;
+}
+
+std::string_view StateCache::CallName(Call call)
+{
+  switch (call) {
+  case Call::Program: return "program";
+  case Call::VertexArray: return "vertex array";
+  case Call::Buffer: return "buffer";
+  case Call::IndexedBuffer: return "indexed buffer";
+  case Call::Texture: return "texture";
+  case Call::Sampler: return "sampler";
+  case Call::Capability: return "enable/disable";
+  case Call::DepthFunc: return "depth func";
+  case Call::DepthMask: return "depth mask";
+  case Call::BlendFunc: return "blend func";
+  case Call::CullFace: return "cull face";
+  case Call::FrontFace: return "front face";
+  case Call::Viewport: return "viewport";
+  default: return "unknown";
+  }
+}
+
+}  // namespace engine::gl
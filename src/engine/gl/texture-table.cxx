@@ -0,0 +1,165 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/texture-table.hxx"
+
+#include "core/exceptions.hxx"
+#include "gl/extensions.hxx"
+#include "gl/framebuffer.hxx"
+
+#include <algorithm>
+
+namespace engine::gl
+{
+
+TextureTable::TextureTable(uint32_t capacity, GLenum array_format, GLsizei array_width, GLsizei array_height,
+  bool prefer_bindless, const std::source_location& location)
+ : m_capacity(capacity)
+{
+  if (prefer_bindless && GetBindlessTextureFunctions()) {
+    m_mode = TextureTableMode::Bindless;
+    m_handles.assign(capacity, 0);
+    m_handle_buffer = Buffer(GLsizeiptr(sizeof(GLuint64)) * capacity, m_handles.data(), GL_DYNAMIC_STORAGE_BIT,
+      location);
+  }
+  else {
+    m_mode = TextureTableMode::Array;
+    m_array = Texture(GL_TEXTURE_2D_ARRAY, 0, array_format, array_width, array_height, static_cast<GLsizei>(capacity),
+      location);
+    m_array.SetParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    m_array.SetParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  }
+
+  // Lowest slots first
+  m_used.assign(capacity, false);
+  m_free_slots.resize(capacity);
+  for (uint32_t i = 0; i < capacity; ++i)
+    m_free_slots[i] = capacity - 1 - i;
+}
+
+TextureTable::~TextureTable()
+{
+  if (m_mode != TextureTableMode::Bindless)
+    return;
+
+  const BindlessTextureFunctions* bindless = GetBindlessTextureFunctions();
+  for (GLuint64 handle : m_handles) {
+    if (handle != 0)
+      bindless->MakeTextureHandleNonResident(handle);
+  }
+}
+
+uint32_t TextureTable::AllocateSlot()
+{
+  if (m_free_slots.empty())
+    throw TextureTableFull("Texture table is full: " + std::to_string(m_capacity) + " textures");
+
+  uint32_t slot = m_free_slots.back();
+  m_free_slots.pop_back();
+  m_used[slot] = true;
+  ++m_size;
+  return slot;
+}
+
+uint32_t TextureTable::Add(const Texture& texture)
+{
+  const uint32_t slot = AllocateSlot();
+
+  if (m_mode == TextureTableMode::Bindless) {
+    const BindlessTextureFunctions* bindless = GetBindlessTextureFunctions();
+    GLuint64 handle = bindless->GetTextureHandle(texture.Get());
+    bindless->MakeTextureHandleResident(handle);
+
+    m_handles[slot] = handle;
+    m_handle_buffer.Update(GLintptr(sizeof(GLuint64)) * slot, sizeof(GLuint64), &m_handles[slot]);
+  }
+  else {
+    CopyToLayer(texture, slot);
+    m_mipmaps_dirty = true;
+  }
+
+  return slot;
+}
+
+void TextureTable::Remove(uint32_t index)
+{
+  if (index >= m_capacity || !m_used[index])
+    throw TextureTableSlotFail("Texture table slot " + std::to_string(index) + " is not in use");
+
+  if (m_mode == TextureTableMode::Bindless && m_handles[index] != 0) {
+    GetBindlessTextureFunctions()->MakeTextureHandleNonResident(m_handles[index]);
+    m_handles[index] = 0;
+    m_handle_buffer.Update(GLintptr(sizeof(GLuint64)) * index, sizeof(GLuint64), &m_handles[index]);
+  }
+
+  // An array layer keeps its texels until the slot is reused
+  m_used[index] = false;
+  m_free_slots.push_back(index);
+  --m_size;
+}
+
+void TextureTable::CopyToLayer(const Texture& texture, uint32_t layer)
+{
+  // A blit resizes and converts the format, which glCopyImageSubData cannot
+  Framebuffer source;
+  source.AttachTexture(GL_COLOR_ATTACHMENT0, texture);
+  Framebuffer destination;
+  destination.AttachLayer(GL_COLOR_ATTACHMENT0, m_array, static_cast<GLint>(layer));
+
+  glBlitNamedFramebuffer(source.Get(), destination.Get(), 0, 0, texture.Width(), texture.Height(), 0, 0,
+    m_array.Width(), m_array.Height(), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+}
+
+void TextureTable::Bind(StateCache& state, GLuint slot)
+{
+  if (m_mode == TextureTableMode::Bindless) {
+    state.BindBufferRange(GL_SHADER_STORAGE_BUFFER, slot, m_handle_buffer.Get());
+    return;
+  }
+
+  if (m_mipmaps_dirty) {
+    m_array.GenerateMipmaps();
+    m_mipmaps_dirty = false;
+  }
+  state.BindTextureUnit(slot, m_array.Get());
+}
+
+std::string TextureTable::Glsl(GLuint slot) const
+{
+  if (m_mode == TextureTableMode::Bindless) {
+    return "#extension GL_ARB_bindless_texture : require\n"
+      "layout (std430, binding = " + std::to_string(slot) + ") readonly buffer TextureTable\n"
+      R"({
+  uvec2 texture_handles[];
+};
+
+vec4 SampleTexture(uint index, vec2 uv)
+{
+  return texture(sampler2D(texture_handles[index]), uv);
+}
+)";
+  }
+
+  return "layout (binding = " + std::to_string(slot) + ") uniform sampler2DArray texture_table;\n"
+    R"(
+vec4 SampleTexture(uint index, vec2 uv)
+{
+  return texture(texture_table, vec3(uv, float(index)));
+}
+)";
+}
+
+}  // namespace engine::gl
@@ -0,0 +1,106 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/texture.hxx"
+
+#include <algorithm>
+#include <bit>
+
+namespace engine::gl
+{
+
+namespace
+{
+
+bool IsLayered(GLenum target)
+{
+  return target == GL_TEXTURE_2D_ARRAY || target == GL_TEXTURE_3D || target == GL_TEXTURE_CUBE_MAP_ARRAY;
+}
+
+size_t BytesPerTexel(GLenum internal_format)
+{
+  switch (internal_format) {
+  case GL_R8: return 1;
+  case GL_RG8: case GL_R16F: case GL_DEPTH_COMPONENT16: return 2;
+  case GL_RGB8: case GL_SRGB8: case GL_DEPTH_COMPONENT24: return 3;
+  case GL_RG16F: case GL_R32F: case GL_R11F_G11F_B10F: case GL_DEPTH_COMPONENT32F: case GL_DEPTH24_STENCIL8: return 4;
+  case GL_RGBA16F: case GL_RG32F: return 8;
+  case GL_RGBA32F: return 16;
+  default: return 4;
+  }
+}
+
+}  // namespace
+
+GLsizei Texture::MipLevels(GLsizei width, GLsizei height)
+{
+  return std::bit_width(static_cast<uint32_t>(std::max({width, height, 1})));
+}
+
+Texture::Texture(GLenum target, GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height, GLsizei depth,
+  const std::source_location& location)
+ : m_texture(TextureHandle::Create(target, location)), m_target(target), m_internal_format(internal_format),
+   m_width(width), m_height(height), m_depth(depth), m_levels(levels > 0 ? levels : MipLevels(width, height))
+{
+  if (IsLayered(target))
+    glTextureStorage3D(m_texture.Get(), m_levels, internal_format, width, height, depth);
+  else
+    glTextureStorage2D(m_texture.Get(), m_levels, internal_format, width, height);
+  m_texture.SetBytes(StorageBytes());
+}
+
+size_t Texture::StorageBytes() const
+{
+  size_t texels = 0;
+  for (GLsizei level = 0; level < m_levels; ++level) {
+    size_t slices = !IsLayered(m_target) ? 1 : m_target == GL_TEXTURE_3D ? std::max(m_depth >> level, 1) : m_depth;
+    texels += size_t(std::max(m_width >> level, 1)) * std::max(m_height >> level, 1) * slices;
+  }
+
+  const size_t faces = m_target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+  return texels * faces * BytesPerTexel(m_internal_format);
+}
+
+void Texture::Upload(GLint level, GLint z, GLenum format, GLenum type, const void* pixels)
+{
+  Upload(level, 0, 0, z, std::max(m_width >> level, 1), std::max(m_height >> level, 1), 1, format, type, pixels);
+}
+
+void Texture::Upload(GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth,
+  GLenum format, GLenum type, const void* pixels)
+{
+  if (IsLayered(m_target))
+    glTextureSubImage3D(m_texture.Get(), level, x, y, z, width, height, depth, format, type, pixels);
+  else
+    glTextureSubImage2D(m_texture.Get(), level, x, y, width, height, format, type, pixels);
+}
+
+void Texture::GenerateMipmaps()
+{
+  glGenerateTextureMipmap(m_texture.Get());
+}
+
+void Texture::SetParameter(GLenum name, GLint value)
+{
+  glTextureParameteri(m_texture.Get(), name, value);
+}
+
+void Texture::SetParameter(GLenum name, GLfloat value)
+{
+  glTextureParameterf(m_texture.Get(), name, value);
+}
+
+}  // namespace engine::gl
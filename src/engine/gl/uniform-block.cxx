@@ -0,0 +1,106 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/uniform-block.hxx"
+
+#include "core/exceptions.hxx"
+
+#include <algorithm>
+#include <vector>
+
+namespace engine::gl
+{
+
+void CheckBlockLayout(GLuint program, BlockLayout layout, std::string_view name, std::span<const BlockMember> members,
+  size_t size)
+{
+  const GLenum block_interface = layout == BlockLayout::Std140 ? GL_UNIFORM_BLOCK : GL_SHADER_STORAGE_BLOCK;
+  const GLenum member_interface = layout == BlockLayout::Std140 ? GL_UNIFORM : GL_BUFFER_VARIABLE;
+  const std::string block_name(name);
+
+  const GLuint block = glGetProgramResourceIndex(program, block_interface, block_name.c_str());
+  if (block == GL_INVALID_INDEX)
+    throw ReflectionFail("Block " + block_name + " is not active in the program");
+
+  const GLenum block_properties[] = {GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES};
+  GLint block_values[std::size(block_properties)] = {};
+  glGetProgramResourceiv(program, block_interface, block, std::size(block_properties), block_properties,
+    std::size(block_values), nullptr, block_values);
+
+  std::vector<GLint> variables(block_values[1]);
+  const GLenum active_variables = GL_ACTIVE_VARIABLES;
+  glGetProgramResourceiv(program, block_interface, block, 1, &active_variables, static_cast<GLsizei>(variables.size()),
+    nullptr, variables.data());
+
+  // The block ends after its last member, the C++ struct may pad beyond that
+  size_t end = 0;
+  for (GLint variable : variables) {
+    const GLenum properties[] = {GL_NAME_LENGTH, GL_OFFSET};
+    GLint values[std::size(properties)] = {};
+    glGetProgramResourceiv(program, member_interface, variable, std::size(properties), properties, std::size(values),
+      nullptr, values);
+
+    // "member" or "Block.member", arrays as "member[0]"
+    std::string member(values[0] > 0 ? values[0] - 1 : 0, '\0');
+    glGetProgramResourceName(program, member_interface, variable, values[0], nullptr, member.data());
+    if (size_t dot = member.rfind('.'); dot != std::string::npos)
+      member.erase(0, dot + 1);
+    if (size_t bracket = member.find('['); bracket != std::string::npos)
+      member.resize(bracket);
+
+    auto found = std::find_if(members.begin(), members.end(),
+      [&member](const BlockMember& candidate) { return candidate.name == member; });
+    if (found == members.end())
+      throw ReflectionFail("Block " + block_name + " member " + member + " is not declared in C++");
+    if (found->offset != static_cast<size_t>(values[1]))
+      throw ReflectionFail("Block " + block_name + " member " + member + " is at offset " + std::to_string(values[1])
+        + " in GLSL and " + std::to_string(found->offset) + " in C++");
+    end = std::max(end, found->offset);
+  }
+
+  if (variables.size() != members.size())
+    throw ReflectionFail("Block " + block_name + " has " + std::to_string(variables.size()) + " members in GLSL and "
+      + std::to_string(members.size()) + " in C++");
+
+  const size_t data_size = static_cast<size_t>(block_values[0]);
+  if (data_size <= end || data_size > size)
+    throw ReflectionFail("Block " + block_name + " is " + std::to_string(data_size) + " bytes in GLSL and "
+      + std::to_string(size) + " in C++");
+}
+
+namespace detail
+{
+
+std::string BlockHeader(BlockLayout layout, std::string_view name, GLuint binding)
+{
+  std::string text = layout == BlockLayout::Std140 ? "layout(std140, binding = " : "layout(std430, binding = ";
+  text.append(std::to_string(binding)).append(") ");
+  text.append(layout == BlockLayout::Std140 ? "uniform " : "buffer ");
+  text.append(name).append("\n{\n");
+  return text;
+}
+
+std::string ArrayBlock(std::string_view struct_name, std::string_view array_name, GLuint binding)
+{
+  std::string text = "layout(std430, binding = ";
+  text.append(std::to_string(binding)).append(") readonly buffer ").append(struct_name).append("Array\n{\n");
+  text.append("  ").append(struct_name).append(" ").append(array_name).append("[];\n};\n");
+  return text;
+}
+
+}  // namespace detail
+
+}  // namespace engine::gl
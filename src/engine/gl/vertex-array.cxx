@@ -0,0 +1,57 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "gl/vertex-array.hxx"
+
+
+namespace engine::gl
+{
+
+VertexArray::VertexArray(const std::source_location& location)
+ : m_vertex_array(VertexArrayHandle::Create(location))
+{}
+
+void VertexArray::SetVertexBuffer(GLuint binding, const Buffer& buffer, GLintptr offset, GLsizei stride)
+{
+  glVertexArrayVertexBuffer(m_vertex_array.Get(), binding, buffer.Get(), offset, stride);
+}
+
+void VertexArray::SetElementBuffer(const Buffer& buffer)
+{
+  glVertexArrayElementBuffer(m_vertex_array.Get(), buffer.Get());
+}
+
+void VertexArray::SetBindingDivisor(GLuint binding, GLuint divisor)
+{
+  glVertexArrayBindingDivisor(m_vertex_array.Get(), binding, divisor);
+}
+
+void VertexArray::SetAttribute(GLuint attribute, GLuint binding, GLint size, GLenum type, GLuint relative_offset,
+  bool normalized)
+{
+  glEnableVertexArrayAttrib(m_vertex_array.Get(), attribute);
+  glVertexArrayAttribFormat(m_vertex_array.Get(), attribute, size, type, normalized ? GL_TRUE : GL_FALSE, relative_offset);
+  glVertexArrayAttribBinding(m_vertex_array.Get(), attribute, binding);
+}
+
+void VertexArray::SetIntegerAttribute(GLuint attribute, GLuint binding, GLint size, GLenum type, GLuint relative_offset)
+{
+  glEnableVertexArrayAttrib(m_vertex_array.Get(), attribute);
+  glVertexArrayAttribIFormat(m_vertex_array.Get(), attribute, size, type, relative_offset);
+  glVertexArrayAttribBinding(m_vertex_array.Get(), attribute, binding);
+}
+
+}  // namespace engine::gl
@@ -17,7 +17,13 @@
 #pragma once
 
 #include "core/exceptions.hxx"
+#include "core/input.hxx"
+#include "core/input-recording.hxx"
 #include "core/user-input-handler.hxx"
+#include "gl/command-capture.hxx"
+#include "gl/program-cache.hxx"
+#include "gl/state-cache.hxx"
+#include "memory/frame-arena.hxx"
 
 // Include in this order to prevent GL header & Windows redefenition errors
 #include "common.hxx"
@@ -25,12 +31,34 @@
 #include <GLFW/glfw3.h>
 //
 
+#include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
 
 namespace engine {
 namespace glfw {
 
+class Camera;
+
+struct BenchmarkOptions
+{
+  std::filesystem::path camera_path;
+  // Input recorded with --record-input, fed to the frames instead of live input
+  std::filesystem::path input_replay;
+  ReplayTiming replay_timing = ReplayTiming::Original;
+  // 1000 with a camera path, the whole replay otherwise
+  std::optional<uint32_t> frames;
+  float timestep = 1.f / 60.f;
+  // The window is hidden, frames are rendered all the same
+  bool headless = false;
+  std::filesystem::path output_directory = ".";
+
+  // --benchmark <camera path> and/or --replay-input <recording> [--replay-timing original|fixed]
+  // [--frames N] [--timestep seconds] [--headless] [--benchmark-output directory]
+  static std::optional<BenchmarkOptions> Parse(int argc, char** argv);
+};
 
 class Application
 {
@@ -73,17 +101,70 @@ class Application
 public:
   Application();
   Application(IUserInputHandler& user_input_handler);
+  // Reports GL objects that outlived the derived application as leaks
+  virtual ~Application();
 
   virtual void OnUpdate() = 0;
   virtual void OnRender() = 0;
 
   void Run();
+  // Runs the benchmark when --benchmark or --replay-input is given, the
+  // interactive loop otherwise, with input pumped on its own thread when
+  // --input-thread is given and written to a file with --record-input <file>
+  void Run(int argc, char** argv);
+  // GLFW only delivers events on the main thread, so the main thread is kept
+  // for input and frames run on a render thread with the context current there.
+  // Events are stamped as they arrive instead of once per frame. Frames must
+  // not call main-thread-only GLFW functions: window and framebuffer sizes are
+  // in GetInput() and ImGui is fed through NewImGuiFrame().
+  void RunWithInputThread();
+  // Camera driven by the path or recorded input replayed, frame times written to
+  // the output directory. The delta times are the fixed timestep or, replaying
+  // with original timing, the recorded ones: the same options give the same frames.
+  void RunBenchmark(const BenchmarkOptions& options);
 
   GLFWwindow* GetWindow() { return m_window.Get(); }
+  // Seconds since the previous frame, the fixed timestep while benchmarking
+  float GetDeltaTime() const { return m_delta_time; }
+  // Transient allocations, recycled one frame after the frame that made them
+  memory::FrameArena& GetFrameArena() { return m_frame_arena; }
+  // Binds and fixed function state go through here to skip redundant calls
+  gl::StateCache& GetStateCache() { return m_state_cache; }
+  // Programs linked through here are loaded from binaries stored by earlier launches
+  gl::ProgramCache& GetProgramCache() { return *m_program_cache; }
+  // Keys, buttons and cursor as of this frame
+  const InputState& GetInput() const { return m_input; }
+  // Queues an event for the next frame, only from the main thread, which pumps window events
+  void PostInput(const InputEvent& event);
+
+  // In place of ImGui_ImplGlfw_NewFrame, which queries GLFW: with an input
+  // thread ImGui is fed from this frame's input instead
+  void NewImGuiFrame();
+
+protected:
+  // Camera driven by the benchmark path, if the application has one
+  virtual Camera* GetCamera() { return nullptr; }
 
 private:
+  void Frame();
+  void ProcessInput();
+  void InstallInputCallbacks();
+
   LibraryHandle m_handle;
   Window m_window;
+  IUserInputHandler* m_input_handler = nullptr;
+  InputEventQueue m_input_queue;
+  InputState m_input;
+  std::unique_ptr<InputRecorder> m_input_recorder;
+  // Set while replaying, live events are dropped and these applied instead
+  std::optional<std::span<const InputEvent>> m_replay_events;
+  std::unique_ptr<gl::CommandCapture> m_capture;
+  std::unique_ptr<gl::ProgramCache> m_program_cache;
+  memory::FrameArena m_frame_arena;
+  gl::StateCache m_state_cache;
+  float m_delta_time = 0.f;
+  // Frames run on a render thread, set by RunWithInputThread
+  bool m_input_thread = false;
 };
 
 } // namespace glfw
@@ -0,0 +1,58 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace engine::glfw
+{
+
+struct CameraPose
+{
+  glm::vec3 position = {0.f, 0.f, 0.f};
+  // Degrees, same convention as the mouse driven camera
+  float yaw = 0.f;
+  float pitch = 0.f;
+};
+
+struct CameraKeyframe
+{
+  float time = 0.f;
+  CameraPose pose;
+};
+
+// Keyframed camera path: Catmull-Rom spline through the positions,
+// linear interpolation of yaw and pitch.
+class CameraPath
+{
+public:
+  // Text file, one keyframe per line: time x y z yaw pitch. Lines starting with # are ignored.
+  static CameraPath Load(const std::filesystem::path& path);
+
+  explicit CameraPath(std::vector<CameraKeyframe> keyframes);
+
+  // Clamped to the first and last keyframe outside of the path
+  CameraPose Evaluate(float time) const;
+  float Duration() const { return m_keyframes.back().time; }
+
+private:
+  std::vector<CameraKeyframe> m_keyframes;
+};
+
+}  // namespace engine::glfw
@@ -15,13 +15,12 @@
 *************************************************************************/
 #pragma once
 
+#include "core/camera-path.hxx"
 #include "core/user-input-handler.hxx"
 #include "core/frame-updatable.hxx"
 
 #include <glm/glm.hpp>
 
-#include <mutex>
-
 namespace engine::glfw
 {
 
@@ -31,9 +30,14 @@ class Camera : public IUserInputHandler,
 public:
   glm::mat4 GetViewTransform() const;
   void OnFrame(Application& application, float deltaTime) override;
-  void OnKey(int key, int scancode, int action, int mods) override;
-  void OnMouse(double x, double y) override;
+  void OnInput(const InputState& input) override;
+
+  void SetPose(const CameraPose& pose);
+  // While disabled, keyboard and mouse no longer move the camera
+  void SetInputEnabled(bool enabled) { m_input_enabled = enabled; }
 private:
+  void UpdateOrientation();
+
   struct KeysPressed
   {
     bool w = false;
@@ -44,8 +48,6 @@ private:
   glm::vec3 m_position = {0.f, 0.f, 0.f};
   glm::vec3 m_view = {0.f, 0.f, 1.f};
   float m_speed = 5.f;
-  std::once_flag m_initialized_mouse_position;
-  glm::vec2 m_mouse_pos = {0.f, 0.f};
 
   glm::vec3 u = {1.f, 0.f, 0.f};
   glm::vec3 v = { 0.f, 1.f, 0.f };
@@ -55,6 +57,7 @@ private:
 
   float m_pitch = 0.f;
   float m_yaw = 0.f;
+  bool m_input_enabled = true;
 };
 
 }  // namespace engine::glfw
@@ -41,5 +41,69 @@ class WindowInitFail : public RuntimeError
   using RuntimeError::RuntimeError;
 };
 
+class InputRecordingFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
 } // namespace glfw
+
+namespace gl {
+
+class CaptureFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class ShaderCompileFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class ProgramLinkFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class ReflectionFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class RingBufferOverflow : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class FramebufferIncomplete : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class RenderQueueLimit : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class GeometryPoolFull : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class TextureTableFull : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class TextureTableSlotFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+class ShaderFeatureFail : public RuntimeError
+{
+  using RuntimeError::RuntimeError;
+};
+
+} // namespace gl
 } // namespace engine
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+namespace engine
+{
+
+struct FrameTimeSummary
+{
+  size_t frames = 0;
+  double min_ms = 0.0;
+  double average_ms = 0.0;
+  double p50_ms = 0.0;
+  double p95_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+// Percentiles use the nearest-rank method
+FrameTimeSummary SummarizeFrameTimes(std::vector<double> frame_times_ms);
+
+void PrintFrameTimeSummary(std::ostream& stream, const FrameTimeSummary& summary);
+
+// frame,ms per line
+void WriteFrameTimesCsv(const std::filesystem::path& path, const std::vector<double>& frame_times_ms);
+// statistic,ms per line
+void WriteFrameTimeSummaryCsv(const std::filesystem::path& path, const FrameTimeSummary& summary);
+
+}  // namespace engine
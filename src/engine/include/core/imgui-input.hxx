@@ -0,0 +1,30 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "core/input.hxx"
+
+namespace engine::glfw
+{
+
+// Does what ImGui_ImplGlfw_NewFrame does, but from one frame of input instead of
+// GLFW queries and callbacks, so the frame can run on a thread that does not
+// pump events: display size and scale, delta time, then the frame's key,
+// character, mouse and focus events in arrival order. The mouse cursor shape
+// ImGui asks for is not applied.
+void NewImGuiFrameFromInput(const InputState& input, float delta_time);
+
+}  // namespace engine::glfw
@@ -0,0 +1,104 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "core/input.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace engine::glfw
+{
+
+// Appends every frame's input to a file as it is processed: the frame delta
+// time and the events drained at its start, varint encoded with times relative
+// to the previous event. A file cut short by a crash still loads.
+class InputRecorder
+{
+public:
+  explicit InputRecorder(const std::filesystem::path& path);
+  ~InputRecorder();
+
+  InputRecorder(const InputRecorder&) = delete;
+  InputRecorder& operator=(const InputRecorder&) = delete;
+
+  void WriteFrame(float delta_time, std::span<const InputEvent> events);
+  void Finish();
+
+  uint32_t Frames() const { return m_frames; }
+
+private:
+  void Flush();
+
+  std::ofstream m_stream;
+  std::vector<uint8_t> m_buffer;
+  int64_t m_previous_time_ns = 0;
+  uint32_t m_frames = 0;
+  bool m_finished = false;
+};
+
+// A recording loaded whole, event times relative to the start of the recording
+class InputRecording
+{
+public:
+  struct Frame
+  {
+    float delta_time = 0.f;
+    uint32_t first_event = 0;
+    uint32_t event_count = 0;
+  };
+
+  static InputRecording Load(const std::filesystem::path& path);
+
+  std::span<const Frame> Frames() const { return m_frames; }
+  std::span<const InputEvent> Events() const { return m_events; }
+  std::span<const InputEvent> FrameEvents(size_t frame) const;
+
+private:
+  std::vector<Frame> m_frames;
+  std::vector<InputEvent> m_events;
+};
+
+enum class ReplayTiming
+{
+  // Frames as recorded: the same delta times, the same events in every frame
+  Original,
+  // Events by timestamp into frames of one fixed timestep
+  Fixed,
+};
+
+// Input for every frame of a replay. Both timings only depend on the file and
+// the timestep, with the application on the same delta times every run is the
+// same workload.
+class InputReplay
+{
+public:
+  InputReplay(const InputRecording& recording, ReplayTiming timing, float timestep);
+
+  size_t FrameCount() const { return m_frames.size(); }
+  float DeltaTime(size_t frame) const { return m_frames[frame].delta_time; }
+  std::span<const InputEvent> Events(size_t frame) const;
+
+private:
+  std::vector<InputRecording::Frame> m_frames;
+  std::vector<InputEvent> m_events;
+};
+
+}  // namespace engine::glfw
@@ -0,0 +1,160 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine::glfw
+{
+
+enum class InputEventType : uint8_t
+{
+  Key,
+  Char,
+  MouseButton,
+  CursorPosition,
+  Scroll,
+  CursorEnter,
+  Focus,
+  // Window state, so that frames never have to ask GLFW from another thread
+  WindowSize,
+  FramebufferSize,
+};
+
+// Not user input: applied even while replaying and never part of Events() or a recording
+constexpr bool IsWindowEvent(InputEventType type)
+{
+  return type == InputEventType::WindowSize || type == InputEventType::FramebufferSize;
+}
+
+// One GLFW callback, stamped when it arrived
+struct InputEvent
+{
+  InputEventType type = InputEventType::Key;
+  // GLFW key or mouse button, the codepoint of a Char, 1 or 0 for CursorEnter and Focus
+  int32_t code = 0;
+  int32_t scancode = 0;
+  int32_t action = 0;
+  int32_t mods = 0;
+  // Cursor position, scroll offsets or window size
+  double x = 0.0;
+  double y = 0.0;
+  // steady_clock, nanoseconds
+  int64_t time_ns = 0;
+};
+
+int64_t InputTimestamp();
+
+// Fixed ring of events with one producer, the main thread pumping GLFW events,
+// and one consumer, the frame, which may run on a render thread. Neither side
+// locks, a full ring drops new events.
+class InputEventQueue
+{
+public:
+  // Rounded up to a power of two
+  explicit InputEventQueue(size_t capacity = 4096);
+
+  InputEventQueue(const InputEventQueue&) = delete;
+  InputEventQueue& operator=(const InputEventQueue&) = delete;
+
+  // Producer side, false when the event was dropped
+  bool Push(const InputEvent& event);
+  // Consumer side, false when empty
+  bool Pop(InputEvent& event);
+
+  size_t Capacity() const { return m_events.size(); }
+  uint64_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+  std::vector<InputEvent> m_events;
+  size_t m_mask = 0;
+
+  // Apart so that producer and consumer do not share a cache line
+  alignas(64) std::atomic<size_t> m_write = 0;
+  alignas(64) std::atomic<size_t> m_read = 0;
+  std::atomic<uint64_t> m_dropped = 0;
+};
+
+// Input as of the current frame: what is held, what changed since the previous
+// frame and every event in between. Filled once per frame from the queue, so a
+// 1000 Hz mouse costs one delta per frame instead of one update per event.
+class InputState
+{
+public:
+  // Above GLFW_KEY_LAST and GLFW_MOUSE_BUTTON_LAST
+  static constexpr size_t kKeyCount = 512;
+  static constexpr size_t kButtonCount = 8;
+
+  // Starts a frame: edges, deltas and the event list are cleared, held keys stay
+  void BeginFrame();
+  void Apply(const InputEvent& event);
+
+  bool IsKeyDown(int key) const { return Test(m_keys_down, key); }
+  // Went down or up at least once this frame, both for a tap shorter than a frame
+  bool WasKeyPressed(int key) const { return Test(m_keys_pressed, key); }
+  bool WasKeyReleased(int key) const { return Test(m_keys_released, key); }
+
+  bool IsButtonDown(int button) const { return Test(m_buttons_down, button); }
+  bool WasButtonPressed(int button) const { return Test(m_buttons_pressed, button); }
+  bool WasButtonReleased(int button) const { return Test(m_buttons_released, button); }
+
+  glm::dvec2 CursorPosition() const { return m_cursor; }
+  // Sum of the cursor moves this frame, none for the first position ever seen
+  glm::dvec2 CursorDelta() const { return m_cursor_delta; }
+  glm::dvec2 ScrollDelta() const { return m_scroll_delta; }
+
+  // In screen coordinates and in pixels, as of the last window event
+  glm::ivec2 WindowSize() const { return m_window_size; }
+  glm::ivec2 FramebufferSize() const { return m_framebuffer_size; }
+
+  // This frame's events in arrival order, for consumers that need their timing
+  std::span<const InputEvent> Events() const { return m_events; }
+
+private:
+  template<size_t N>
+  static bool Test(const std::bitset<N>& bits, int index)
+  {
+    return index >= 0 && static_cast<size_t>(index) < N && bits.test(index);
+  }
+
+  template<size_t N>
+  static void Update(std::bitset<N>& down, std::bitset<N>& pressed, std::bitset<N>& released, int index, int action);
+
+  std::bitset<kKeyCount> m_keys_down;
+  std::bitset<kKeyCount> m_keys_pressed;
+  std::bitset<kKeyCount> m_keys_released;
+  std::bitset<kButtonCount> m_buttons_down;
+  std::bitset<kButtonCount> m_buttons_pressed;
+  std::bitset<kButtonCount> m_buttons_released;
+
+  glm::dvec2 m_cursor = glm::dvec2(0.0);
+  glm::dvec2 m_cursor_delta = glm::dvec2(0.0);
+  glm::dvec2 m_scroll_delta = glm::dvec2(0.0);
+  bool m_has_cursor = false;
+  glm::ivec2 m_window_size = glm::ivec2(0);
+  glm::ivec2 m_framebuffer_size = glm::ivec2(0);
+
+  std::vector<InputEvent> m_events;
+};
+
+}  // namespace engine::glfw
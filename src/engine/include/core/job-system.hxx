@@ -0,0 +1,80 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine
+{
+
+// Fixed pool of worker threads for data-parallel loops. ParallelFor() blocks
+// and the calling thread takes ranges too, so a pool without workers runs the
+// loop inline. One loop runs at a time, concurrent callers are serialized.
+class JobSystem
+{
+public:
+  using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+  // One thread less than the hardware has, the caller is the last one
+  static uint32_t DefaultWorkerCount();
+
+  explicit JobSystem(uint32_t workers = DefaultWorkerCount());
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  // Calls function over [0, count) in ranges of at most grain elements, from
+  // any thread in any order. Returns once every range is done. If a range
+  // throws, the ranges not started yet are skipped and the first exception is
+  // rethrown once no thread runs the function any more.
+  void ParallelFor(size_t count, size_t grain, const RangeFunction& function);
+
+  uint32_t WorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+private:
+  void WorkerLoop();
+  void RunRanges();
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_call_mutex;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  // Guarded by m_mutex
+  const RangeFunction* m_function = nullptr;
+  uint64_t m_generation = 0;
+  uint32_t m_active = 0;
+  bool m_stop = false;
+  std::exception_ptr m_error;
+
+  // Valid while m_function is set
+  std::atomic<size_t> m_next = 0;
+  size_t m_count = 0;
+  size_t m_grain = 1;
+};
+
+}  // namespace engine
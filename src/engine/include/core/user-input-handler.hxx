@@ -15,14 +15,16 @@
 *************************************************************************/
 #pragma once
 
+#include "core/input.hxx"
+
 namespace engine::glfw
 {
 
 struct IUserInputHandler
 {
   virtual ~IUserInputHandler() = default;
-  virtual void OnKey(int key, int scancode, int action, int mods) = 0;
-  virtual void OnMouse(double x, double y) = 0;
+  // Once per frame before OnUpdate, with everything received since the previous frame
+  virtual void OnInput(const InputState& input) = 0;
 };
 
 }  // namespace engine::glfw
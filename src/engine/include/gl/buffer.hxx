@@ -0,0 +1,58 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/handle.hxx"
+#include "glad/glad.h"
+
+#include <source_location>
+#include <span>
+
+namespace engine::gl
+{
+
+// Immutable storage created with glNamedBufferStorage. Updates through
+// Update() need GL_DYNAMIC_STORAGE_BIT, nothing is bound to create or fill it.
+class Buffer
+{
+public:
+  Buffer() = default;
+  Buffer(GLsizeiptr size, const void* data, GLbitfield flags = 0,
+    const std::source_location& location = std::source_location::current());
+  template<class T>
+  explicit Buffer(std::span<const T> data, GLbitfield flags = 0,
+    const std::source_location& location = std::source_location::current())
+   : Buffer(data.size_bytes(), data.data(), flags, location)
+  {}
+
+  void Update(GLintptr offset, GLsizeiptr size, const void* data);
+  template<class T>
+  void Update(std::span<const T> data, GLintptr offset = 0) { Update(offset, data.size_bytes(), data.data()); }
+
+  void* Map(GLintptr offset, GLsizeiptr length, GLbitfield access);
+  // For mappings with GL_MAP_FLUSH_EXPLICIT_BIT, offset is relative to the mapped range
+  void FlushMappedRange(GLintptr offset, GLsizeiptr length);
+  void Unmap();
+
+  GLuint Get() const { return m_buffer.Get(); }
+  GLsizeiptr Size() const { return m_size; }
+
+private:
+  BufferHandle m_buffer;
+  GLsizeiptr m_size = 0;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,104 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace engine::gl
+{
+
+// Records GL calls by swapping the glad function pointers, and the extension
+// tables of extensions.hxx, for recording hooks. Only calls made through them
+// are seen: the ImGui backend has its own loader. Object names, uniform
+// locations, fences and bindless handles are remapped on replay, client memory
+// referenced by a call (buffer, texture, shader and uniform data) is stored
+// inline. Writes to mapped buffers are stored when flushed or unmapped, a
+// persistent mapping needs GL_MAP_FLUSH_EXPLICIT_BIT. Program binaries loaded
+// from a cache are stored as they are, only the recording driver replays them.
+// Start the capture before resources are created, otherwise the replay lacks them.
+class CommandCapture
+{
+public:
+  CommandCapture(const std::filesystem::path& path, uint32_t frames);
+  ~CommandCapture();
+
+  CommandCapture(const CommandCapture&) = delete;
+  CommandCapture& operator=(const CommandCapture&) = delete;
+
+  // Calls recorded before the first frame are replayed once as setup
+  void BeginFrame();
+  // The hooks are removed once the requested frame count is reached
+  void EndFrame();
+  bool IsFinished() const { return m_frames >= m_requested_frames; }
+
+private:
+  void Flush();
+  void Finish();
+
+  std::ofstream m_stream;
+  uint32_t m_requested_frames = 0;
+  uint32_t m_frames = 0;
+  bool m_installed = false;
+};
+
+class CommandReplayer
+{
+public:
+  struct CallStats
+  {
+    uint64_t count = 0;
+    double total_ns = 0.0;
+  };
+
+  explicit CommandReplayer(const std::filesystem::path& path);
+  ~CommandReplayer();
+
+  // Everything recorded before the first frame marker: resource creation and uploads
+  void ReplaySetup();
+  // Replays every recorded frame once, on_frame is invoked at each frame marker
+  void ReplayFrames(const std::function<void()>& on_frame = {});
+
+  void SetMeasure(bool measure) { m_measure = measure; }
+  void ResetStats();
+
+  uint32_t FrameCount() const { return m_frame_count; }
+  const std::vector<CallStats>& Stats() const { return m_stats; }
+
+  static size_t CallCount();
+  static std::string_view CallName(size_t call);
+
+private:
+  struct State;
+
+  void Replay(size_t begin, size_t end, const std::function<void()>& on_frame);
+
+  std::unique_ptr<State> m_state;
+  std::vector<uint8_t> m_data;
+  size_t m_frames_offset = 0;
+  uint32_t m_frame_count = 0;
+  bool m_measure = true;
+  std::vector<CallStats> m_stats;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,46 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/shader-program.hxx"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace engine::gl
+{
+
+// GLSL file embedded by embed_shaders() in CMake, preprocessed and minified at
+// build time, so nothing is read or processed at startup. The hash is precomputed
+// from the embedded text and keys the program cache. Complete shaders (with their
+// own #version) of targets embedded with SPIRV also carry the offline compiled
+// module, empty otherwise, see CompileEmbeddedShader().
+struct EmbeddedShader
+{
+  // From the file extension (.vert, .frag, ...), 0 for .glsl snippets
+  GLenum type = 0;
+  std::string_view file_name;
+  std::string_view source;
+  uint64_t hash = 0;
+  std::span<const uint32_t> spirv;
+
+  constexpr operator ShaderStage() const { return {type, source, hash}; }
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,73 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "glad/glad.h"
+
+#include <string_view>
+
+namespace engine::gl
+{
+
+// glad is generated for the 4.6 core profile without extensions, anything
+// beyond it is queried and resolved here through GLFW.
+bool HasExtension(std::string_view name);
+
+// GL_ARB_bindless_texture
+struct BindlessTextureFunctions
+{
+  GLuint64 (APIENTRYP GetTextureHandle)(GLuint texture) = nullptr;
+  void (APIENTRYP MakeTextureHandleResident)(GLuint64 handle) = nullptr;
+  void (APIENTRYP MakeTextureHandleNonResident)(GLuint64 handle) = nullptr;
+};
+
+// Null when the extension is not exposed by the current context
+const BindlessTextureFunctions* GetBindlessTextureFunctions();
+
+// GL_KHR_parallel_shader_compile, or the identical ARB variant
+struct ParallelShaderCompileFunctions
+{
+  // Polled with glGetShaderiv/glGetProgramiv, never blocks
+  static constexpr GLenum kCompletionStatus = 0x91B1;
+  // Lets the driver pick its own thread count
+  static constexpr GLuint kDriverThreads = 0xFFFFFFFF;
+
+  void (APIENTRYP MaxShaderCompilerThreads)(GLuint count) = nullptr;
+};
+
+const ParallelShaderCompileFunctions* GetParallelShaderCompileFunctions();
+
+// GL_ARB_gl_spirv, core in 4.6 but only usable when the driver lists the
+// SPIR-V binary format, some 4.6 drivers do not
+struct SpirvFunctions
+{
+  void (APIENTRYP SpecializeShader)(GLuint shader, const GLchar* entry_point, GLuint count,
+    const GLuint* constant_ids, const GLuint* constant_values) = nullptr;
+};
+
+const SpirvFunctions* GetSpirvFunctions();
+
+namespace detail
+{
+
+// The tables behind the getters, null like them. CommandCapture swaps their
+// entries for recording hooks, the way it swaps the glad pointers.
+BindlessTextureFunctions* BindlessTextureTable();
+SpirvFunctions* SpirvTable();
+
+}  // namespace detail
+
+}  // namespace engine::gl
@@ -0,0 +1,48 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/handle.hxx"
+#include "gl/texture.hxx"
+
+#include "glad/glad.h"
+
+#include <initializer_list>
+#include <source_location>
+
+namespace engine::gl
+{
+
+class Framebuffer
+{
+public:
+  explicit Framebuffer(const std::source_location& location = std::source_location::current());
+
+  void AttachTexture(GLenum attachment, const Texture& texture, GLint level = 0);
+  // A single layer of an array or 3D texture
+  void AttachLayer(GLenum attachment, const Texture& texture, GLint layer, GLint level = 0);
+  void SetDrawBuffers(std::initializer_list<GLenum> attachments);
+
+  // Throws FramebufferIncomplete with the status
+  void Validate() const;
+
+  GLuint Get() const { return m_framebuffer.Get(); }
+
+private:
+  FramebufferHandle m_framebuffer;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,66 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/buffer.hxx"
+#include "gl/render-queue.hxx"
+#include "gl/vertex-array.hxx"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <span>
+
+namespace engine::gl
+{
+
+// Vertices of one format and 32-bit indices of many meshes appended into two
+// shared buffers, so that a single vertex array serves every mesh and draws
+// differ only by their MeshRange. Capacity is fixed at construction.
+class GeometryPool
+{
+public:
+  GeometryPool(GLsizei vertex_stride, uint32_t max_vertices, uint32_t max_indices);
+
+  // Indices are relative to the mesh's own vertices, the range carries the base vertex.
+  // Throws GeometryPoolFull when either buffer would overflow.
+  MeshRange Add(const void* vertices, uint32_t vertex_count, std::span<const uint32_t> indices);
+  template<class Vertex>
+  MeshRange Add(std::span<const Vertex> vertices, std::span<const uint32_t> indices)
+  {
+    return Add(vertices.data(), static_cast<uint32_t>(vertices.size()), indices);
+  }
+
+  // Binds both buffers to the vertex array at the given vertex buffer binding
+  void Attach(VertexArray& vertex_array, GLuint binding = 0) const;
+
+  const Buffer& VertexBuffer() const { return m_vertices; }
+  const Buffer& IndexBuffer() const { return m_indices; }
+  GLsizei VertexStride() const { return m_vertex_stride; }
+  uint32_t VertexCount() const { return m_vertex_count; }
+  uint32_t IndexCount() const { return m_index_count; }
+
+private:
+  Buffer m_vertices;
+  Buffer m_indices;
+  GLsizei m_vertex_stride = 0;
+  uint32_t m_max_vertices = 0;
+  uint32_t m_max_indices = 0;
+  uint32_t m_vertex_count = 0;
+  uint32_t m_index_count = 0;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,238 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine::gl
+{
+
+enum class ObjectKind : uint32_t
+{
+  Buffer,
+  Texture,
+  VertexArray,
+  Framebuffer,
+  Renderbuffer,
+  Sampler,
+  Query,
+  ProgramPipeline,
+  TransformFeedback,
+  Shader,
+  Program,
+  Count,
+};
+
+std::string_view ObjectKindName(ObjectKind kind);
+
+// Every object owned by a Handle while ENGINE_GL_TRACK_OBJECTS is defined
+// (non-Release configurations): where it was created and how much memory
+// its owner reported for it. Whatever is left at shutdown has leaked.
+class ObjectRegistry
+{
+public:
+  struct Entry
+  {
+    ObjectKind kind = ObjectKind::Count;
+    GLuint name = 0;
+    size_t bytes = 0;
+    std::source_location location;
+  };
+
+  static ObjectRegistry& Instance();
+
+  void Track(ObjectKind kind, GLuint name, const std::source_location& location);
+  void Untrack(ObjectKind kind, GLuint name);
+  void SetBytes(ObjectKind kind, GLuint name, size_t bytes);
+
+  std::vector<Entry> Snapshot() const;
+  size_t LiveCount() const;
+  size_t LiveBytes() const;
+
+  // Totals per kind followed by the creation site of every live object
+  void Report(std::ostream& stream) const;
+
+private:
+  static uint64_t Key(ObjectKind kind, GLuint name) { return (uint64_t(kind) << 32) | name; }
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<uint64_t, Entry> m_entries;
+};
+
+namespace detail
+{
+
+template<ObjectKind Kind>
+struct ObjectTraits;
+
+#define ENGINE_GL_CREATE_TRAITS(kind, create, destroy)                   \
+  template<>                                                             \
+  struct ObjectTraits<ObjectKind::kind>                                  \
+  {                                                                      \
+    static GLuint Create() { GLuint name = 0; create(1, &name); return name; } \
+    static void Delete(GLuint name) { destroy(1, &name); }              \
+  }
+
+#define ENGINE_GL_CREATE_TARGET_TRAITS(kind, create, destroy)            \
+  template<>                                                             \
+  struct ObjectTraits<ObjectKind::kind>                                  \
+  {                                                                      \
+    static GLuint Create(GLenum target) { GLuint name = 0; create(target, 1, &name); return name; } \
+    static void Delete(GLuint name) { destroy(1, &name); }              \
+  }
+
+ENGINE_GL_CREATE_TRAITS(Buffer, glCreateBuffers, glDeleteBuffers);
+ENGINE_GL_CREATE_TARGET_TRAITS(Texture, glCreateTextures, glDeleteTextures);
+ENGINE_GL_CREATE_TRAITS(VertexArray, glCreateVertexArrays, glDeleteVertexArrays);
+ENGINE_GL_CREATE_TRAITS(Framebuffer, glCreateFramebuffers, glDeleteFramebuffers);
+ENGINE_GL_CREATE_TRAITS(Renderbuffer, glCreateRenderbuffers, glDeleteRenderbuffers);
+ENGINE_GL_CREATE_TRAITS(Sampler, glCreateSamplers, glDeleteSamplers);
+ENGINE_GL_CREATE_TARGET_TRAITS(Query, glCreateQueries, glDeleteQueries);
+ENGINE_GL_CREATE_TRAITS(ProgramPipeline, glCreateProgramPipelines, glDeleteProgramPipelines);
+ENGINE_GL_CREATE_TRAITS(TransformFeedback, glCreateTransformFeedbacks, glDeleteTransformFeedbacks);
+
+#undef ENGINE_GL_CREATE_TRAITS
+#undef ENGINE_GL_CREATE_TARGET_TRAITS
+
+template<>
+struct ObjectTraits<ObjectKind::Shader>
+{
+  static GLuint Create(GLenum type) { return glCreateShader(type); }
+  static void Delete(GLuint name) { glDeleteShader(name); }
+};
+
+template<>
+struct ObjectTraits<ObjectKind::Program>
+{
+  static GLuint Create() { return glCreateProgram(); }
+  static void Delete(GLuint name) { glDeleteProgram(name); }
+};
+
+}  // namespace detail
+
+// Sole owner of a GL object name, deletes it when destroyed. Create() records
+// the caller as the creation site, so wrappers forward their own caller's
+// location instead of letting it default.
+template<ObjectKind Kind>
+class Handle
+{
+  using Traits = detail::ObjectTraits<Kind>;
+
+public:
+  static constexpr ObjectKind kKind = Kind;
+
+  Handle() = default;
+
+  // Takes ownership of a name created elsewhere
+  explicit Handle(GLuint name, [[maybe_unused]] const std::source_location& location = std::source_location::current())
+   : m_name(name)
+  {
+#ifdef ENGINE_GL_TRACK_OBJECTS
+    if (m_name != 0)
+      ObjectRegistry::Instance().Track(Kind, m_name, location);
+#endif
+  }
+
+  static Handle Create(const std::source_location& location = std::source_location::current())
+  {
+    return Handle(Traits::Create(), location);
+  }
+
+  // Textures and queries take a target, shaders their stage
+  static Handle Create(GLenum target, const std::source_location& location = std::source_location::current())
+  {
+    return Handle(Traits::Create(target), location);
+  }
+
+  ~Handle() { Reset(); }
+
+  Handle(Handle&& other) noexcept
+   : m_name(std::exchange(other.m_name, 0))
+  {}
+
+  Handle& operator=(Handle&& other) noexcept
+  {
+    if (this != &other) {
+      Reset();
+      m_name = std::exchange(other.m_name, 0);
+    }
+    return *this;
+  }
+
+  Handle(const Handle&) = delete;
+  Handle& operator=(const Handle&) = delete;
+
+  GLuint Get() const { return m_name; }
+  explicit operator bool() const { return m_name != 0; }
+
+  void Reset()
+  {
+    if (m_name == 0)
+      return;
+
+#ifdef ENGINE_GL_TRACK_OBJECTS
+    ObjectRegistry::Instance().Untrack(Kind, m_name);
+#endif
+    Traits::Delete(m_name);
+    m_name = 0;
+  }
+
+  // Gives up ownership without deleting the object
+  GLuint Release()
+  {
+#ifdef ENGINE_GL_TRACK_OBJECTS
+    if (m_name != 0)
+      ObjectRegistry::Instance().Untrack(Kind, m_name);
+#endif
+    return std::exchange(m_name, 0);
+  }
+
+  // Memory attributed to the object in the leak report
+  void SetBytes([[maybe_unused]] size_t bytes) const
+  {
+#ifdef ENGINE_GL_TRACK_OBJECTS
+    if (m_name != 0)
+      ObjectRegistry::Instance().SetBytes(Kind, m_name, bytes);
+#endif
+  }
+
+private:
+  GLuint m_name = 0;
+};
+
+using BufferHandle = Handle<ObjectKind::Buffer>;
+using TextureHandle = Handle<ObjectKind::Texture>;
+using VertexArrayHandle = Handle<ObjectKind::VertexArray>;
+using FramebufferHandle = Handle<ObjectKind::Framebuffer>;
+using RenderbufferHandle = Handle<ObjectKind::Renderbuffer>;
+using SamplerHandle = Handle<ObjectKind::Sampler>;
+using QueryHandle = Handle<ObjectKind::Query>;
+using ProgramPipelineHandle = Handle<ObjectKind::ProgramPipeline>;
+using TransformFeedbackHandle = Handle<ObjectKind::TransformFeedback>;
+using ShaderHandle = Handle<ObjectKind::Shader>;
+using ProgramHandle = Handle<ObjectKind::Program>;
+
+}  // namespace engine::gl
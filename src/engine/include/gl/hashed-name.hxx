@@ -0,0 +1,55 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace engine::gl
+{
+
+constexpr uint32_t Fnv1a(std::string_view text)
+{
+  uint32_t hash = 2166136261u;
+  for (char c : text)
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  return hash;
+}
+
+// A GLSL identifier reduced to its FNV-1a hash. String literals convert at
+// compile time, so lookups by name do no string work at run time.
+struct HashedName
+{
+  template<size_t N>
+  consteval HashedName(const char (&name)[N])
+   : hash(Fnv1a(std::string_view(name, N - 1)))
+  {}
+
+  static constexpr HashedName FromRuntime(std::string_view name)
+  {
+    return HashedName(Fnv1a(name));
+  }
+
+  uint32_t hash;
+
+private:
+  explicit constexpr HashedName(uint32_t value)
+   : hash(value)
+  {}
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,99 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/render-queue.hxx"
+#include "gl/ring-buffer.hxx"
+#include "gl/state-cache.hxx"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gl
+{
+
+// Layout glMultiDrawElementsIndirect reads from the draw indirect buffer
+struct DrawElementsIndirectCommand
+{
+  uint32_t count = 0;
+  uint32_t instance_count = 1;
+  uint32_t first_index = 0;
+  int32_t base_vertex = 0;
+  uint32_t base_instance = 0;
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20);
+
+// Objects grouped into batches of one pipeline and material. Every batch is
+// drawn with a single glMultiDrawElementsIndirect: its commands and per-object
+// data are copied into a persistently mapped ring, the object range is bound
+// as a storage buffer and the shader reads objects[gl_DrawID]. Meshes come
+// from a shared GeometryPool whose buffers the pipelines' vertex arrays use;
+// indices are 32-bit.
+class IndirectRenderer
+{
+public:
+  struct Stats
+  {
+    uint32_t objects = 0;
+    uint32_t batches = 0;
+    // glMultiDrawElementsIndirect calls
+    uint32_t draw_calls = 0;
+  };
+
+  // object_size is the array stride of the per-object storage block at object_binding
+  IndirectRenderer(GLsizeiptr object_size, GLuint object_binding, uint32_t max_objects, uint32_t max_batches = 64);
+
+  // Batches are drawn in the order they were added: add translucent ones last
+  uint16_t AddBatch(const Pipeline& pipeline, const Material& material);
+
+  // Waits for the ring region of this frame and drops last frame's objects
+  void BeginFrame();
+
+  void Submit(uint16_t batch, const MeshRange& mesh, const void* object);
+  template<class Object>
+  void Submit(uint16_t batch, const MeshRange& mesh, const Object& object)
+  {
+    Submit(batch, mesh, static_cast<const void*>(&object));
+  }
+
+  void Execute(StateCache& state);
+  // Fences the ring region written by Execute()
+  void EndFrame();
+
+  const Stats& GetStats() const { return m_stats; }
+
+private:
+  struct Batch
+  {
+    Pipeline pipeline;
+    Material material;
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<std::byte> objects;
+  };
+
+  GLsizeiptr m_object_size = 0;
+  GLuint m_object_binding = 0;
+  uint32_t m_max_batches = 0;
+  RingBuffer m_ring;
+  std::vector<Batch> m_batches;
+  Stats m_stats;
+};
+
+}  // namespace engine::gl
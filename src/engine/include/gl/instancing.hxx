@@ -0,0 +1,79 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/buffer.hxx"
+#include "gl/state-cache.hxx"
+#include "gl/vertex-array.hxx"
+
+#include "glad/glad.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <source_location>
+#include <span>
+#include <string>
+
+namespace engine::gl
+{
+
+// Position, uniform scale and unit rotation quaternion (x, y, z, w) of one
+// instance, the same 32 bytes in C++, in the vertex attributes and in std430
+struct Instance
+{
+  glm::vec3 position = glm::vec3(0.f);
+  float scale = 1.f;
+  glm::vec4 rotation = glm::vec4(0.f, 0.f, 0.f, 1.f);
+};
+
+static_assert(sizeof(Instance) == 32);
+
+enum class InstanceFetch
+{
+  // Two vec4 attributes advanced once per instance
+  Attributes,
+  // instances[gl_BaseInstance + gl_InstanceID] from a storage buffer
+  Storage,
+};
+
+// Per-instance data of instanced draws (MeshRange::instance_count), fetched
+// either way from the same buffer
+class InstanceBuffer
+{
+public:
+  explicit InstanceBuffer(uint32_t capacity, const std::source_location& location = std::source_location::current());
+
+  void Update(std::span<const Instance> instances, uint32_t first = 0);
+
+  // position and scale at attribute, rotation at attribute + 1, read from the vertex buffer binding
+  void AttachAttributes(VertexArray& vertex_array, GLuint binding, GLuint attribute) const;
+  void BindStorage(StateCache& state, GLuint binding) const;
+
+  GLuint Get() const { return m_buffer.Get(); }
+  uint32_t Capacity() const { return m_capacity; }
+
+  // Declares the inputs for the fetch mode at slot (first attribute or storage
+  // binding) and the functions Instance LoadInstance(), vec3 RotateByQuaternion(vec3, vec4)
+  // and vec3 InstanceToWorld(Instance, vec3). Paste after the #version line.
+  static std::string Glsl(InstanceFetch fetch, GLuint slot);
+
+private:
+  Buffer m_buffer;
+  uint32_t m_capacity = 0;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,120 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/extensions.hxx"
+#include "gl/handle.hxx"
+#include "gl/program-cache.hxx"
+#include "gl/shader-program.hxx"
+
+#include "glad/glad.h"
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <source_location>
+#include <string>
+#include <vector>
+
+namespace engine::gl
+{
+
+enum class ProgramStatus
+{
+  Pending,
+  Ready,
+  Failed,
+  // Taken by the caller
+  Taken,
+};
+
+// Compiles and links programs without waiting on the driver. Every compile is
+// issued on Submit, Poll moves programs along as GL_COMPLETION_STATUS_KHR
+// reports them done, so startup spreads over the driver's compiler threads and
+// the frame loop keeps running with fallback programs in the meantime.
+//
+// Without GL_KHR_parallel_shader_compile everything still works, but the status
+// queries in Poll block until the driver finishes.
+class ProgramBuilder
+{
+public:
+  using Ticket = uint32_t;
+
+  // With a cache, hits are loaded on Submit and finished programs are stored
+  explicit ProgramBuilder(ProgramCache* cache = nullptr,
+    GLuint compiler_threads = ParallelShaderCompileFunctions::kDriverThreads);
+
+  ProgramBuilder(const ProgramBuilder&) = delete;
+  ProgramBuilder& operator=(const ProgramBuilder&) = delete;
+
+  // The sources are copied, the views need not outlive the call
+  Ticket Submit(std::initializer_list<ShaderStage> stages,
+    const std::source_location& location = std::source_location::current());
+
+  // Never blocks when the extension is available
+  void Poll();
+  // Polls until nothing is pending
+  void Finish();
+
+  ProgramStatus Status(Ticket ticket) const { return m_jobs[ticket].status; }
+  bool IsReady(Ticket ticket) const { return Status(ticket) == ProgramStatus::Ready; }
+  // Compile and link logs of a failed program
+  const std::string& Log(Ticket ticket) const { return m_jobs[ticket].log; }
+  // Submit to ready, frames in between included: what the caller waited, not compile cost
+  double LatencyMs(Ticket ticket) const { return m_jobs[ticket].latency_ms; }
+
+  // Once ready, hands the program over and marks the ticket taken
+  ShaderProgram Take(Ticket ticket);
+
+  uint32_t PendingCount() const { return m_pending; }
+  bool IsParallel() const { return m_parallel; }
+
+private:
+  enum class Step
+  {
+    Compiling,
+    Linking,
+    Done,
+  };
+
+  struct Job
+  {
+    std::vector<GLenum> types;
+    std::vector<std::string> sources;
+    std::vector<uint64_t> hashes;
+    std::vector<ShaderHandle> shaders;
+    ProgramHandle program;
+    std::source_location location;
+    std::chrono::steady_clock::time_point start;
+    double latency_ms = 0.0;
+
+    Step step = Step::Compiling;
+    ProgramStatus status = ProgramStatus::Pending;
+    std::string log;
+  };
+
+  bool IsComplete(GLuint object, bool program) const;
+  void Advance(Job& job);
+  void Fail(Job& job, std::string log);
+  std::vector<ShaderStage> Stages(const Job& job) const;
+
+  ProgramCache* m_cache = nullptr;
+  bool m_parallel = false;
+  std::vector<Job> m_jobs;
+  uint32_t m_pending = 0;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,89 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/shader-program.hxx"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <optional>
+#include <ostream>
+#include <source_location>
+#include <span>
+
+namespace engine::gl
+{
+
+// Linked programs stored as glGetProgramBinary blobs, one file per program.
+// The key hashes every stage type and source (or its build time hash) together
+// with the driver vendor, renderer and version strings, so defines baked into a source select their
+// own entry and a driver update misses instead of loading a stale binary.
+// Binaries the driver rejects are compiled again and replaced.
+class ProgramCache
+{
+public:
+  struct Stats
+  {
+    uint32_t lookups = 0;
+    uint32_t hits = 0;
+    // Present but refused by the driver or unreadable, counted as misses too
+    uint32_t rejected = 0;
+    double compile_ms = 0.0;
+    double load_ms = 0.0;
+    // What the hits took to compile when stored, minus what loading them took
+    double saved_ms = 0.0;
+    // Hits on programs built asynchronously, whose compile cost was not measured
+    uint32_t unmeasured_hits = 0;
+  };
+
+  // Disabled caches, and drivers without binary formats, always compile
+  explicit ProgramCache(std::filesystem::path directory, bool enabled = true);
+
+  // Throws ShaderCompileFail and ProgramLinkFail like the ShaderProgram constructor
+  ShaderProgram Link(std::initializer_list<ShaderStage> stages,
+    const std::source_location& location = std::source_location::current());
+  ShaderProgram Link(std::span<const ShaderStage> stages,
+    const std::source_location& location = std::source_location::current());
+
+  // The two halves of Link for callers that compile themselves, like ProgramBuilder.
+  // Find counts a lookup, Insert stores the binary of a program linked retrievable.
+  // compile_ms is the cost measured synchronously, nullopt when the build ran
+  // alongside frames and only its latency is known.
+  std::optional<ProgramHandle> Find(std::span<const ShaderStage> stages,
+    const std::source_location& location = std::source_location::current());
+  void Insert(std::span<const ShaderStage> stages, GLuint program, std::optional<double> compile_ms);
+
+  bool IsEnabled() const { return m_enabled; }
+  const Stats& GetStats() const { return m_stats; }
+  void Report(std::ostream& stream) const;
+
+private:
+  uint64_t Key(std::span<const ShaderStage> stages) const;
+  std::filesystem::path EntryPath(uint64_t key) const;
+
+  std::optional<ProgramHandle> Load(uint64_t key, const std::source_location& location);
+  void Store(uint64_t key, GLuint program, double compile_ms) const;
+
+  std::filesystem::path m_directory;
+  uint64_t m_driver_hash = 0;
+  bool m_enabled = false;
+  Stats m_stats;
+};
+
+}  // namespace engine::gl
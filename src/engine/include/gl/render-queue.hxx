@@ -0,0 +1,178 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/state-cache.hxx"
+
+#include "glad/glad.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine::gl
+{
+
+// 64-bit draw order, compared as a plain integer. From the top:
+//   layer (4) | translucent (1) | pipeline (11) | material (16) | depth (24) | unused (8)
+// Opaque draws are grouped by state and go front to back within a state, so
+// early-z rejects what is hidden. Translucent draws move the depth right after
+// the translucency bit, inverted, so they blend back to front regardless of state.
+struct SortKey
+{
+  static constexpr uint32_t kLayerBits = 4;
+  static constexpr uint32_t kPipelineBits = 11;
+  static constexpr uint32_t kMaterialBits = 16;
+  static constexpr uint32_t kDepthBits = 24;
+
+  static constexpr uint32_t kMaxLayers = 1u << kLayerBits;
+  static constexpr uint32_t kMaxPipelines = 1u << kPipelineBits;
+  static constexpr uint32_t kMaxMaterials = 1u << kMaterialBits;
+  static constexpr uint32_t kMaxDepth = (1u << kDepthBits) - 1;
+
+  static constexpr uint64_t Opaque(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t depth)
+  {
+    return uint64_t(layer) << 60 | uint64_t(pipeline) << 48 | uint64_t(material) << 32 | uint64_t(depth) << 8;
+  }
+
+  static constexpr uint64_t Translucent(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t depth)
+  {
+    return uint64_t(layer) << 60 | uint64_t(1) << 59 | uint64_t(kMaxDepth - depth) << 35 | uint64_t(pipeline) << 24
+      | uint64_t(material) << 8;
+  }
+
+  // Linear in [near, far], clamped outside
+  static uint32_t QuantizeDepth(float depth, float near, float far);
+};
+
+// Program, vertex input and fixed function state of a draw
+struct Pipeline
+{
+  GLuint program = 0;
+  GLuint vertex_array = 0;
+  GLenum mode = GL_TRIANGLES;
+  // GL_NONE draws arrays, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT the element buffer of the vertex array
+  GLenum index_type = GL_NONE;
+  bool depth_test = true;
+  bool depth_write = true;
+  GLenum depth_func = GL_LESS;
+  // Blended pipelines are translucent
+  bool blend = false;
+  GLenum blend_source = GL_SRC_ALPHA;
+  GLenum blend_destination = GL_ONE_MINUS_SRC_ALPHA;
+  // GL_NONE disables culling
+  GLenum cull_face = GL_NONE;
+};
+
+// Textures bound to units 0..kTextureUnits-1
+struct Material
+{
+  static constexpr uint32_t kTextureUnits = 4;
+
+  std::array<GLuint, kTextureUnits> textures = {};
+};
+
+// Through the cache, so state shared with the previous pipeline or material costs nothing
+void ApplyPipeline(StateCache& state, const Pipeline& pipeline);
+void ApplyMaterial(StateCache& state, const Material& material);
+
+// Vertices, or indices when the pipeline is indexed
+struct MeshRange
+{
+  uint32_t first = 0;
+  uint32_t count = 0;
+  int32_t base_vertex = 0;
+  uint32_t instance_count = 1;
+};
+
+struct DrawPacket
+{
+  uint64_t key = 0;
+  uint16_t pipeline = 0;
+  uint16_t material = 0;
+  // Byte offset of the object's data in the object buffer
+  uint32_t object_offset = 0;
+  MeshRange mesh;
+};
+
+static_assert(sizeof(DrawPacket) == 32);
+
+// Draws submitted in any order during the frame, radix sorted by key and then
+// executed through the StateCache. Pipeline and material state is applied only
+// when it differs from the previous draw; the per-object range is rebound per
+// draw. Pipelines and materials are registered once and referenced by index.
+class RenderQueue
+{
+public:
+  struct Stats
+  {
+    uint32_t draws = 0;
+    uint32_t pipeline_changes = 0;
+    uint32_t material_changes = 0;
+  };
+
+  // Throws RenderQueueLimit past SortKey::kMaxPipelines/kMaxMaterials
+  uint16_t AddPipeline(const Pipeline& pipeline);
+  uint16_t AddMaterial(const Material& material);
+
+  const Pipeline& GetPipeline(uint16_t pipeline) const { return m_pipelines[pipeline]; }
+  const Material& GetMaterial(uint16_t material) const { return m_materials[material]; }
+
+  // View depths passed to Submit() are quantized over this range
+  void SetDepthRange(float near, float far);
+  // Buffer the packets' object_offset points into, bound as a range of size bytes
+  void SetObjectBuffer(GLenum target, GLuint binding, GLuint buffer, GLsizeiptr size);
+
+  // Fills in the key from the packet's pipeline and material, the view depth and the layer
+  void Submit(DrawPacket packet, float depth, uint32_t layer = 0);
+
+  void Sort();
+  // Sorts first if anything was submitted since the last sort
+  void Execute(StateCache& state);
+  // Drops the packets, pipelines and materials stay registered
+  void Clear();
+
+  size_t Size() const { return m_packets.size(); }
+  const DrawPacket& operator[](size_t position) const { return m_packets[m_order[position].index]; }
+  const Stats& GetStats() const { return m_stats; }
+
+private:
+  struct SortEntry
+  {
+    uint64_t key;
+    uint32_t index;
+  };
+
+  std::vector<Pipeline> m_pipelines;
+  std::vector<Material> m_materials;
+
+  std::vector<DrawPacket> m_packets;
+  std::vector<SortEntry> m_order;
+  std::vector<SortEntry> m_scratch;
+  bool m_sorted = true;
+
+  float m_near = 0.f;
+  float m_far = 1.f;
+
+  GLenum m_object_target = GL_UNIFORM_BUFFER;
+  GLuint m_object_binding = 0;
+  GLuint m_object_buffer = 0;
+  GLsizeiptr m_object_size = 0;
+
+  Stats m_stats;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,130 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/buffer.hxx"
+#include "gl/state-cache.hxx"
+#include "gl/uniform-block.hxx"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace engine::gl
+{
+
+// Persistently mapped buffer split into one region per frame in flight. A
+// region is reused only after the fence placed at the end of its frame has
+// signaled, so writes never race the GPU and the driver never has to
+// synchronize or copy. The mapping is not coherent: every allocation is
+// flushed right after it is written, which also tells CommandCapture exactly
+// which bytes to record.
+class RingBuffer
+{
+public:
+  static constexpr uint32_t kFramesInFlight = 3;
+
+  struct Allocation
+  {
+    void* data = nullptr;
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+  };
+
+  struct Stats
+  {
+    uint64_t frames = 0;
+    uint64_t stalls = 0;
+    double stall_ms = 0.0;
+    GLsizeiptr peak_usage = 0;
+  };
+
+  explicit RingBuffer(GLsizeiptr frame_size, uint32_t frames_in_flight = kFramesInFlight);
+  ~RingBuffer();
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  // Waits until the GPU is done with the region of this frame
+  void BeginFrame();
+  // Fences everything submitted since BeginFrame
+  void EndFrame();
+
+  // Vertex, index and indirect data. Throws RingBufferOverflow when the frame
+  // region is exhausted.
+  template<class T>
+  Allocation Push(std::span<const T> values, GLsizeiptr alignment = alignof(T))
+  {
+    Allocation allocation = Allocate(values.size_bytes(), alignment);
+    std::memcpy(allocation.data, values.data(), values.size_bytes());
+    Commit(allocation);
+    return allocation;
+  }
+
+  // Copies the block and binds its range to the block binding point
+  template<class Block>
+  Allocation PushBlock(StateCache& state, const Block& block)
+  {
+    constexpr bool kUniform = Block::kLayout == BlockLayout::Std140;
+    Allocation allocation = Allocate(sizeof(Block), kUniform ? m_uniform_alignment : m_storage_alignment);
+    std::memcpy(allocation.data, &block, sizeof(Block));
+    Commit(allocation);
+    state.BindBufferRange(kUniform ? GL_UNIFORM_BUFFER : GL_SHADER_STORAGE_BUFFER, Block::kBinding, m_buffer.Get(),
+      allocation.offset, sizeof(Block));
+    return allocation;
+  }
+
+  GLuint Get() const { return m_buffer.Get(); }
+  GLsizeiptr FrameSize() const { return m_frame_size; }
+  GLsizeiptr UniformAlignment() const { return m_uniform_alignment; }
+  GLsizeiptr StorageAlignment() const { return m_storage_alignment; }
+  const Stats& GetStats() const { return m_stats; }
+
+private:
+  Allocation Allocate(GLsizeiptr size, GLsizeiptr alignment)
+  {
+    GLsizeiptr begin = (m_head + alignment - 1) / alignment * alignment;
+    if (begin + size > m_frame_size)
+      Overflow(size);
+
+    m_head = begin + size;
+    GLintptr offset = m_region_offset + begin;
+    return {m_data + offset, offset, size};
+  }
+
+  // Makes the written allocation visible to commands issued after it
+  void Commit(const Allocation& allocation) { m_buffer.FlushMappedRange(allocation.offset, allocation.size); }
+
+  [[noreturn]] void Overflow(GLsizeiptr size) const;
+
+  Buffer m_buffer;
+  uint8_t* m_data = nullptr;
+  GLsizeiptr m_frame_size = 0;
+  GLsizeiptr m_uniform_alignment = 256;
+  GLsizeiptr m_storage_alignment = 256;
+
+  std::vector<GLsync> m_fences;
+  uint32_t m_region = 0;
+  GLintptr m_region_offset = 0;
+  GLsizeiptr m_head = 0;
+
+  Stats m_stats;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,76 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/program-cache.hxx"
+#include "gl/shader-program.hxx"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::gl
+{
+
+// One set of sources compiled into a program per combination of features.
+// Sources declare their features with "#pragma feature NAME" lines, which the
+// compiler ignores, and test them with #ifdef NAME. A variant key has bit i set
+// for the i-th declared feature, and compiling it adds "#define NAME 1" after
+// the #version line of every stage, so unused paths are not in the program at all.
+class ShaderPermutations
+{
+public:
+  using Key = uint32_t;
+  static constexpr size_t kMaxFeatures = 32;
+
+  // Variants go through the cache when given one. Throws ShaderFeatureFail
+  // with more than kMaxFeatures features.
+  ShaderPermutations(std::initializer_list<ShaderStage> stages, ProgramCache* cache = nullptr);
+
+  ShaderPermutations(const ShaderPermutations&) = delete;
+  ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+  // Throws ShaderFeatureFail for names that no source declares
+  Key Variant(std::initializer_list<std::string_view> features) const;
+
+  // Compiled and linked on first use, the reference stays valid
+  const ShaderProgram& Get(Key key, const std::source_location& location = std::source_location::current());
+  // Variants known to be needed, compiled now instead of on the first frame that draws them
+  void Precompile(std::span<const Key> keys);
+
+  // Stage sources with the defines of the key inserted
+  std::vector<std::string> Sources(Key key) const;
+
+  const std::vector<std::string>& Features() const { return m_features; }
+  size_t VariantCount() const { return m_variants.size(); }
+
+private:
+  std::vector<GLenum> m_types;
+  std::vector<std::string> m_sources;
+  std::vector<uint64_t> m_hashes;
+  std::vector<std::string> m_features;
+  ProgramCache* m_cache = nullptr;
+  std::unordered_map<Key, ShaderProgram> m_variants;
+};
+
+}  // namespace engine::gl
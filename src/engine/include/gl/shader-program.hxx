@@ -0,0 +1,163 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/handle.hxx"
+#include "gl/hashed-name.hxx"
+#include "gl/state-cache.hxx"
+
+#include "glad/glad.h"
+
+#include <glm/glm.hpp>
+
+#include <initializer_list>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::gl
+{
+
+struct ShaderStage
+{
+  GLenum type;
+  std::string_view source;
+  // Content hash computed at build time for embedded shaders, 0 hashes the source when needed
+  uint64_t hash = 0;
+};
+
+std::string_view ShaderStageName(GLenum type);
+// Empty when the driver has nothing to report
+std::string ShaderInfoLog(GLuint shader);
+std::string ProgramInfoLog(GLuint program);
+
+// Throws ShaderCompileFail with the info log
+ShaderHandle CompileShader(GLenum type, std::string_view source,
+  const std::source_location& location = std::source_location::current());
+// Throws ProgramLinkFail with the info log, the shaders are detached and released by the caller.
+// retrievable_binary hints the driver that glGetProgramBinary will follow.
+ProgramHandle LinkProgram(std::span<const ShaderHandle> shaders, bool retrievable_binary = false,
+  const std::source_location& location = std::source_location::current());
+
+// Linked program with its active interface reflected once after link.
+// Uniform locations live in an open addressing table keyed by HashedName,
+// setters go through glProgramUniform* and need no bound program.
+class ShaderProgram
+{
+public:
+  struct Uniform
+  {
+    std::string name;
+    GLenum type = 0;
+    GLint location = -1;
+    GLint array_size = 1;
+    GLint block_index = -1;
+  };
+
+  struct Block
+  {
+    std::string name;
+    uint32_t hash = 0;
+    GLuint index = 0;
+    GLint binding = 0;
+    GLint data_size = 0;
+  };
+
+  struct Attribute
+  {
+    std::string name;
+    uint32_t hash = 0;
+    GLenum type = 0;
+    GLint location = -1;
+  };
+
+  ShaderProgram() = default;
+  ShaderProgram(std::initializer_list<ShaderStage> stages,
+    const std::source_location& location = std::source_location::current());
+  // Takes ownership of an already linked program
+  explicit ShaderProgram(ProgramHandle program);
+
+  ShaderProgram(ShaderProgram&& other) noexcept;
+  ShaderProgram& operator=(ShaderProgram&& other) noexcept;
+  ShaderProgram(const ShaderProgram&) = delete;
+  ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+  GLuint Get() const { return m_program.Get(); }
+  void Use(StateCache& state) const { state.UseProgram(m_program.Get()); }
+
+  // -1 for names that are not active uniforms, like glGetUniformLocation
+  GLint Location(HashedName name) const
+  {
+    for (uint32_t index = name.hash & m_mask;; index = (index + 1) & m_mask) {
+      const Slot& slot = m_slots[index];
+      if (slot.location == kEmptySlot)
+        return -1;
+      if (slot.hash == name.hash)
+        return slot.location;
+    }
+  }
+
+  void Set(HashedName name, GLint value) const { glProgramUniform1i(m_program.Get(), Location(name), value); }
+  void Set(HashedName name, GLuint value) const { glProgramUniform1ui(m_program.Get(), Location(name), value); }
+  void Set(HashedName name, bool value) const { glProgramUniform1i(m_program.Get(), Location(name), value); }
+  void Set(HashedName name, GLfloat value) const { glProgramUniform1f(m_program.Get(), Location(name), value); }
+  void Set(HashedName name, const glm::vec2& value) const { glProgramUniform2fv(m_program.Get(), Location(name), 1, &value.x); }
+  void Set(HashedName name, const glm::vec3& value) const { glProgramUniform3fv(m_program.Get(), Location(name), 1, &value.x); }
+  void Set(HashedName name, const glm::vec4& value) const { glProgramUniform4fv(m_program.Get(), Location(name), 1, &value.x); }
+  void Set(HashedName name, const glm::mat3& value, bool transpose = false) const
+  {
+    glProgramUniformMatrix3fv(m_program.Get(), Location(name), 1, transpose, &value[0].x);
+  }
+  void Set(HashedName name, const glm::mat4& value, bool transpose = false) const
+  {
+    glProgramUniformMatrix4fv(m_program.Get(), Location(name), 1, transpose, &value[0].x);
+  }
+
+  const std::vector<Uniform>& Uniforms() const { return m_uniforms; }
+  const std::vector<Block>& UniformBlocks() const { return m_uniform_blocks; }
+  const std::vector<Block>& StorageBlocks() const { return m_storage_blocks; }
+  const std::vector<Attribute>& Attributes() const { return m_attributes; }
+
+  const Block* FindUniformBlock(HashedName name) const;
+  const Block* FindStorageBlock(HashedName name) const;
+  GLint AttributeLocation(HashedName name) const;
+
+private:
+  static constexpr GLint kEmptySlot = -0x7fffffff;
+
+  struct Slot
+  {
+    uint32_t hash = 0;
+    GLint location = kEmptySlot;
+  };
+
+  void Reflect();
+  void Insert(std::string_view name, GLint location);
+
+  ProgramHandle m_program;
+
+  std::vector<Slot> m_slots = std::vector<Slot>(1);
+  uint32_t m_mask = 0;
+
+  std::vector<Uniform> m_uniforms;
+  std::vector<Block> m_uniform_blocks;
+  std::vector<Block> m_storage_blocks;
+  std::vector<Attribute> m_attributes;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,69 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/embedded-shader.hxx"
+#include "gl/handle.hxx"
+
+#include "glad/glad.h"
+
+#include <bit>
+#include <cstdint>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace engine::gl
+{
+
+// Value for a `layout (constant_id = N) const T NAME = X;` declaration. bool,
+// int, uint and float constants are passed as their 32-bit pattern.
+struct SpecializationConstant
+{
+  constexpr SpecializationConstant(GLuint id, bool value) : id(id), value(value ? 1u : 0u) {}
+  constexpr SpecializationConstant(GLuint id, GLint value) : id(id), value(static_cast<GLuint>(value)) {}
+  constexpr SpecializationConstant(GLuint id, GLuint value) : id(id), value(value) {}
+  constexpr SpecializationConstant(GLuint id, GLfloat value) : id(id), value(std::bit_cast<GLuint>(value)) {}
+
+  GLuint id = 0;
+  GLuint value = 0;
+};
+
+// True when the driver takes SPIR-V modules, see GetSpirvFunctions()
+bool IsSpirvSupported();
+
+// glShaderBinary + glSpecializeShader, no GLSL front-end involved. Constants not
+// listed keep the default from the module. Throws ShaderCompileFail with the
+// info log when specialization fails.
+ShaderHandle SpecializeShader(GLenum type, std::span<const uint32_t> module,
+  std::span<const SpecializationConstant> constants = {}, const char* entry_point = "main",
+  const std::source_location& location = std::source_location::current());
+
+// Specialization constants only exist in SPIR-V: for the GLSL path every
+// constant_id declaration is rewritten into a plain constant with its value
+std::string SpecializeSource(std::string_view source, std::span<const SpecializationConstant> constants);
+
+// True when CompileEmbeddedShader takes the module: there is one and the
+// driver takes SPIR-V
+bool UsesSpirv(const EmbeddedShader& shader);
+
+// The offline compiled module when UsesSpirv(), the embedded GLSL with the
+// constants substituted otherwise
+ShaderHandle CompileEmbeddedShader(const EmbeddedShader& shader, std::span<const SpecializationConstant> constants = {},
+  const std::source_location& location = std::source_location::current());
+
+}  // namespace engine::gl
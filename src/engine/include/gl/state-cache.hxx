@@ -0,0 +1,279 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "glad/glad.h"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace engine::gl
+{
+
+// Shadow copy of the GL state the engine changes. Setters compare against the
+// cached value and only reach the driver on a change. Everything starts unknown,
+// so the first call always goes through. Code that changes state behind the
+// cache's back must call Invalidate(); the ImGui backend restores what it
+// touches and needs no invalidation.
+class StateCache
+{
+public:
+  enum class Call : uint32_t
+  {
+    Program,
+    VertexArray,
+    Buffer,
+    IndexedBuffer,
+    Texture,
+    Sampler,
+    Capability,
+    DepthFunc,
+    DepthMask,
+    BlendFunc,
+    CullFace,
+    FrontFace,
+    Viewport,
+    Count,
+  };
+
+  struct Counter
+  {
+    uint64_t issued = 0;
+    uint64_t elided = 0;
+  };
+
+  static constexpr uint32_t kTextureUnits = 32;
+  static constexpr uint32_t kIndexedBindings = 16;
+
+  StateCache() { Invalidate(); }
+
+  void Invalidate();
+
+  void UseProgram(GLuint program)
+  {
+    if (Update(Call::Program, m_program, program))
+      glUseProgram(program);
+  }
+
+  void BindVertexArray(GLuint vertex_array)
+  {
+    if (Update(Call::VertexArray, m_vertex_array, vertex_array)) {
+      glBindVertexArray(vertex_array);
+      // The element buffer binding belongs to the vertex array
+      m_buffers[kElementArrayTarget] = kUnknown;
+    }
+  }
+
+  void BindBuffer(GLenum target, GLuint buffer)
+  {
+    int index = BufferTargetIndex(target);
+    if (index < 0)
+      Untracked(Call::Buffer);
+    else if (!Update(Call::Buffer, m_buffers[index], buffer))
+      return;
+
+    glBindBuffer(target, buffer);
+  }
+
+  // Uniform and storage buffer ranges, a zero size binds the whole buffer
+  void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset = 0, GLsizeiptr size = 0)
+  {
+    int slot = IndexedTargetIndex(target);
+    if (slot < 0 || index >= kIndexedBindings)
+      Untracked(Call::IndexedBuffer);
+    else if (!Update(Call::IndexedBuffer, m_indexed[slot][index], IndexedBinding{buffer, offset, size}))
+      return;
+
+    if (size == 0)
+      glBindBufferBase(target, index, buffer);
+    else
+      glBindBufferRange(target, index, buffer, offset, size);
+
+    // Indexed binds replace the generic binding point as well
+    if (int generic = BufferTargetIndex(target); generic >= 0)
+      m_buffers[generic] = buffer;
+  }
+
+  void BindTextureUnit(GLuint unit, GLuint texture)
+  {
+    if (unit >= kTextureUnits)
+      Untracked(Call::Texture);
+    else if (!Update(Call::Texture, m_textures[unit], texture))
+      return;
+
+    glBindTextureUnit(unit, texture);
+  }
+
+  void BindSampler(GLuint unit, GLuint sampler)
+  {
+    if (unit >= kTextureUnits)
+      Untracked(Call::Sampler);
+    else if (!Update(Call::Sampler, m_samplers[unit], sampler))
+      return;
+
+    glBindSampler(unit, sampler);
+  }
+
+  void Enable(GLenum capability) { SetCapability(capability, true); }
+  void Disable(GLenum capability) { SetCapability(capability, false); }
+
+  void DepthFunc(GLenum function)
+  {
+    if (Update(Call::DepthFunc, m_depth_func, function))
+      glDepthFunc(function);
+  }
+
+  void DepthMask(bool write)
+  {
+    if (Update(Call::DepthMask, m_depth_mask, GLuint(write)))
+      glDepthMask(write ? GL_TRUE : GL_FALSE);
+  }
+
+  void BlendFunc(GLenum source, GLenum destination)
+  {
+    if (Update(Call::BlendFunc, m_blend_func, std::array<GLenum, 2>{source, destination}))
+      glBlendFunc(source, destination);
+  }
+
+  void CullFace(GLenum face)
+  {
+    if (Update(Call::CullFace, m_cull_face, face))
+      glCullFace(face);
+  }
+
+  void FrontFace(GLenum orientation)
+  {
+    if (Update(Call::FrontFace, m_front_face, orientation))
+      glFrontFace(orientation);
+  }
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+  {
+    if (Update(Call::Viewport, m_viewport, std::array<GLint, 4>{x, y, width, height}))
+      glViewport(x, y, width, height);
+  }
+
+  const Counter& GetCounter(Call call) const { return m_counters[static_cast<size_t>(call)]; }
+  Counter Total() const;
+  void ResetStats() { m_counters = {}; }
+
+  static std::string_view CallName(Call call);
+
+private:
+  static constexpr GLuint kUnknown = ~0u;
+  static constexpr int kElementArrayTarget = 1;
+
+  struct IndexedBinding
+  {
+    GLuint buffer = kUnknown;
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+
+    bool operator==(const IndexedBinding&) const = default;
+  };
+
+  static int BufferTargetIndex(GLenum target)
+  {
+    switch (target) {
+    case GL_ARRAY_BUFFER: return 0;
+    case GL_ELEMENT_ARRAY_BUFFER: return kElementArrayTarget;
+    case GL_UNIFORM_BUFFER: return 2;
+    case GL_SHADER_STORAGE_BUFFER: return 3;
+    case GL_DRAW_INDIRECT_BUFFER: return 4;
+    case GL_DISPATCH_INDIRECT_BUFFER: return 5;
+    case GL_PIXEL_UNPACK_BUFFER: return 6;
+    case GL_PIXEL_PACK_BUFFER: return 7;
+    case GL_COPY_READ_BUFFER: return 8;
+    case GL_COPY_WRITE_BUFFER: return 9;
+    case GL_PARAMETER_BUFFER: return 10;
+    default: return -1;
+    }
+  }
+  static constexpr size_t kBufferTargets = 11;
+
+  static int IndexedTargetIndex(GLenum target)
+  {
+    switch (target) {
+    case GL_UNIFORM_BUFFER: return 0;
+    case GL_SHADER_STORAGE_BUFFER: return 1;
+    default: return -1;
+    }
+  }
+
+  static int CapabilityIndex(GLenum capability)
+  {
+    switch (capability) {
+    case GL_DEPTH_TEST: return 0;
+    case GL_BLEND: return 1;
+    case GL_CULL_FACE: return 2;
+    case GL_SCISSOR_TEST: return 3;
+    case GL_STENCIL_TEST: return 4;
+    case GL_FRAMEBUFFER_SRGB: return 5;
+    case GL_PROGRAM_POINT_SIZE: return 6;
+    default: return -1;
+    }
+  }
+  static constexpr size_t kCapabilities = 7;
+
+  template<class T>
+  bool Update(Call call, T& cached, const T& value)
+  {
+    Counter& counter = m_counters[static_cast<size_t>(call)];
+    if (cached == value) {
+      ++counter.elided;
+      return false;
+    }
+    cached = value;
+    ++counter.issued;
+    return true;
+  }
+
+  // State outside the shadow copy always reaches the driver
+  void Untracked(Call call) { ++m_counters[static_cast<size_t>(call)].issued; }
+
+  void SetCapability(GLenum capability, bool enabled)
+  {
+    int index = CapabilityIndex(capability);
+    if (index < 0)
+      Untracked(Call::Capability);
+    else if (!Update(Call::Capability, m_capabilities[index], GLuint(enabled)))
+      return;
+
+    if (enabled)
+      glEnable(capability);
+    else
+      glDisable(capability);
+  }
+
+  GLuint m_program;
+  GLuint m_vertex_array;
+  std::array<GLuint, kBufferTargets> m_buffers;
+  std::array<std::array<IndexedBinding, kIndexedBindings>, 2> m_indexed;
+  std::array<GLuint, kTextureUnits> m_textures;
+  std::array<GLuint, kTextureUnits> m_samplers;
+  std::array<GLuint, kCapabilities> m_capabilities;
+  GLenum m_depth_func;
+  GLuint m_depth_mask;
+  std::array<GLenum, 2> m_blend_func;
+  GLenum m_cull_face;
+  GLenum m_front_face;
+  std::array<GLint, 4> m_viewport;
+
+  std::array<Counter, static_cast<size_t>(Call::Count)> m_counters = {};
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,96 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/buffer.hxx"
+#include "gl/state-cache.hxx"
+#include "gl/texture.hxx"
+
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <vector>
+
+namespace engine::gl
+{
+
+enum class TextureTableMode
+{
+  // GL_ARB_bindless_texture handles in a storage buffer, nothing is bound per draw
+  Bindless,
+  // Every texture is copied into a layer of one 2D array bound to a single unit
+  Array,
+};
+
+// Textures addressed by a 32-bit index from shader data (a per-object or
+// per-material field) instead of by texture unit, so that texture changes
+// never split a batch. The index has to be dynamically uniform, which a
+// per-draw value is.
+//
+// Bindless handles are made resident on Add and non-resident on Remove. A
+// texture's sampling parameters are frozen once it is added and it must stay
+// alive until removed, the table does not own it. The array fallback resizes
+// every texture to the layer size and shares one set of sampling parameters.
+class TextureTable
+{
+public:
+  // The layer size and format are only used by the array fallback.
+  // prefer_bindless = false forces the fallback.
+  TextureTable(uint32_t capacity, GLenum array_format, GLsizei array_width, GLsizei array_height,
+    bool prefer_bindless = true, const std::source_location& location = std::source_location::current());
+  ~TextureTable();
+
+  TextureTable(const TextureTable&) = delete;
+  TextureTable& operator=(const TextureTable&) = delete;
+
+  // Throws TextureTableFull when every slot is taken
+  uint32_t Add(const Texture& texture);
+  // Throws TextureTableSlotFail for an index Add did not return or already removed
+  void Remove(uint32_t index);
+
+  // The storage buffer binding or the texture unit at slot, the one Glsl() declares
+  void Bind(StateCache& state, GLuint slot);
+
+  // Declares vec4 SampleTexture(uint index, vec2 uv) for the mode. Paste
+  // directly after the #version line, it may carry an #extension directive.
+  std::string Glsl(GLuint slot) const;
+
+  TextureTableMode Mode() const { return m_mode; }
+  uint32_t Size() const { return m_size; }
+  uint32_t Capacity() const { return m_capacity; }
+
+private:
+  uint32_t AllocateSlot();
+  void CopyToLayer(const Texture& texture, uint32_t layer);
+
+  TextureTableMode m_mode = TextureTableMode::Array;
+  uint32_t m_capacity = 0;
+  uint32_t m_size = 0;
+  std::vector<uint32_t> m_free_slots;
+  std::vector<bool> m_used;
+
+  // Bindless
+  Buffer m_handle_buffer;
+  std::vector<GLuint64> m_handles;
+
+  // Array fallback, mipmaps are regenerated on the next Bind after an Add
+  Texture m_array;
+  bool m_mipmaps_dirty = false;
+};
+
+}  // namespace engine::gl
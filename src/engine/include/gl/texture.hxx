@@ -0,0 +1,69 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/handle.hxx"
+#include "glad/glad.h"
+
+#include <cstdint>
+#include <source_location>
+
+namespace engine::gl
+{
+
+// Immutable storage texture created with glCreateTextures/glTextureStorage*.
+// 2D targets ignore the depth, array and 3D targets use it as layers/slices.
+class Texture
+{
+public:
+  // Full mip chain for the size, what a levels value of 0 requests
+  static GLsizei MipLevels(GLsizei width, GLsizei height);
+
+  Texture() = default;
+  Texture(GLenum target, GLsizei levels, GLenum internal_format, GLsizei width, GLsizei height, GLsizei depth = 1,
+    const std::source_location& location = std::source_location::current());
+
+  // Whole level for 2D targets, a single layer/slice z for array and 3D targets
+  void Upload(GLint level, GLint z, GLenum format, GLenum type, const void* pixels);
+  void Upload(GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth,
+    GLenum format, GLenum type, const void* pixels);
+  void GenerateMipmaps();
+
+  void SetParameter(GLenum name, GLint value);
+  void SetParameter(GLenum name, GLfloat value);
+
+  GLuint Get() const { return m_texture.Get(); }
+  GLenum Target() const { return m_target; }
+  GLenum InternalFormat() const { return m_internal_format; }
+  GLsizei Width() const { return m_width; }
+  GLsizei Height() const { return m_height; }
+  GLsizei Depth() const { return m_depth; }
+  GLsizei Levels() const { return m_levels; }
+
+private:
+  // Estimate for the leak report, compressed formats are not accounted for
+  size_t StorageBytes() const;
+
+  TextureHandle m_texture;
+  GLenum m_target = 0;
+  GLenum m_internal_format = 0;
+  GLsizei m_width = 0;
+  GLsizei m_height = 0;
+  GLsizei m_depth = 0;
+  GLsizei m_levels = 0;
+};
+
+}  // namespace engine::gl
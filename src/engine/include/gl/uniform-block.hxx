@@ -0,0 +1,246 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/buffer.hxx"
+#include "gl/state-cache.hxx"
+
+#include "glad/glad.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace engine::gl
+{
+
+enum class BlockLayout
+{
+  Std140,
+  Std430,
+};
+
+// GLSL types allowed in a block. glm::mat3 and bool are left out on purpose:
+// their std140/std430 layouts differ from the C++ ones.
+template<class T>
+struct BlockType;
+
+template<class T, size_t Alignment>
+struct BlockTypeInfo
+{
+  static constexpr size_t kAlignment = Alignment;
+  static constexpr size_t kSize = sizeof(T);
+  static constexpr size_t kArraySize = 0;
+};
+
+template<> struct BlockType<float> : BlockTypeInfo<float, 4> { static constexpr std::string_view kGlsl = "float"; };
+template<> struct BlockType<int32_t> : BlockTypeInfo<int32_t, 4> { static constexpr std::string_view kGlsl = "int"; };
+template<> struct BlockType<uint32_t> : BlockTypeInfo<uint32_t, 4> { static constexpr std::string_view kGlsl = "uint"; };
+template<> struct BlockType<glm::vec2> : BlockTypeInfo<glm::vec2, 8> { static constexpr std::string_view kGlsl = "vec2"; };
+template<> struct BlockType<glm::vec3> : BlockTypeInfo<glm::vec3, 16> { static constexpr std::string_view kGlsl = "vec3"; };
+template<> struct BlockType<glm::vec4> : BlockTypeInfo<glm::vec4, 16> { static constexpr std::string_view kGlsl = "vec4"; };
+template<> struct BlockType<glm::ivec2> : BlockTypeInfo<glm::ivec2, 8> { static constexpr std::string_view kGlsl = "ivec2"; };
+template<> struct BlockType<glm::ivec4> : BlockTypeInfo<glm::ivec4, 16> { static constexpr std::string_view kGlsl = "ivec4"; };
+template<> struct BlockType<glm::uvec2> : BlockTypeInfo<glm::uvec2, 8> { static constexpr std::string_view kGlsl = "uvec2"; };
+template<> struct BlockType<glm::uvec4> : BlockTypeInfo<glm::uvec4, 16> { static constexpr std::string_view kGlsl = "uvec4"; };
+template<> struct BlockType<glm::mat4> : BlockTypeInfo<glm::mat4, 16> { static constexpr std::string_view kGlsl = "mat4"; };
+
+template<class T, size_t N>
+struct BlockType<std::array<T, N>>
+{
+  static constexpr std::string_view kGlsl = BlockType<T>::kGlsl;
+  static constexpr size_t kAlignment = BlockType<T>::kAlignment;
+  static constexpr size_t kArraySize = N;
+};
+
+constexpr size_t AlignUp(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// std140 rounds array and struct alignment up to a vec4, std430 does not
+template<BlockLayout Layout, class T>
+constexpr size_t kBlockAlignment = Layout == BlockLayout::Std140 && BlockType<T>::kArraySize != 0
+  ? AlignUp(BlockType<T>::kAlignment, 16)
+  : BlockType<T>::kAlignment;
+
+template<BlockLayout Layout, class T>
+constexpr size_t BlockSize()
+{
+  if constexpr (BlockType<T>::kArraySize == 0)
+    return BlockType<T>::kSize;
+  else
+    return BlockType<T>::kArraySize * AlignUp(sizeof(typename T::value_type), kBlockAlignment<Layout, T>);
+}
+
+// A C++ member of a block, as CheckBlockLayout compares it with the linked program
+struct BlockMember
+{
+  std::string_view name;
+  size_t offset = 0;
+};
+
+// Throws ReflectionFail unless the block of the linked program has exactly the
+// given members at the given offsets and a data size that fits size. For GLSL
+// that does not come from Glsl(), e.g. stages written out for offline SPIR-V.
+void CheckBlockLayout(GLuint program, BlockLayout layout, std::string_view name, std::span<const BlockMember> members,
+  size_t size);
+
+template<class Block>
+void CheckBlockLayout(GLuint program)
+{
+  CheckBlockLayout(program, Block::kLayout, Block::kName, Block::Members(), sizeof(Block));
+}
+
+namespace detail
+{
+
+// Advances the expected GLSL offset past a member, false if C++ placed it elsewhere
+template<BlockLayout Layout, class T>
+constexpr bool CheckMember(size_t& offset, size_t actual)
+{
+  const size_t expected = AlignUp(offset, kBlockAlignment<Layout, T>);
+  offset = expected + BlockSize<Layout, T>();
+  return actual == expected;
+}
+
+template<class T>
+void AppendMember(std::string& text, std::string_view name)
+{
+  text.append("  ").append(BlockType<T>::kGlsl).append(" ").append(name);
+  if constexpr (BlockType<T>::kArraySize != 0)
+    text.append("[").append(std::to_string(BlockType<T>::kArraySize)).append("]");
+  text.append(";\n");
+}
+
+std::string BlockHeader(BlockLayout layout, std::string_view name, GLuint binding);
+std::string ArrayBlock(std::string_view struct_name, std::string_view array_name, GLuint binding);
+
+}  // namespace detail
+
+#define ENGINE_GL_BLOCK_MEMBER(type, name) alignas(::engine::gl::kBlockAlignment<kLayout, type>) type name{};
+#define ENGINE_GL_BLOCK_CHECK(type, name) && ::engine::gl::detail::CheckMember<kLayout, type>(offset, offsetof(Self, name))
+#define ENGINE_GL_BLOCK_GLSL(type, name) ::engine::gl::detail::AppendMember<type>(text, #name);
+#define ENGINE_GL_BLOCK_DESCRIBE(type, name) ::engine::gl::BlockMember{#name, offsetof(Self, name)},
+
+#define ENGINE_GL_DECLARE_BLOCK(block_name, layout, binding, members)                   \
+  struct block_name                                                                    \
+  {                                                                                    \
+    using Self = block_name;                                                           \
+    static constexpr ::engine::gl::BlockLayout kLayout = layout;                       \
+    static constexpr GLuint kBinding = binding;                                        \
+    static constexpr std::string_view kName = #block_name;                             \
+                                                                                       \
+    members(ENGINE_GL_BLOCK_MEMBER)                                                    \
+                                                                                       \
+    static constexpr bool CheckLayout()                                                \
+    {                                                                                  \
+      size_t offset = 0;                                                               \
+      return true members(ENGINE_GL_BLOCK_CHECK) && offset <= sizeof(Self);            \
+    }                                                                                  \
+                                                                                       \
+    static std::span<const ::engine::gl::BlockMember> Members()                        \
+    {                                                                                  \
+      static const ::engine::gl::BlockMember kMembers[] = {members(ENGINE_GL_BLOCK_DESCRIBE)}; \
+      return kMembers;                                                                 \
+    }                                                                                  \
+                                                                                       \
+    static std::string Glsl()                                                          \
+    {                                                                                  \
+      std::string text = ::engine::gl::detail::BlockHeader(kLayout, #block_name, kBinding); \
+      members(ENGINE_GL_BLOCK_GLSL)                                                    \
+      text += "};\n";                                                                  \
+      return text;                                                                     \
+    }                                                                                  \
+  }
+
+// Declares a C++ struct and the matching GLSL interface block from one member
+// list X(type, name). The struct layout is checked against the GLSL rules at
+// compile time and Glsl() returns the block text to paste into a shader.
+// Types containing commas need an alias, e.g. using Lights = std::array<glm::vec4, 8>.
+#define ENGINE_GL_UNIFORM_BLOCK(block_name, binding, members)                             \
+  ENGINE_GL_DECLARE_BLOCK(block_name, ::engine::gl::BlockLayout::Std140, binding, members); \
+  static_assert(block_name::CheckLayout(), #block_name " does not match the std140 layout")
+
+#define ENGINE_GL_STORAGE_BLOCK(block_name, binding, members)                             \
+  ENGINE_GL_DECLARE_BLOCK(block_name, ::engine::gl::BlockLayout::Std430, binding, members); \
+  static_assert(block_name::CheckLayout(), #block_name " does not match the std430 layout")
+
+// Element of a std430 storage buffer read as an unsized array, array_name[i] in
+// GLSL. Glsl() declares the struct and the buffer block holding the array; the
+// C++ struct size is the GLSL array stride, so elements are written back to back.
+#define ENGINE_GL_STORAGE_ARRAY(struct_name, array_name, binding, members)               \
+  struct struct_name                                                                   \
+  {                                                                                    \
+    using Self = struct_name;                                                          \
+    static constexpr ::engine::gl::BlockLayout kLayout = ::engine::gl::BlockLayout::Std430; \
+    static constexpr GLuint kBinding = binding;                                        \
+                                                                                       \
+    members(ENGINE_GL_BLOCK_MEMBER)                                                    \
+                                                                                       \
+    static constexpr bool CheckLayout()                                                \
+    {                                                                                  \
+      size_t offset = 0;                                                               \
+      return true members(ENGINE_GL_BLOCK_CHECK) && offset <= sizeof(Self);            \
+    }                                                                                  \
+                                                                                       \
+    static std::string Glsl()                                                          \
+    {                                                                                  \
+      std::string text = "struct " #struct_name "\n{\n";                               \
+      members(ENGINE_GL_BLOCK_GLSL)                                                    \
+      text += "};\n";                                                                  \
+      return text + ::engine::gl::detail::ArrayBlock(#struct_name, #array_name, kBinding); \
+    }                                                                                  \
+  };                                                                                   \
+  static_assert(struct_name::CheckLayout(), #struct_name " does not match the std430 layout")
+
+// Immutable buffer bound to the block binding point, written as a whole
+class RawBlockBuffer
+{
+public:
+  RawBlockBuffer(GLenum target, GLuint binding, GLsizeiptr size)
+   : m_buffer(size, nullptr, GL_DYNAMIC_STORAGE_BIT), m_target(target), m_binding(binding)
+  {}
+
+  GLuint Get() const { return m_buffer.Get(); }
+  void Bind(StateCache& state) const { state.BindBufferRange(m_target, m_binding, m_buffer.Get()); }
+  void Update(const void* data, GLsizeiptr size) { m_buffer.Update(0, size, data); }
+
+private:
+  Buffer m_buffer;
+  GLenum m_target = 0;
+  GLuint m_binding = 0;
+};
+
+template<class Block>
+class BlockBuffer : public RawBlockBuffer
+{
+public:
+  BlockBuffer()
+   : RawBlockBuffer(Block::kLayout == BlockLayout::Std140 ? GL_UNIFORM_BUFFER : GL_SHADER_STORAGE_BUFFER,
+       Block::kBinding, sizeof(Block))
+  {}
+
+  // One write per block instead of a glUniform* call per member
+  void Update(const Block& block) { RawBlockBuffer::Update(&block, sizeof(Block)); }
+};
+
+}  // namespace engine::gl
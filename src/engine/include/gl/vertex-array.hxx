@@ -0,0 +1,51 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/buffer.hxx"
+#include "gl/handle.hxx"
+
+#include "glad/glad.h"
+
+#include <source_location>
+
+namespace engine::gl
+{
+
+// Vertex format and buffer bindings recorded with the DSA vertex array calls.
+// Attributes read from a binding index, buffers are attached to binding indices.
+class VertexArray
+{
+public:
+  explicit VertexArray(const std::source_location& location = std::source_location::current());
+
+  void SetVertexBuffer(GLuint binding, const Buffer& buffer, GLintptr offset, GLsizei stride);
+  void SetElementBuffer(const Buffer& buffer);
+  // Advance the binding once per divisor instances instead of per vertex
+  void SetBindingDivisor(GLuint binding, GLuint divisor);
+
+  void SetAttribute(GLuint attribute, GLuint binding, GLint size, GLenum type, GLuint relative_offset,
+    bool normalized = false);
+  // Integer inputs in the shader (ivec/uvec), no conversion to float
+  void SetIntegerAttribute(GLuint attribute, GLuint binding, GLint size, GLenum type, GLuint relative_offset);
+
+  GLuint Get() const { return m_vertex_array.Get(); }
+
+private:
+  VertexArrayHandle m_vertex_array;
+};
+
+}  // namespace engine::gl
@@ -0,0 +1,69 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_MATH_SSE 1
+#endif
+
+// AVX2 kernels are built into every x86 binary and only reached after the
+// runtime check, GCC and Clang need the target attribute on those functions
+#ifdef ENGINE_MATH_SSE
+#define ENGINE_MATH_AVX2 1
+#if defined(__GNUC__) || defined(__clang__)
+#define ENGINE_MATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define ENGINE_MATH_TARGET_AVX2
+#endif
+#endif
+
+namespace engine::math
+{
+
+enum class SimdLevel : uint32_t
+{
+  Scalar,
+  Sse2,
+  // AVX2 with FMA
+  Avx2,
+};
+
+struct CpuFeatures
+{
+  bool sse2 = false;
+  bool sse41 = false;
+  bool avx = false;
+  bool avx2 = false;
+  bool fma = false;
+  // The OS saves the YMM registers on context switches, required for any AVX use
+  bool os_avx = false;
+};
+
+// Read once with cpuid
+const CpuFeatures& GetCpuFeatures();
+// Widest level both the build and the CPU support
+SimdLevel SupportedSimdLevel();
+
+// Level the batch kernels dispatch to, the supported one unless lowered, e.g.
+// by benchmarks comparing the paths. Clamped to the supported level.
+SimdLevel GetSimdLevel();
+void SetSimdLevel(SimdLevel level);
+
+const char* SimdLevelName(SimdLevel level);
+
+}  // namespace engine::math
@@ -0,0 +1,83 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "math/frustum.hxx"
+#include "math/soa.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine
+{
+class JobSystem;
+}
+
+namespace engine::math
+{
+
+struct CullStats
+{
+  uint32_t tested = 0;
+  uint32_t visible = 0;
+  uint32_t chunks = 0;
+};
+
+// Bounds of every object in SoA, tested against a frustum in SIMD batches.
+// With a job system the batches are split across its threads. Objects are
+// referred to by the index Add() returned.
+class FrustumCuller
+{
+public:
+  // Objects per job, a few L1-sized batches of bounds
+  static constexpr size_t kDefaultGrain = 16 * 1024;
+
+  explicit FrustumCuller(JobSystem* jobs = nullptr, size_t grain = kDefaultGrain);
+
+  uint32_t Add(const glm::vec3& center, float radius, const glm::vec3& extent);
+  void Set(uint32_t index, const glm::vec3& center, float radius, const glm::vec3& extent);
+  void Reserve(size_t count);
+  void Clear();
+  size_t Size() const { return m_radii.size(); }
+
+  // Indices of the objects intersecting the frustum in ascending order, valid
+  // until the next call
+  std::span<const uint32_t> Cull(const Frustum& frustum);
+
+  void SetJobSystem(JobSystem* jobs) { m_jobs = jobs; }
+  const CullStats& Stats() const { return m_stats; }
+
+private:
+  ConstBoundsSpan Bounds() const;
+
+  JobSystem* m_jobs = nullptr;
+  size_t m_grain = kDefaultGrain;
+
+  Vec3Soa m_centers;
+  Vec3Soa m_extents;
+  std::vector<float> m_radii;
+
+  // Every chunk writes its indices at its own offset, then they are packed
+  std::vector<uint32_t> m_visible;
+  std::vector<uint32_t> m_chunk_counts;
+  CullStats m_stats;
+};
+
+}  // namespace engine::math
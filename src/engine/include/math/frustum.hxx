@@ -0,0 +1,78 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "math/soa.hxx"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace engine::math
+{
+
+// Six planes (a, b, c, d) with unit normals pointing inside: a point p is
+// inside a plane when dot(plane.xyz, p) + plane.w >= 0
+struct Frustum
+{
+  enum Plane
+  {
+    kLeft,
+    kRight,
+    kBottom,
+    kTop,
+    kNear,
+    kFar,
+    kPlaneCount,
+  };
+
+  std::array<glm::vec4, kPlaneCount> planes = {};
+
+  // Gribb-Hartmann: planes are sums and differences of the rows of the matrix,
+  // clip space is -w <= x, y, z <= w. With a view-projection matrix the planes
+  // are in world space, with a world-view-projection in object space.
+  static Frustum FromViewProjection(const glm::mat4& view_projection);
+
+  bool IntersectsSphere(const glm::vec3& center, float radius) const;
+  bool IntersectsAabb(const glm::vec3& center, const glm::vec3& extent) const;
+};
+
+// Bounds of many objects in SoA: a sphere and an axis-aligned box sharing one
+// center. An object is visible only if both intersect the frustum. The tests
+// are conservative, boxes near a frustum corner may pass.
+struct ConstBoundsSpan
+{
+  ConstVec3Span centers;
+  const float* radii = nullptr;
+  ConstVec3Span extents;
+
+  size_t Size() const { return centers.size; }
+  ConstBoundsSpan Subspan(size_t offset, size_t count) const
+  {
+    return {centers.Subspan(offset, count), radii + offset, extents.Subspan(offset, count)};
+  }
+};
+
+// Writes first_index + i of every visible object to visible in ascending order
+// and returns their count. visible holds at least bounds.Size() indices, the
+// SIMD paths write past the count up to that size. Dispatches to GetSimdLevel(),
+// objects touching a plane may be classified differently by the FMA path.
+size_t CullBounds(const Frustum& frustum, ConstBoundsSpan bounds, uint32_t first_index, std::span<uint32_t> visible);
+
+}  // namespace engine::math
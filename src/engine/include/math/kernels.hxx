@@ -0,0 +1,59 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "math/soa.hxx"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <span>
+
+namespace engine::math
+{
+
+// Batch kernels over glm types (column-major, quaternions stored x, y, z, w).
+// Every call dispatches to GetSimdLevel(): scalar, SSE2 or AVX2 with FMA.
+// Input and output spans have the same size, SoA outputs must not alias
+// inputs of another component.
+
+// out[i] = a * b[i]
+void MultiplyMatrices(const glm::mat4& a, std::span<const glm::mat4> b, std::span<glm::mat4> out);
+
+// out[i] = m * in[i]
+void TransformVectors(const glm::mat4& m, std::span<const glm::vec4> in, std::span<glm::vec4> out);
+
+// Points with w = 1, the projective row of m is ignored
+void TransformPoints(const glm::mat4& m, ConstVec3Span in, Vec3Span out);
+
+// Rotation matrix of a unit quaternion
+glm::mat4 QuaternionToMatrix(const glm::quat& q);
+void QuaternionsToMatrices(std::span<const glm::quat> in, std::span<glm::mat4> out);
+
+// Axis-aligned box as center and half extent
+struct Aabb
+{
+  glm::vec3 center = glm::vec3(0.f);
+  glm::vec3 extent = glm::vec3(0.f);
+};
+
+// Smallest box around the transformed box (Arvo): the center is transformed
+// as a point, the extent by the absolute 3x3 of m
+Aabb TransformAabb(const glm::mat4& m, const Aabb& box);
+void TransformAabbs(const glm::mat4& m, ConstVec3Span centers, ConstVec3Span extents,
+  Vec3Span out_centers, Vec3Span out_extents);
+
+}  // namespace engine::math
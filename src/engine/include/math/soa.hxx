@@ -0,0 +1,111 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace engine::math
+{
+
+// Structure of arrays: element i is (x[i], y[i], z[i]). Batch kernels read and
+// write whole SIMD registers per component instead of shuffling AoS vectors.
+struct Vec3Span
+{
+  float* x = nullptr;
+  float* y = nullptr;
+  float* z = nullptr;
+  size_t size = 0;
+
+  Vec3Span Subspan(size_t offset, size_t count) const
+  {
+    assert(offset + count <= size);
+    return {x + offset, y + offset, z + offset, count};
+  }
+};
+
+struct ConstVec3Span
+{
+  const float* x = nullptr;
+  const float* y = nullptr;
+  const float* z = nullptr;
+  size_t size = 0;
+
+  ConstVec3Span() = default;
+  ConstVec3Span(const float* x, const float* y, const float* z, size_t size) : x(x), y(y), z(z), size(size) {}
+  ConstVec3Span(const Vec3Span& span) : x(span.x), y(span.y), z(span.z), size(span.size) {}
+
+  ConstVec3Span Subspan(size_t offset, size_t count) const
+  {
+    assert(offset + count <= size);
+    return {x + offset, y + offset, z + offset, count};
+  }
+
+  glm::vec3 operator[](size_t i) const { return {x[i], y[i], z[i]}; }
+};
+
+class Vec3Soa
+{
+public:
+  Vec3Soa() = default;
+  explicit Vec3Soa(size_t size) { Resize(size); }
+
+  void Resize(size_t size)
+  {
+    m_x.resize(size);
+    m_y.resize(size);
+    m_z.resize(size);
+  }
+
+  void Reserve(size_t size)
+  {
+    m_x.reserve(size);
+    m_y.reserve(size);
+    m_z.reserve(size);
+  }
+
+  void Clear() { Resize(0); }
+
+  void PushBack(const glm::vec3& value)
+  {
+    m_x.push_back(value.x);
+    m_y.push_back(value.y);
+    m_z.push_back(value.z);
+  }
+
+  void Set(size_t i, const glm::vec3& value)
+  {
+    m_x[i] = value.x;
+    m_y[i] = value.y;
+    m_z[i] = value.z;
+  }
+
+  glm::vec3 operator[](size_t i) const { return {m_x[i], m_y[i], m_z[i]}; }
+  size_t Size() const { return m_x.size(); }
+
+  Vec3Span Span() { return {m_x.data(), m_y.data(), m_z.data(), m_x.size()}; }
+  ConstVec3Span Span() const { return {m_x.data(), m_y.data(), m_z.data(), m_x.size()}; }
+
+private:
+  std::vector<float> m_x;
+  std::vector<float> m_y;
+  std::vector<float> m_z;
+};
+
+}  // namespace engine::math
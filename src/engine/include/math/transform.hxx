@@ -0,0 +1,67 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <span>
+
+namespace engine::math
+{
+
+// Matrices are column-major like glm and GLSL: Multiply(a, b) * v == a * (b * v).
+// Single matrices take the SSE2 path wherever SSE2 is the baseline, batches go
+// through the dispatched kernels in math/kernels.hxx.
+
+glm::mat4 Multiply(const glm::mat4& a, const glm::mat4& b);
+
+// For rotation, scale and translation only, the last row must be (0, 0, 0, 1)
+glm::mat4 AffineInverse(const glm::mat4& m);
+
+// Inverse transpose of the upper 3x3, in the first three columns of a mat4 so
+// that it fits a std140/std430 block, where mat3 does not match C++
+glm::mat4 NormalMatrix(const glm::mat4& world);
+
+// Composed once per frame
+struct ViewTransforms
+{
+  glm::mat4 view = glm::mat4(1.f);
+  glm::mat4 projection = glm::mat4(1.f);
+  glm::mat4 view_projection = glm::mat4(1.f);
+  // view must be affine
+  glm::mat4 inverse_view = glm::mat4(1.f);
+  glm::mat4 inverse_view_projection = glm::mat4(1.f);
+};
+
+ViewTransforms ComposeView(const glm::mat4& view, const glm::mat4& projection);
+
+// Composed once per object per frame, so that the vertex shader does a single
+// matrix-vector product instead of a chain of matrix products
+struct ObjectTransforms
+{
+  glm::mat4 world_view_projection;
+  glm::mat4 world;
+  glm::mat4 normal;
+};
+
+// out[i] for worlds[i], the spans must have the same size
+void ComposeObjects(const glm::mat4& view_projection, std::span<const glm::mat4> worlds,
+  std::span<ObjectTransforms> out);
+// Only the clip space matrix, for shaders that need nothing else
+void ComposeWorldViewProjection(const glm::mat4& view_projection, std::span<const glm::mat4> worlds,
+  std::span<glm::mat4> out);
+
+}  // namespace engine::math
@@ -0,0 +1,199 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::memory
+{
+
+#ifdef NDEBUG
+constexpr bool kPoisonOnResetByDefault = false;
+#else
+constexpr bool kPoisonOnResetByDefault = true;
+#endif
+
+// Freed memory is filled with this byte when poisoning is enabled
+constexpr uint8_t kPoisonByte = 0xCD;
+
+// Bump allocator over a list of blocks. Reset() rewinds to the first block
+// and keeps every block for reuse. Not thread safe.
+class LinearArena
+{
+public:
+  static constexpr size_t kDefaultBlockSize = 1u << 20;
+
+  explicit LinearArena(size_t block_size = kDefaultBlockSize);
+  ~LinearArena();
+
+  LinearArena(const LinearArena&) = delete;
+  LinearArena& operator=(const LinearArena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment)
+  {
+    uintptr_t aligned = (m_cursor + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    if (aligned + size <= m_end && m_cursor != 0) {
+      m_cursor = aligned + size;
+      m_allocated += size;
+      return reinterpret_cast<void*>(aligned);
+    }
+    return AllocateSlow(size, alignment);
+  }
+
+  void Reset(bool poison);
+  // Applies to blocks allocated from now on
+  void SetBlockSize(size_t block_size) { m_block_size = block_size; }
+
+  size_t BytesAllocated() const { return m_allocated; }
+  size_t BytesReserved() const;
+
+private:
+  struct Block
+  {
+    std::byte* memory = nullptr;
+    size_t size = 0;
+  };
+
+  void* AllocateSlow(size_t size, size_t alignment);
+
+  size_t m_block_size;
+  std::vector<Block> m_blocks;
+  // Blocks before m_next are in use until the next reset
+  size_t m_next = 0;
+  uintptr_t m_cursor = 0;
+  uintptr_t m_end = 0;
+  size_t m_allocated = 0;
+};
+
+class FrameArena;
+
+// std::pmr adapter, deallocation is a no-op: memory is reclaimed when the frame is recycled
+class FrameMemoryResource : public std::pmr::memory_resource
+{
+public:
+  explicit FrameMemoryResource(FrameArena& arena)
+   : m_arena(arena)
+  {}
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void*, size_t, size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  FrameArena& m_arena;
+};
+
+// Transient per-frame memory. Every thread bumps through its own blocks, so
+// allocation takes no lock. Memory allocated during frame N stays valid until
+// EndFrame() of frame N + 1, which lets the next frame consume it while it is
+// being built. Destructors of objects placed in the arena are never run.
+class FrameArena
+{
+public:
+  static constexpr size_t kFramesInFlight = 2;
+
+  struct Stats
+  {
+    size_t threads = 0;
+    size_t bytes_allocated = 0;  // in the current frame
+    size_t bytes_reserved = 0;   // across all frames and threads
+  };
+
+  explicit FrameArena(size_t block_size = LinearArena::kDefaultBlockSize);
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+  {
+    return LocalArenas()[m_slot.load(std::memory_order_relaxed)].Allocate(size, alignment);
+  }
+
+  template<class T>
+  T* AllocateArray(size_t count)
+  {
+    static_assert(std::is_trivially_destructible_v<T>, "Destructors are not run for arena memory");
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  template<class T, class... Args>
+  T* New(Args&&... args)
+  {
+    static_assert(std::is_trivially_destructible_v<T>, "Destructors are not run for arena memory");
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  std::pmr::memory_resource& Resource() { return m_resource; }
+
+  // Must be called while no thread allocates, recycles the memory of frame N - 1
+  void EndFrame();
+
+  uint64_t Frame() const { return m_frame; }
+  Stats GetStats() const;
+
+  void SetPoisonOnReset(bool poison) { m_poison = poison; }
+
+private:
+  using ThreadArenas = std::array<LinearArena, kFramesInFlight>;
+
+  struct ThreadEntry
+  {
+    std::thread::id thread;
+    std::unique_ptr<ThreadArenas> arenas;
+  };
+
+  // Zero initialized as thread storage, 0 is never a valid arena id
+  struct ThreadCache
+  {
+    uint64_t owner;
+    ThreadArenas* arenas;
+  };
+
+  ThreadArenas& LocalArenas()
+  {
+    if (t_cache.owner == m_id)
+      return *t_cache.arenas;
+    return RegisterThread();
+  }
+
+  ThreadArenas& RegisterThread();
+
+  static inline thread_local ThreadCache t_cache;
+
+  const uint64_t m_id;
+  const size_t m_block_size;
+  std::atomic<size_t> m_slot = 0;
+  uint64_t m_frame = 0;
+  bool m_poison = kPoisonOnResetByDefault;
+
+  mutable std::mutex m_threads_mutex;
+  std::vector<ThreadEntry> m_threads;
+
+  FrameMemoryResource m_resource;
+};
+
+}  // namespace engine::memory
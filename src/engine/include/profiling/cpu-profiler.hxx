@@ -0,0 +1,179 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ENGINE_PROFILER_RDTSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace engine::profiling
+{
+
+enum class CpuEventType : uint32_t
+{
+  Scope,
+  Frame,
+};
+
+struct CpuEvent
+{
+  const char* name = nullptr;
+  uint64_t begin = 0;
+  uint64_t end = 0;
+  CpuEventType type = CpuEventType::Scope;
+  uint32_t depth = 0;
+};
+
+// Events of a single thread. Only the owning thread writes, the exporter reads
+// everything below the published counter, so no lock is taken on the hot path.
+// When full, the oldest events are overwritten.
+class CpuThreadBuffer
+{
+public:
+  static constexpr size_t kCapacity = 1u << 16;
+
+  CpuThreadBuffer(uint32_t thread_index)
+   : m_events(std::make_unique<CpuEvent[]>(kCapacity)), m_thread_index(thread_index)
+  {}
+
+  void Push(const CpuEvent& event)
+  {
+    uint64_t index = m_written.load(std::memory_order_relaxed);
+    m_events[index & (kCapacity - 1)] = event;
+    m_written.store(index + 1, std::memory_order_release);
+  }
+
+  std::vector<CpuEvent> Snapshot() const;
+
+  uint32_t ThreadIndex() const { return m_thread_index; }
+  std::string Name() const;
+  void SetName(std::string name);
+
+  uint32_t depth = 0;
+
+private:
+  std::unique_ptr<CpuEvent[]> m_events;
+  std::atomic<uint64_t> m_written = 0;
+  uint32_t m_thread_index = 0;
+
+  mutable std::mutex m_name_mutex;
+  std::string m_name;
+};
+
+class CpuProfiler
+{
+public:
+  static CpuProfiler& Instance();
+
+  // Raw ticks: TSC where available, steady_clock otherwise. Converted on export.
+  static uint64_t Now()
+  {
+#ifdef ENGINE_PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+  }
+
+  CpuThreadBuffer& LocalBuffer()
+  {
+    if (!t_buffer)
+      t_buffer = RegisterThread();
+    return *t_buffer;
+  }
+
+  void SetThreadName(const char* name);
+  void MarkFrame();
+
+  uint64_t FrameCount() const { return m_frames.load(std::memory_order_relaxed); }
+
+  // Chrome/Perfetto JSON trace (chrome://tracing, ui.perfetto.dev)
+  void WriteChromeTrace(std::ostream& stream) const;
+  void ExportChromeTrace(const std::filesystem::path& path) const;
+
+private:
+  CpuProfiler();
+
+  CpuThreadBuffer* RegisterThread();
+  double TicksPerMicrosecond() const;
+
+  static inline thread_local CpuThreadBuffer* t_buffer = nullptr;
+
+  mutable std::mutex m_threads_mutex;
+  std::vector<std::unique_ptr<CpuThreadBuffer>> m_threads;
+
+  std::atomic<uint64_t> m_frames = 0;
+  uint64_t m_start_ticks = 0;
+  std::chrono::steady_clock::time_point m_start_time;
+};
+
+class CpuScope
+{
+public:
+  CpuScope(const char* name)
+   : m_buffer(CpuProfiler::Instance().LocalBuffer()), m_name(name), m_begin(CpuProfiler::Now())
+  {
+    ++m_buffer.depth;
+  }
+
+  ~CpuScope()
+  {
+    uint64_t end = CpuProfiler::Now();
+    --m_buffer.depth;
+    m_buffer.Push({m_name, m_begin, end, CpuEventType::Scope, m_buffer.depth});
+  }
+
+  CpuScope(const CpuScope&) = delete;
+  CpuScope& operator=(const CpuScope&) = delete;
+
+private:
+  CpuThreadBuffer& m_buffer;
+  const char* m_name;
+  uint64_t m_begin;
+};
+
+}  // namespace engine::profiling
+
+// Names must have static storage duration, string literals are expected.
+// ENGINE_ENABLE_PROFILING is defined for non-Release configurations only.
+#ifdef ENGINE_ENABLE_PROFILING
+#define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+#define ENGINE_PROFILE_SCOPE(name) ::engine::profiling::CpuScope ENGINE_PROFILE_CONCAT(cpu_scope_, __LINE__)(name)
+#define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__func__)
+#define ENGINE_PROFILE_FRAME() ::engine::profiling::CpuProfiler::Instance().MarkFrame()
+#define ENGINE_PROFILE_THREAD(name) ::engine::profiling::CpuProfiler::Instance().SetThreadName(name)
+#else
+#define ENGINE_PROFILE_SCOPE(name) ((void)0)
+#define ENGINE_PROFILE_FUNCTION() ((void)0)
+#define ENGINE_PROFILE_FRAME() ((void)0)
+#define ENGINE_PROFILE_THREAD(name) ((void)0)
+#endif
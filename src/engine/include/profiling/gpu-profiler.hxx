@@ -0,0 +1,139 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "gl/handle.hxx"
+#include "glad/glad.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+namespace engine::profiling
+{
+
+// Measures GPU time of nested scopes with GL_TIMESTAMP queries.
+// Results are read back kFramesInFlight frames later without waiting on the GPU:
+// a frame whose queries are still not available is dropped instead of stalling.
+class GpuProfiler
+{
+public:
+  static constexpr size_t kFramesInFlight = 4;
+  static constexpr size_t kHistorySize = 64;
+
+  struct Node
+  {
+    const char* name = nullptr;
+    int parent = -1;
+    int depth = 0;
+    // Last resolved values, relative to the start of the frame
+    double start_ms = 0.0;
+    double duration_ms = 0.0;
+    // Rolling values over the last kHistorySize resolved frames
+    double average_start_ms = 0.0;
+    double average_ms = 0.0;
+    double max_ms = 0.0;
+    std::array<float, kHistorySize> history = {};
+    size_t history_size = 0;
+    size_t history_head = 0;
+    uint64_t last_frame = 0;
+  };
+
+  GpuProfiler();
+
+  GpuProfiler(const GpuProfiler&) = delete;
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+  void BeginFrame();
+  void EndFrame();
+
+  // name must outlive the profiler, string literals are expected
+  void PushScope(const char* name);
+  void PopScope();
+
+  // Nodes are ordered so that a parent always precedes its children
+  const std::vector<Node>& Nodes() const { return m_nodes; }
+  double FrameAverageMs() const { return m_frame_average_ms; }
+  uint64_t ResolvedFrames() const { return m_resolved_frames; }
+  uint64_t DroppedFrames() const { return m_dropped_frames; }
+
+  void DrawImGui(const char* window_name = "GPU profiler") const;
+  void WriteJson(std::ostream& stream) const;
+  void ExportJson(const std::filesystem::path& path) const;
+
+  void SetEnabled(bool enabled) { m_enabled = enabled; }
+  bool IsEnabled() const { return m_enabled; }
+
+private:
+  struct ScopeRecord
+  {
+    int node = -1;
+    uint32_t begin_query = 0;
+    uint32_t end_query = 0;
+  };
+
+  struct FrameSlot
+  {
+    std::vector<gl::QueryHandle> queries;
+    uint32_t used_queries = 0;
+    std::vector<ScopeRecord> scopes;
+    uint64_t frame = 0;
+    bool pending = false;
+  };
+
+  uint32_t IssueTimestamp(FrameSlot& slot);
+  int FindOrAddNode(int parent, const char* name);
+  void Resolve(FrameSlot& slot);
+  void Accumulate(Node& node, double start_ms, double duration_ms);
+
+  std::array<FrameSlot, kFramesInFlight> m_slots;
+  size_t m_current_slot = 0;
+  uint64_t m_frame = 0;
+  bool m_in_frame = false;
+  bool m_enabled = true;
+
+  std::vector<int> m_stack;
+  std::vector<Node> m_nodes;
+
+  double m_frame_average_ms = 0.0;
+  uint64_t m_resolved_frames = 0;
+  uint64_t m_dropped_frames = 0;
+};
+
+class GpuScope
+{
+public:
+  GpuScope(GpuProfiler& profiler, const char* name)
+   : m_profiler(profiler)
+  {
+    m_profiler.PushScope(name);
+  }
+
+  ~GpuScope()
+  {
+    m_profiler.PopScope();
+  }
+
+  GpuScope(const GpuScope&) = delete;
+  GpuScope& operator=(const GpuScope&) = delete;
+
+private:
+  GpuProfiler& m_profiler;
+};
+
+}  // namespace engine::profiling
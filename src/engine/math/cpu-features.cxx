@@ -0,0 +1,150 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "math/cpu-features.hxx"
+
+#include <algorithm>
+#include <atomic>
+
+#ifdef ENGINE_MATH_SSE
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace engine::math
+{
+
+namespace
+{
+
+#ifdef ENGINE_MATH_SSE
+
+struct CpuidResult
+{
+  uint32_t eax = 0;
+  uint32_t ebx = 0;
+  uint32_t ecx = 0;
+  uint32_t edx = 0;
+};
+
+CpuidResult Cpuid(uint32_t leaf, uint32_t subleaf)
+{
+  CpuidResult result;
+#ifdef _MSC_VER
+  int registers[4] = {};
+  __cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+  result = {static_cast<uint32_t>(registers[0]), static_cast<uint32_t>(registers[1]),
+    static_cast<uint32_t>(registers[2]), static_cast<uint32_t>(registers[3])};
+#else
+  __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+  return result;
+}
+
+// XCR0, only valid when cpuid reports OSXSAVE
+uint64_t ExtendedControlRegister()
+{
+#ifdef _MSC_VER
+  return _xgetbv(0);
+#else
+  uint32_t eax = 0;
+  uint32_t edx = 0;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+CpuFeatures DetectFeatures()
+{
+  CpuFeatures features;
+  const uint32_t max_leaf = Cpuid(0, 0).eax;
+  if (max_leaf < 1)
+    return features;
+
+  const CpuidResult leaf1 = Cpuid(1, 0);
+  features.sse2 = (leaf1.edx >> 26) & 1;
+  features.sse41 = (leaf1.ecx >> 19) & 1;
+  features.fma = (leaf1.ecx >> 12) & 1;
+  features.avx = (leaf1.ecx >> 28) & 1;
+
+  // XMM and YMM state enabled by the OS
+  const bool osxsave = (leaf1.ecx >> 27) & 1;
+  features.os_avx = osxsave && (ExtendedControlRegister() & 0x6) == 0x6;
+
+  if (max_leaf >= 7)
+    features.avx2 = (Cpuid(7, 0).ebx >> 5) & 1;
+
+  return features;
+}
+
+#else
+
+CpuFeatures DetectFeatures()
+{
+  return {};
+}
+
+#endif
+
+std::atomic<SimdLevel> g_level{SupportedSimdLevel()};
+
+}  // namespace
+
+const CpuFeatures& GetCpuFeatures()
+{
+  static const CpuFeatures features = DetectFeatures();
+  return features;
+}
+
+SimdLevel SupportedSimdLevel()
+{
+  [[maybe_unused]] const CpuFeatures& features = GetCpuFeatures();
+#ifdef ENGINE_MATH_AVX2
+  if (features.avx2 && features.fma && features.os_avx)
+    return SimdLevel::Avx2;
+#endif
+#ifdef ENGINE_MATH_SSE
+  // Baseline of every x86-64 CPU
+  return SimdLevel::Sse2;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel GetSimdLevel()
+{
+  return g_level.load(std::memory_order_relaxed);
+}
+
+void SetSimdLevel(SimdLevel level)
+{
+  g_level.store(std::min(level, SupportedSimdLevel()), std::memory_order_relaxed);
+}
+
+const char* SimdLevelName(SimdLevel level)
+{
+  switch (level) {
+  case SimdLevel::Scalar: return "scalar";
+  case SimdLevel::Sse2: return "SSE2";
+  case SimdLevel::Avx2: return "AVX2";
+  }
+  return "unknown";
+}
+
+}  // namespace engine::math
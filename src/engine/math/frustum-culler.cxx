@@ -0,0 +1,104 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "math/frustum-culler.hxx"
+
+#include "core/job-system.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine::math
+{
+
+FrustumCuller::FrustumCuller(JobSystem* jobs, size_t grain)
+ : m_jobs(jobs), m_grain(std::max<size_t>(grain, 1))
+{}
+
+uint32_t FrustumCuller::Add(const glm::vec3& center, float radius, const glm::vec3& extent)
+{
+  m_centers.PushBack(center);
+  m_extents.PushBack(extent);
+  m_radii.push_back(radius);
+  return static_cast<uint32_t>(m_radii.size() - 1);
+}
+
+void FrustumCuller::Set(uint32_t index, const glm::vec3& center, float radius, const glm::vec3& extent)
+{
+  m_centers.Set(index, center);
+  m_extents.Set(index, extent);
+  m_radii[index] = radius;
+}
+
+void FrustumCuller::Reserve(size_t count)
+{
+  m_centers.Reserve(count);
+  m_extents.Reserve(count);
+  m_radii.reserve(count);
+}
+
+void FrustumCuller::Clear()
+{
+  m_centers.Clear();
+  m_extents.Clear();
+  m_radii.clear();
+}
+
+ConstBoundsSpan FrustumCuller::Bounds() const
+{
+  return {m_centers.Span(), m_radii.data(), m_extents.Span()};
+}
+
+std::span<const uint32_t> FrustumCuller::Cull(const Frustum& frustum)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  const size_t size = Size();
+  const size_t chunks = (size + m_grain - 1) / m_grain;
+  m_visible.resize(size);
+  m_chunk_counts.assign(chunks, 0);
+
+  const ConstBoundsSpan bounds = Bounds();
+  auto cull_range = [&](size_t begin, size_t end) {
+    const size_t count = CullBounds(frustum, bounds.Subspan(begin, end - begin), static_cast<uint32_t>(begin),
+      std::span(m_visible).subspan(begin, end - begin));
+    m_chunk_counts[begin / m_grain] = static_cast<uint32_t>(count);
+  };
+
+  if (m_jobs)
+    m_jobs->ParallelFor(size, m_grain, cull_range);
+  else if (size != 0)
+    cull_range(0, size);
+
+  // Chunk k starts at k * grain and only moves down, so packing in order never
+  // overwrites indices that are still to be moved
+  size_t visible = 0;
+  for (size_t chunk = 0; chunk < chunks; ++chunk) {
+    const uint32_t count = m_chunk_counts[chunk];
+    const size_t begin = chunk * m_grain;
+    if (begin != visible)
+      std::memmove(m_visible.data() + visible, m_visible.data() + begin, count * sizeof(uint32_t));
+    visible += count;
+  }
+
+  m_stats.tested = static_cast<uint32_t>(size);
+  m_stats.visible = static_cast<uint32_t>(visible);
+  m_stats.chunks = static_cast<uint32_t>(chunks);
+  return {m_visible.data(), visible};
+}
+
+}  // namespace engine::math
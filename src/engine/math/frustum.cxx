@@ -0,0 +1,211 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "math/frustum.hxx"
+
+#include "math/cpu-features.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#ifdef ENGINE_MATH_SSE
+#include <immintrin.h>
+#endif
+
+namespace engine::math
+{
+
+namespace
+{
+
+glm::vec4 Normalize(const glm::vec4& plane)
+{
+  return plane / glm::length(glm::vec3(plane));
+}
+
+// A sphere reaches radius behind its center along any normal, a box the
+// projection of its extent on the normal. Both have to reach inside every
+// plane, so the smaller reach is tested.
+
+size_t CullBoundsScalar(const Frustum& frustum, ConstBoundsSpan bounds, size_t first, uint32_t first_index,
+  uint32_t* visible)
+{
+  size_t count = 0;
+  for (size_t i = first; i < bounds.Size(); ++i) {
+    const glm::vec3 center = bounds.centers[i];
+    const glm::vec3 extent = bounds.extents[i];
+    bool inside = true;
+    for (const glm::vec4& plane : frustum.planes) {
+      const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+      const float box_reach = std::fabs(plane.x) * extent.x + std::fabs(plane.y) * extent.y
+        + std::fabs(plane.z) * extent.z;
+      inside &= distance + std::min(bounds.radii[i], box_reach) >= 0.f;
+    }
+    // Written unconditionally, the next visible object overwrites a culled one
+    visible[count] = first_index + static_cast<uint32_t>(i);
+    count += inside;
+  }
+  return count;
+}
+
+#ifdef ENGINE_MATH_SSE
+
+size_t CullBoundsSse2(const Frustum& frustum, ConstBoundsSpan bounds, uint32_t first_index, uint32_t* visible)
+{
+  const __m128 sign = _mm_set1_ps(-0.f);
+  __m128 planes[Frustum::kPlaneCount][7];
+  for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+    for (int k = 0; k < 4; ++k)
+      planes[p][k] = _mm_set1_ps(frustum.planes[p][k]);
+    for (int k = 0; k < 3; ++k)
+      planes[p][4 + k] = _mm_andnot_ps(sign, planes[p][k]);
+  }
+
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 4 <= bounds.Size(); i += 4) {
+    const __m128 cx = _mm_loadu_ps(bounds.centers.x + i);
+    const __m128 cy = _mm_loadu_ps(bounds.centers.y + i);
+    const __m128 cz = _mm_loadu_ps(bounds.centers.z + i);
+    const __m128 ex = _mm_loadu_ps(bounds.extents.x + i);
+    const __m128 ey = _mm_loadu_ps(bounds.extents.y + i);
+    const __m128 ez = _mm_loadu_ps(bounds.extents.z + i);
+    const __m128 radius = _mm_loadu_ps(bounds.radii + i);
+
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (const __m128 (&plane)[7] : planes) {
+      __m128 distance = _mm_add_ps(_mm_mul_ps(plane[0], cx), plane[3]);
+      distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(plane[1], cy), _mm_mul_ps(plane[2], cz)));
+      __m128 box_reach = _mm_mul_ps(plane[4], ex);
+      box_reach = _mm_add_ps(box_reach, _mm_add_ps(_mm_mul_ps(plane[5], ey), _mm_mul_ps(plane[6], ez)));
+      const __m128 reach = _mm_min_ps(radius, box_reach);
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+    }
+
+    const int mask = _mm_movemask_ps(inside);
+    for (int lane = 0; lane < 4; ++lane) {
+      visible[count] = first_index + static_cast<uint32_t>(i + lane);
+      count += (mask >> lane) & 1;
+    }
+  }
+  return count + CullBoundsScalar(frustum, bounds, i, first_index, visible + count);
+}
+
+#endif
+
+#ifdef ENGINE_MATH_AVX2
+
+ENGINE_MATH_TARGET_AVX2 size_t CullBoundsAvx2(const Frustum& frustum, ConstBoundsSpan bounds, uint32_t first_index,
+  uint32_t* visible)
+{
+  const __m256 sign = _mm256_set1_ps(-0.f);
+  __m256 planes[Frustum::kPlaneCount][7];
+  for (int p = 0; p < Frustum::kPlaneCount; ++p) {
+    for (int k = 0; k < 4; ++k)
+      planes[p][k] = _mm256_set1_ps(frustum.planes[p][k]);
+    for (int k = 0; k < 3; ++k)
+      planes[p][4 + k] = _mm256_andnot_ps(sign, planes[p][k]);
+  }
+
+  size_t count = 0;
+  size_t i = 0;
+  for (; i + 8 <= bounds.Size(); i += 8) {
+    const __m256 cx = _mm256_loadu_ps(bounds.centers.x + i);
+    const __m256 cy = _mm256_loadu_ps(bounds.centers.y + i);
+    const __m256 cz = _mm256_loadu_ps(bounds.centers.z + i);
+    const __m256 ex = _mm256_loadu_ps(bounds.extents.x + i);
+    const __m256 ey = _mm256_loadu_ps(bounds.extents.y + i);
+    const __m256 ez = _mm256_loadu_ps(bounds.extents.z + i);
+    const __m256 radius = _mm256_loadu_ps(bounds.radii + i);
+
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (const __m256 (&plane)[7] : planes) {
+      __m256 distance = _mm256_fmadd_ps(plane[0], cx, plane[3]);
+      distance = _mm256_fmadd_ps(plane[1], cy, distance);
+      distance = _mm256_fmadd_ps(plane[2], cz, distance);
+      __m256 box_reach = _mm256_mul_ps(plane[4], ex);
+      box_reach = _mm256_fmadd_ps(plane[5], ey, box_reach);
+      box_reach = _mm256_fmadd_ps(plane[6], ez, box_reach);
+      const __m256 reach = _mm256_min_ps(radius, box_reach);
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+
+    const int mask = _mm256_movemask_ps(inside);
+    for (int lane = 0; lane < 8; ++lane) {
+      visible[count] = first_index + static_cast<uint32_t>(i + lane);
+      count += (mask >> lane) & 1;
+    }
+  }
+  return count + CullBoundsScalar(frustum, bounds, i, first_index, visible + count);
+}
+
+#endif
+
+}  // namespace
+
+Frustum Frustum::FromViewProjection(const glm::mat4& view_projection)
+{
+  // glm is column-major, row i is m[0][i], m[1][i], m[2][i], m[3][i]
+  const glm::mat4 rows = glm::transpose(view_projection);
+
+  Frustum frustum;
+  frustum.planes[kLeft] = Normalize(rows[3] + rows[0]);
+  frustum.planes[kRight] = Normalize(rows[3] - rows[0]);
+  frustum.planes[kBottom] = Normalize(rows[3] + rows[1]);
+  frustum.planes[kTop] = Normalize(rows[3] - rows[1]);
+  frustum.planes[kNear] = Normalize(rows[3] + rows[2]);
+  frustum.planes[kFar] = Normalize(rows[3] - rows[2]);
+  return frustum;
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+{
+  for (const glm::vec4& plane : planes) {
+    if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+      return false;
+  }
+  return true;
+}
+
+bool Frustum::IntersectsAabb(const glm::vec3& center, const glm::vec3& extent) const
+{
+  for (const glm::vec4& plane : planes) {
+    if (glm::dot(glm::vec3(plane), center) + plane.w < -glm::dot(glm::abs(glm::vec3(plane)), extent))
+      return false;
+  }
+  return true;
+}
+
+size_t CullBounds(const Frustum& frustum, ConstBoundsSpan bounds, uint32_t first_index, std::span<uint32_t> visible)
+{
+  assert(visible.size() >= bounds.Size());
+
+  switch (GetSimdLevel()) {
+#ifdef ENGINE_MATH_AVX2
+  case SimdLevel::Avx2:
+    return CullBoundsAvx2(frustum, bounds, first_index, visible.data());
+#endif
+#ifdef ENGINE_MATH_SSE
+  case SimdLevel::Sse2:
+    return CullBoundsSse2(frustum, bounds, first_index, visible.data());
+#endif
+  default:
+    return CullBoundsScalar(frustum, bounds, 0, first_index, visible.data());
+  }
+}
+
+}  // namespace engine::math
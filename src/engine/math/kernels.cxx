@@ -0,0 +1,543 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "math/kernels.hxx"
+
+#include "math/cpu-features.hxx"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#ifdef ENGINE_MATH_SSE
+#include <immintrin.h>
+#endif
+
+namespace engine::math
+{
+
+namespace
+{
+
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float) && sizeof(glm::vec4) == 4 * sizeof(float));
+static_assert(sizeof(glm::quat) == 4 * sizeof(float) && offsetof(glm::quat, x) == 0 && offsetof(glm::quat, w) == 12,
+  "Kernels expect quaternions stored x, y, z, w");
+
+// The kernels work on raw floats: glm is not inlined into functions built for
+// another target, and a matrix is 16 floats column after column
+
+template<class T>
+const float* Floats(std::span<const T> values)
+{
+  return reinterpret_cast<const float*>(values.data());
+}
+
+template<class T>
+float* Floats(std::span<T> values)
+{
+  return reinterpret_cast<float*>(values.data());
+}
+
+// Scalar, also the tail of the SIMD loops. Each element goes through locals
+// first, so out may be the same memory as in.
+
+void MultiplyScalar(const float* a, const float* b, float* out, size_t count)
+{
+  for (size_t i = 0; i < count; ++i, b += 16, out += 16) {
+    for (int column = 0; column < 4; ++column) {
+      const float* bc = b + column * 4;
+      float result[4];
+      for (int row = 0; row < 4; ++row)
+        result[row] = a[row] * bc[0] + a[4 + row] * bc[1] + a[8 + row] * bc[2] + a[12 + row] * bc[3];
+      for (int row = 0; row < 4; ++row)
+        out[column * 4 + row] = result[row];
+    }
+  }
+}
+
+void TransformVectorsScalar(const float* m, const float* in, float* out, size_t count)
+{
+  for (size_t i = 0; i < count; ++i, in += 4, out += 4) {
+    float result[4];
+    for (int row = 0; row < 4; ++row)
+      result[row] = m[row] * in[0] + m[4 + row] * in[1] + m[8 + row] * in[2] + m[12 + row] * in[3];
+    for (int row = 0; row < 4; ++row)
+      out[row] = result[row];
+  }
+}
+
+void TransformPointsScalar(const float* m, ConstVec3Span in, Vec3Span out, size_t first)
+{
+  for (size_t i = first; i < in.size; ++i) {
+    const float x = in.x[i];
+    const float y = in.y[i];
+    const float z = in.z[i];
+    out.x[i] = m[0] * x + m[4] * y + m[8] * z + m[12];
+    out.y[i] = m[1] * x + m[5] * y + m[9] * z + m[13];
+    out.z[i] = m[2] * x + m[6] * y + m[10] * z + m[14];
+  }
+}
+
+void QuaternionsToMatricesScalar(const float* in, float* out, size_t count)
+{
+  for (size_t i = 0; i < count; ++i, in += 4, out += 16) {
+    const float x = in[0], y = in[1], z = in[2], w = in[3];
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    const float matrix[16] = {
+      1.f - 2.f * (yy + zz), 2.f * (xy + wz), 2.f * (xz - wy), 0.f,
+      2.f * (xy - wz), 1.f - 2.f * (xx + zz), 2.f * (yz + wx), 0.f,
+      2.f * (xz + wy), 2.f * (yz - wx), 1.f - 2.f * (xx + yy), 0.f,
+      0.f, 0.f, 0.f, 1.f,
+    };
+    for (int j = 0; j < 16; ++j)
+      out[j] = matrix[j];
+  }
+}
+
+void TransformAabbsScalar(const float* m, ConstVec3Span centers, ConstVec3Span extents,
+  Vec3Span out_centers, Vec3Span out_extents, size_t first)
+{
+  for (size_t i = first; i < centers.size; ++i) {
+    const float cx = centers.x[i], cy = centers.y[i], cz = centers.z[i];
+    const float ex = extents.x[i], ey = extents.y[i], ez = extents.z[i];
+    for (int row = 0; row < 3; ++row) {
+      const float center = m[row] * cx + m[4 + row] * cy + m[8 + row] * cz + m[12 + row];
+      const float extent = std::fabs(m[row]) * ex + std::fabs(m[4 + row]) * ey + std::fabs(m[8 + row]) * ez;
+      (row == 0 ? out_centers.x : row == 1 ? out_centers.y : out_centers.z)[i] = center;
+      (row == 0 ? out_extents.x : row == 1 ? out_extents.y : out_extents.z)[i] = extent;
+    }
+  }
+}
+
+#ifdef ENGINE_MATH_SSE
+
+template<int Lane>
+__m128 Splat(__m128 v)
+{
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+__m128 TransformSse2(const __m128 (&m)[4], __m128 v)
+{
+  __m128 result = _mm_mul_ps(m[0], Splat<0>(v));
+  result = _mm_add_ps(result, _mm_mul_ps(m[1], Splat<1>(v)));
+  result = _mm_add_ps(result, _mm_mul_ps(m[2], Splat<2>(v)));
+  return _mm_add_ps(result, _mm_mul_ps(m[3], Splat<3>(v)));
+}
+
+void MultiplySse2(const float* a, const float* b, float* out, size_t count)
+{
+  const __m128 columns[4] = {_mm_loadu_ps(a), _mm_loadu_ps(a + 4), _mm_loadu_ps(a + 8), _mm_loadu_ps(a + 12)};
+  for (size_t i = 0; i < count; ++i, b += 16, out += 16) {
+    for (int column = 0; column < 4; ++column)
+      _mm_storeu_ps(out + column * 4, TransformSse2(columns, _mm_loadu_ps(b + column * 4)));
+  }
+}
+
+void TransformVectorsSse2(const float* m, const float* in, float* out, size_t count)
+{
+  const __m128 columns[4] = {_mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12)};
+  for (size_t i = 0; i < count; ++i)
+    _mm_storeu_ps(out + i * 4, TransformSse2(columns, _mm_loadu_ps(in + i * 4)));
+}
+
+void TransformPointsSse2(const float* m, ConstVec3Span in, Vec3Span out)
+{
+  __m128 matrix[12];
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 3; ++row)
+      matrix[column * 3 + row] = _mm_set1_ps(m[column * 4 + row]);
+  }
+
+  size_t i = 0;
+  for (; i + 4 <= in.size; i += 4) {
+    const __m128 x = _mm_loadu_ps(in.x + i);
+    const __m128 y = _mm_loadu_ps(in.y + i);
+    const __m128 z = _mm_loadu_ps(in.z + i);
+    float* outputs[3] = {out.x + i, out.y + i, out.z + i};
+    __m128 results[3];
+    for (int row = 0; row < 3; ++row) {
+      __m128 result = _mm_add_ps(_mm_mul_ps(matrix[row], x), matrix[9 + row]);
+      result = _mm_add_ps(result, _mm_mul_ps(matrix[3 + row], y));
+      results[row] = _mm_add_ps(result, _mm_mul_ps(matrix[6 + row], z));
+    }
+    for (int row = 0; row < 3; ++row)
+      _mm_storeu_ps(outputs[row], results[row]);
+  }
+  TransformPointsScalar(m, in, out, i);
+}
+
+void QuaternionsToMatricesSse2(const float* in, float* out, size_t count)
+{
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 two = _mm_set1_ps(2.f);
+  const __m128 last_column = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4, in += 16, out += 64) {
+    // Four quaternions to x, y, z and w registers
+    __m128 x = _mm_loadu_ps(in);
+    __m128 y = _mm_loadu_ps(in + 4);
+    __m128 z = _mm_loadu_ps(in + 8);
+    __m128 w = _mm_loadu_ps(in + 12);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+    const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+    const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+    // columns[c][r] holds entry (r, c) of the four matrices
+    __m128 columns[3][4] = {
+      {_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_add_ps(xy, wz)),
+        _mm_mul_ps(two, _mm_sub_ps(xz, wy)), _mm_setzero_ps()},
+      {_mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))),
+        _mm_mul_ps(two, _mm_add_ps(yz, wx)), _mm_setzero_ps()},
+      {_mm_mul_ps(two, _mm_add_ps(xz, wy)), _mm_mul_ps(two, _mm_sub_ps(yz, wx)),
+        _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), _mm_setzero_ps()},
+    };
+
+    for (int column = 0; column < 3; ++column) {
+      __m128* rows = columns[column];
+      _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+      for (int k = 0; k < 4; ++k)
+        _mm_storeu_ps(out + k * 16 + column * 4, rows[k]);
+    }
+    for (int k = 0; k < 4; ++k)
+      _mm_storeu_ps(out + k * 16 + 12, last_column);
+  }
+  QuaternionsToMatricesScalar(in, out, count - i);
+}
+
+void TransformAabbsSse2(const float* m, ConstVec3Span centers, ConstVec3Span extents,
+  Vec3Span out_centers, Vec3Span out_extents)
+{
+  const __m128 sign = _mm_set1_ps(-0.f);
+  __m128 matrix[12];
+  __m128 absolute[9];
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 3; ++row) {
+      matrix[column * 3 + row] = _mm_set1_ps(m[column * 4 + row]);
+      if (column < 3)
+        absolute[column * 3 + row] = _mm_andnot_ps(sign, matrix[column * 3 + row]);
+    }
+  }
+
+  size_t i = 0;
+  for (; i + 4 <= centers.size; i += 4) {
+    const __m128 cx = _mm_loadu_ps(centers.x + i), cy = _mm_loadu_ps(centers.y + i), cz = _mm_loadu_ps(centers.z + i);
+    const __m128 ex = _mm_loadu_ps(extents.x + i), ey = _mm_loadu_ps(extents.y + i), ez = _mm_loadu_ps(extents.z + i);
+    __m128 center[3];
+    __m128 extent[3];
+    for (int row = 0; row < 3; ++row) {
+      center[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(matrix[row], cx), matrix[9 + row]),
+        _mm_add_ps(_mm_mul_ps(matrix[3 + row], cy), _mm_mul_ps(matrix[6 + row], cz)));
+      extent[row] = _mm_add_ps(_mm_mul_ps(absolute[row], ex),
+        _mm_add_ps(_mm_mul_ps(absolute[3 + row], ey), _mm_mul_ps(absolute[6 + row], ez)));
+    }
+    _mm_storeu_ps(out_centers.x + i, center[0]);
+    _mm_storeu_ps(out_centers.y + i, center[1]);
+    _mm_storeu_ps(out_centers.z + i, center[2]);
+    _mm_storeu_ps(out_extents.x + i, extent[0]);
+    _mm_storeu_ps(out_extents.y + i, extent[1]);
+    _mm_storeu_ps(out_extents.z + i, extent[2]);
+  }
+  TransformAabbsScalar(m, centers, extents, out_centers, out_extents, i);
+}
+
+#endif
+
+#ifdef ENGINE_MATH_AVX2
+
+// Same matrix column in both 128-bit lanes
+ENGINE_MATH_TARGET_AVX2 __m256 BroadcastColumn(const float* column)
+{
+  return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(column));
+}
+
+// Two vec4 per register, one per lane: m * v for both
+ENGINE_MATH_TARGET_AVX2 __m256 TransformPairAvx2(const __m256 (&m)[4], __m256 v)
+{
+  __m256 result = _mm256_mul_ps(m[0], _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+  result = _mm256_fmadd_ps(m[1], _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), result);
+  result = _mm256_fmadd_ps(m[2], _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), result);
+  return _mm256_fmadd_ps(m[3], _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), result);
+}
+
+// 4x4 transpose within each 128-bit lane
+ENGINE_MATH_TARGET_AVX2 void TransposeLanes(__m256& a, __m256& b, __m256& c, __m256& d)
+{
+  const __m256 t0 = _mm256_unpacklo_ps(a, b);
+  const __m256 t1 = _mm256_unpacklo_ps(c, d);
+  const __m256 t2 = _mm256_unpackhi_ps(a, b);
+  const __m256 t3 = _mm256_unpackhi_ps(c, d);
+  a = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+  b = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+  c = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  d = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+ENGINE_MATH_TARGET_AVX2 void MultiplyAvx2(const float* a, const float* b, float* out, size_t count)
+{
+  const __m256 columns[4] = {BroadcastColumn(a), BroadcastColumn(a + 4), BroadcastColumn(a + 8), BroadcastColumn(a + 12)};
+  for (size_t i = 0; i < count; ++i, b += 16, out += 16) {
+    const __m256 b01 = _mm256_loadu_ps(b);
+    const __m256 b23 = _mm256_loadu_ps(b + 8);
+    _mm256_storeu_ps(out, TransformPairAvx2(columns, b01));
+    _mm256_storeu_ps(out + 8, TransformPairAvx2(columns, b23));
+  }
+}
+
+ENGINE_MATH_TARGET_AVX2 void TransformVectorsAvx2(const float* m, const float* in, float* out, size_t count)
+{
+  const __m256 columns[4] = {BroadcastColumn(m), BroadcastColumn(m + 4), BroadcastColumn(m + 8), BroadcastColumn(m + 12)};
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+    _mm256_storeu_ps(out + i * 4, TransformPairAvx2(columns, _mm256_loadu_ps(in + i * 4)));
+  TransformVectorsScalar(m, in + i * 4, out + i * 4, count - i);
+}
+
+ENGINE_MATH_TARGET_AVX2 void TransformPointsAvx2(const float* m, ConstVec3Span in, Vec3Span out)
+{
+  __m256 matrix[12];
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 3; ++row)
+      matrix[column * 3 + row] = _mm256_set1_ps(m[column * 4 + row]);
+  }
+
+  size_t i = 0;
+  for (; i + 8 <= in.size; i += 8) {
+    const __m256 x = _mm256_loadu_ps(in.x + i);
+    const __m256 y = _mm256_loadu_ps(in.y + i);
+    const __m256 z = _mm256_loadu_ps(in.z + i);
+    __m256 results[3];
+    for (int row = 0; row < 3; ++row) {
+      __m256 result = _mm256_fmadd_ps(matrix[row], x, matrix[9 + row]);
+      result = _mm256_fmadd_ps(matrix[3 + row], y, result);
+      results[row] = _mm256_fmadd_ps(matrix[6 + row], z, result);
+    }
+    _mm256_storeu_ps(out.x + i, results[0]);
+    _mm256_storeu_ps(out.y + i, results[1]);
+    _mm256_storeu_ps(out.z + i, results[2]);
+  }
+  TransformPointsScalar(m, in, out, i);
+}
+
+ENGINE_MATH_TARGET_AVX2 void QuaternionsToMatricesAvx2(const float* in, float* out, size_t count)
+{
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 two = _mm256_set1_ps(2.f);
+  const __m128 last_column = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8, in += 32, out += 128) {
+    // Quaternions k and k + 4 share a register, one per lane
+    const __m256 q01 = _mm256_loadu_ps(in);
+    const __m256 q23 = _mm256_loadu_ps(in + 8);
+    const __m256 q45 = _mm256_loadu_ps(in + 16);
+    const __m256 q67 = _mm256_loadu_ps(in + 24);
+    __m256 x = _mm256_permute2f128_ps(q01, q45, 0x20);
+    __m256 y = _mm256_permute2f128_ps(q01, q45, 0x31);
+    __m256 z = _mm256_permute2f128_ps(q23, q67, 0x20);
+    __m256 w = _mm256_permute2f128_ps(q23, q67, 0x31);
+    TransposeLanes(x, y, z, w);
+
+    const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+    const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+    const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+    // columns[c][r] holds entry (r, c) of the eight matrices
+    __m256 columns[3][4] = {
+      {_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), _mm256_mul_ps(two, _mm256_add_ps(xy, wz)),
+        _mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), _mm256_setzero_ps()},
+      {_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), _mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one),
+        _mm256_mul_ps(two, _mm256_add_ps(yz, wx)), _mm256_setzero_ps()},
+      {_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), _mm256_mul_ps(two, _mm256_sub_ps(yz, wx)),
+        _mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one), _mm256_setzero_ps()},
+    };
+
+    for (int column = 0; column < 3; ++column) {
+      __m256* rows = columns[column];
+      TransposeLanes(rows[0], rows[1], rows[2], rows[3]);
+      for (int k = 0; k < 4; ++k) {
+        _mm_storeu_ps(out + k * 16 + column * 4, _mm256_castps256_ps128(rows[k]));
+        _mm_storeu_ps(out + (k + 4) * 16 + column * 4, _mm256_extractf128_ps(rows[k], 1));
+      }
+    }
+    for (int k = 0; k < 8; ++k)
+      _mm_storeu_ps(out + k * 16 + 12, last_column);
+  }
+  QuaternionsToMatricesScalar(in, out, count - i);
+}
+
+ENGINE_MATH_TARGET_AVX2 void TransformAabbsAvx2(const float* m, ConstVec3Span centers, ConstVec3Span extents,
+  Vec3Span out_centers, Vec3Span out_extents)
+{
+  const __m256 sign = _mm256_set1_ps(-0.f);
+  __m256 matrix[12];
+  __m256 absolute[9];
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 3; ++row) {
+      matrix[column * 3 + row] = _mm256_set1_ps(m[column * 4 + row]);
+      if (column < 3)
+        absolute[column * 3 + row] = _mm256_andnot_ps(sign, matrix[column * 3 + row]);
+    }
+  }
+
+  size_t i = 0;
+  for (; i + 8 <= centers.size; i += 8) {
+    const __m256 cx = _mm256_loadu_ps(centers.x + i);
+    const __m256 cy = _mm256_loadu_ps(centers.y + i);
+    const __m256 cz = _mm256_loadu_ps(centers.z + i);
+    const __m256 ex = _mm256_loadu_ps(extents.x + i);
+    const __m256 ey = _mm256_loadu_ps(extents.y + i);
+    const __m256 ez = _mm256_loadu_ps(extents.z + i);
+    __m256 center[3];
+    __m256 extent[3];
+    for (int row = 0; row < 3; ++row) {
+      center[row] = _mm256_fmadd_ps(matrix[row], cx, matrix[9 + row]);
+      center[row] = _mm256_fmadd_ps(matrix[3 + row], cy, center[row]);
+      center[row] = _mm256_fmadd_ps(matrix[6 + row], cz, center[row]);
+      extent[row] = _mm256_mul_ps(absolute[row], ex);
+      extent[row] = _mm256_fmadd_ps(absolute[3 + row], ey, extent[row]);
+      extent[row] = _mm256_fmadd_ps(absolute[6 + row], ez, extent[row]);
+    }
+    _mm256_storeu_ps(out_centers.x + i, center[0]);
+    _mm256_storeu_ps(out_centers.y + i, center[1]);
+    _mm256_storeu_ps(out_centers.z + i, center[2]);
+    _mm256_storeu_ps(out_extents.x + i, extent[0]);
+    _mm256_storeu_ps(out_extents.y + i, extent[1]);
+    _mm256_storeu_ps(out_extents.z + i, extent[2]);
+  }
+  TransformAabbsScalar(m, centers, extents, out_centers, out_extents, i);
+}
+
+#endif
+
+}  // namespace
+
+void MultiplyMatrices(const glm::mat4& a, std::span<const glm::mat4> b, std::span<glm::mat4> out)
+{
+  assert(b.size() == out.size());
+
+  switch (GetSimdLevel()) {
+#ifdef ENGINE_MATH_AVX2
+  case SimdLevel::Avx2:
+    return MultiplyAvx2(&a[0].x, Floats(b), Floats(out), b.size());
+#endif
+#ifdef ENGINE_MATH_SSE
+  case SimdLevel::Sse2:
+    return MultiplySse2(&a[0].x, Floats(b), Floats(out), b.size());
+#endif
+  default:
+    return MultiplyScalar(&a[0].x, Floats(b), Floats(out), b.size());
+  }
+}
+
+void TransformVectors(const glm::mat4& m, std::span<const glm::vec4> in, std::span<glm::vec4> out)
+{
+  assert(in.size() == out.size());
+
+  switch (GetSimdLevel()) {
+#ifdef ENGINE_MATH_AVX2
+  case SimdLevel::Avx2:
+    return TransformVectorsAvx2(&m[0].x, Floats(in), Floats(out), in.size());
+#endif
+#ifdef ENGINE_MATH_SSE
+  case SimdLevel::Sse2:
+    return TransformVectorsSse2(&m[0].x, Floats(in), Floats(out), in.size());
+#endif
+  default:
+    return TransformVectorsScalar(&m[0].x, Floats(in), Floats(out), in.size());
+  }
+}
+
+void TransformPoints(const glm::mat4& m, ConstVec3Span in, Vec3Span out)
+{
+  assert(in.size == out.size);
+
+  switch (GetSimdLevel()) {
+#ifdef ENGINE_MATH_AVX2
+  case SimdLevel::Avx2:
+    return TransformPointsAvx2(&m[0].x, in, out);
+#endif
+#ifdef ENGINE_MATH_SSE
+  case SimdLevel::Sse2:
+    return TransformPointsSse2(&m[0].x, in, out);
+#endif
+  default:
+    return TransformPointsScalar(&m[0].x, in, out, 0);
+  }
+}
+
+glm::mat4 QuaternionToMatrix(const glm::quat& q)
+{
+  // A single matrix is not worth a dispatch
+  glm::mat4 result;
+  QuaternionsToMatricesScalar(&q.x, &result[0].x, 1);
+  return result;
+}
+
+void QuaternionsToMatrices(std::span<const glm::quat> in, std::span<glm::mat4> out)
+{
+  assert(in.size() == out.size());
+
+  switch (GetSimdLevel()) {
+#ifdef ENGINE_MATH_AVX2
+  case SimdLevel::Avx2:
+    return QuaternionsToMatricesAvx2(Floats(in), Floats(out), in.size());
+#endif
+#ifdef ENGINE_MATH_SSE
+  case SimdLevel::Sse2:
+    return QuaternionsToMatricesSse2(Floats(in), Floats(out), in.size());
+#endif
+  default:
+    return QuaternionsToMatricesScalar(Floats(in), Floats(out), in.size());
+  }
+}
+
+Aabb TransformAabb(const glm::mat4& m, const Aabb& box)
+{
+  Aabb result;
+  TransformAabbsScalar(&m[0].x, {&box.center.x, &box.center.y, &box.center.z, 1},
+    {&box.extent.x, &box.extent.y, &box.extent.z, 1},
+    {&result.center.x, &result.center.y, &result.center.z, 1},
+    {&result.extent.x, &result.extent.y, &result.extent.z, 1}, 0);
+  return result;
+}
+
+void TransformAabbs(const glm::mat4& m, ConstVec3Span centers, ConstVec3Span extents,
+  Vec3Span out_centers, Vec3Span out_extents)
+{
+  assert(centers.size == extents.size && centers.size == out_centers.size && centers.size == out_extents.size);
+
+  switch (GetSimdLevel()) {
+#ifdef ENGINE_MATH_AVX2
+  case SimdLevel::Avx2:
+    return TransformAabbsAvx2(&m[0].x, centers, extents, out_centers, out_extents);
+#endif
+#ifdef ENGINE_MATH_SSE
+  case SimdLevel::Sse2:
+    return TransformAabbsSse2(&m[0].x, centers, extents, out_centers, out_extents);
+#endif
+  default:
+    return TransformAabbsScalar(&m[0].x, centers, extents, out_centers, out_extents, 0);
+  }
+}
+
+}  // namespace engine::math
@@ -0,0 +1,241 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "math/transform.hxx"
+
+#include "math/cpu-features.hxx"
+#include "math/kernels.hxx"
+
+#include <cassert>
+
+#ifdef ENGINE_MATH_SSE
+#include <emmintrin.h>
+#endif
+
+namespace engine::math
+{
+
+namespace
+{
+
+#ifdef ENGINE_MATH_SSE
+
+// glm::mat4 is not guaranteed 16-byte aligned, every access is unaligned
+struct Columns
+{
+  __m128 c[4];
+};
+
+Columns Load(const glm::mat4& m)
+{
+  return {{_mm_loadu_ps(&m[0].x), _mm_loadu_ps(&m[1].x), _mm_loadu_ps(&m[2].x), _mm_loadu_ps(&m[3].x)}};
+}
+
+void Store(const Columns& columns, glm::mat4& m)
+{
+  for (int i = 0; i < 4; ++i)
+    _mm_storeu_ps(&m[i].x, columns.c[i]);
+}
+
+__m128 Splat(__m128 v, int lane)
+{
+  switch (lane) {
+  case 0: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+  case 1: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+  case 2: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+  default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+}
+
+// a * v, one column of the result per call
+__m128 Transform(const Columns& a, __m128 v)
+{
+  __m128 result = _mm_mul_ps(a.c[0], Splat(v, 0));
+  result = _mm_add_ps(result, _mm_mul_ps(a.c[1], Splat(v, 1)));
+  result = _mm_add_ps(result, _mm_mul_ps(a.c[2], Splat(v, 2)));
+  return _mm_add_ps(result, _mm_mul_ps(a.c[3], Splat(v, 3)));
+}
+
+Columns Multiply(const Columns& a, const Columns& b)
+{
+  return {{Transform(a, b.c[0]), Transform(a, b.c[1]), Transform(a, b.c[2]), Transform(a, b.c[3])}};
+}
+
+// w is zero when both inputs have a zero w
+__m128 Cross(__m128 a, __m128 b)
+{
+  const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+__m128 Dot3(__m128 a, __m128 b)
+{
+  const __m128 product = _mm_mul_ps(a, b);
+  const __m128 sum = _mm_add_ps(Splat(product, 0), Splat(product, 1));
+  return _mm_add_ps(sum, Splat(product, 2));
+}
+
+// Columns of the inverse transpose of the upper 3x3: the cross products of the
+// column pairs over the determinant. Column w lanes are cleared.
+Columns InverseTranspose3(const Columns& m)
+{
+  const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  const __m128 c0 = _mm_and_ps(m.c[0], xyz);
+  const __m128 c1 = _mm_and_ps(m.c[1], xyz);
+  const __m128 c2 = _mm_and_ps(m.c[2], xyz);
+
+  const __m128 r0 = Cross(c1, c2);
+  const __m128 r1 = Cross(c2, c0);
+  const __m128 r2 = Cross(c0, c1);
+  const __m128 inverse_determinant = _mm_div_ps(_mm_set1_ps(1.f), Dot3(c0, r0));
+
+  return {{_mm_mul_ps(r0, inverse_determinant), _mm_mul_ps(r1, inverse_determinant),
+    _mm_mul_ps(r2, inverse_determinant), _mm_setr_ps(0.f, 0.f, 0.f, 1.f)}};
+}
+
+#else
+
+glm::mat4 MultiplyScalar(const glm::mat4& a, const glm::mat4& b)
+{
+  glm::mat4 result;
+  for (int column = 0; column < 4; ++column) {
+    for (int row = 0; row < 4; ++row) {
+      result[column][row] = a[0][row] * b[column][0] + a[1][row] * b[column][1]
+        + a[2][row] * b[column][2] + a[3][row] * b[column][3];
+    }
+  }
+  return result;
+}
+
+glm::vec3 Cross(const glm::vec3& a, const glm::vec3& b)
+{
+  return glm::vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+glm::mat4 InverseTranspose3(const glm::mat4& m)
+{
+  const glm::vec3 c0(m[0]), c1(m[1]), c2(m[2]);
+  const glm::vec3 r0 = Cross(c1, c2);
+  const glm::vec3 r1 = Cross(c2, c0);
+  const glm::vec3 r2 = Cross(c0, c1);
+  const float inverse_determinant = 1.f / (c0.x * r0.x + c0.y * r0.y + c0.z * r0.z);
+
+  glm::mat4 result(1.f);
+  result[0] = glm::vec4(r0 * inverse_determinant, 0.f);
+  result[1] = glm::vec4(r1 * inverse_determinant, 0.f);
+  result[2] = glm::vec4(r2 * inverse_determinant, 0.f);
+  return result;
+}
+
+#endif
+
+}  // namespace
+
+glm::mat4 Multiply(const glm::mat4& a, const glm::mat4& b)
+{
+#ifdef ENGINE_MATH_SSE
+  glm::mat4 result;
+  Store(Multiply(Load(a), Load(b)), result);
+  return result;
+#else
+  return MultiplyScalar(a, b);
+#endif
+}
+
+glm::mat4 NormalMatrix(const glm::mat4& world)
+{
+#ifdef ENGINE_MATH_SSE
+  glm::mat4 result;
+  Store(InverseTranspose3(Load(world)), result);
+  return result;
+#else
+  return InverseTranspose3(world);
+#endif
+}
+
+glm::mat4 AffineInverse(const glm::mat4& m)
+{
+#ifdef ENGINE_MATH_SSE
+  // The inverse of the 3x3 is the transpose of its inverse transpose
+  Columns inverse = InverseTranspose3(Load(m));
+  __m128 w = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(inverse.c[0], inverse.c[1], inverse.c[2], w);
+
+  const __m128 translation = _mm_loadu_ps(&m[3].x);
+  __m128 inverse_translation = _mm_mul_ps(inverse.c[0], Splat(translation, 0));
+  inverse_translation = _mm_add_ps(inverse_translation, _mm_mul_ps(inverse.c[1], Splat(translation, 1)));
+  inverse_translation = _mm_add_ps(inverse_translation, _mm_mul_ps(inverse.c[2], Splat(translation, 2)));
+  inverse.c[3] = _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), inverse_translation);
+
+  glm::mat4 result;
+  Store(inverse, result);
+  return result;
+#else
+  const glm::mat4 normal = InverseTranspose3(m);
+  glm::mat4 result(1.f);
+  for (int column = 0; column < 3; ++column) {
+    for (int row = 0; row < 3; ++row)
+      result[column][row] = normal[row][column];
+  }
+  for (int row = 0; row < 3; ++row)
+    result[3][row] = -(result[0][row] * m[3].x + result[1][row] * m[3].y + result[2][row] * m[3].z);
+  return result;
+#endif
+}
+
+ViewTransforms ComposeView(const glm::mat4& view, const glm::mat4& projection)
+{
+  ViewTransforms transforms;
+  transforms.view = view;
+  transforms.projection = projection;
+  transforms.view_projection = Multiply(projection, view);
+  transforms.inverse_view = AffineInverse(view);
+  // Once per frame, the general inverse is not worth a SIMD path
+  transforms.inverse_view_projection = Multiply(transforms.inverse_view, glm::inverse(projection));
+  return transforms;
+}
+
+void ComposeObjects(const glm::mat4& view_projection, std::span<const glm::mat4> worlds,
+  std::span<ObjectTransforms> out)
+{
+  assert(worlds.size() == out.size());
+
+#ifdef ENGINE_MATH_SSE
+  const Columns clip = Load(view_projection);
+  for (size_t i = 0; i < worlds.size(); ++i) {
+    const Columns world = Load(worlds[i]);
+    Store(Multiply(clip, world), out[i].world_view_projection);
+    Store(world, out[i].world);
+    Store(InverseTranspose3(world), out[i].normal);
+  }
+#else
+  for (size_t i = 0; i < worlds.size(); ++i) {
+    out[i].world_view_projection = MultiplyScalar(view_projection, worlds[i]);
+    out[i].world = worlds[i];
+    out[i].normal = InverseTranspose3(worlds[i]);
+  }
+#endif
+}
+
+void ComposeWorldViewProjection(const glm::mat4& view_projection, std::span<const glm::mat4> worlds,
+  std::span<glm::mat4> out)
+{
+  MultiplyMatrices(view_projection, worlds, out);
+}
+
+}  // namespace engine::math
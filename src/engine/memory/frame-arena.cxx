@@ -0,0 +1,140 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "memory/frame-arena.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine::memory
+{
+
+namespace
+{
+
+constexpr size_t kBlockAlignment = 64;
+
+// Arena ids are never reused, so a thread cache can not outlive its arena unnoticed
+std::atomic<uint64_t> g_next_arena_id = 1;
+
+}  // namespace
+
+LinearArena::LinearArena(size_t block_size)
+ : m_block_size(block_size)
+{}
+
+LinearArena::~LinearArena()
+{
+  for (Block& block : m_blocks)
+    ::operator delete(block.memory, std::align_val_t(kBlockAlignment));
+}
+
+void* LinearArena::AllocateSlow(size_t size, size_t alignment)
+{
+  // Blocks kept from previous frames come first, too small ones are skipped until the next reset
+  const size_t required = size + alignment - 1;
+  while (m_next < m_blocks.size() && m_blocks[m_next].size < required)
+    ++m_next;
+
+  if (m_next == m_blocks.size()) {
+    Block block;
+    block.size = std::max(m_block_size, required);
+    block.memory = static_cast<std::byte*>(::operator new(block.size, std::align_val_t(kBlockAlignment)));
+    m_blocks.push_back(block);
+  }
+
+  const Block& block = m_blocks[m_next++];
+  m_cursor = reinterpret_cast<uintptr_t>(block.memory);
+  m_end = m_cursor + block.size;
+  return Allocate(size, alignment);
+}
+
+void LinearArena::Reset(bool poison)
+{
+  if (poison) {
+    for (size_t i = 0; i < m_next; ++i)
+      std::memset(m_blocks[i].memory, kPoisonByte, m_blocks[i].size);
+  }
+
+  m_next = 0;
+  m_cursor = 0;
+  m_end = 0;
+  m_allocated = 0;
+}
+
+size_t LinearArena::BytesReserved() const
+{
+  size_t reserved = 0;
+  for (const Block& block : m_blocks)
+    reserved += block.size;
+  return reserved;
+}
+
+void* FrameMemoryResource::do_allocate(size_t bytes, size_t alignment)
+{
+  return m_arena.Allocate(bytes, alignment);
+}
+
+FrameArena::FrameArena(size_t block_size)
+ : m_id(g_next_arena_id.fetch_add(1)), m_block_size(block_size), m_resource(*this)
+{}
+
+FrameArena::ThreadArenas& FrameArena::RegisterThread()
+{
+  std::lock_guard lock(m_threads_mutex);
+
+  std::thread::id thread = std::this_thread::get_id();
+  auto it = std::find_if(m_threads.begin(), m_threads.end(), [thread](const ThreadEntry& entry) { return entry.thread == thread; });
+  if (it == m_threads.end()) {
+    auto arenas = std::make_unique<ThreadArenas>();
+    for (LinearArena& arena : *arenas)
+      arena.SetBlockSize(m_block_size);
+    m_threads.push_back({thread, std::move(arenas)});
+    it = m_threads.end() - 1;
+  }
+
+  t_cache = {m_id, it->arenas.get()};
+  return *it->arenas;
+}
+
+void FrameArena::EndFrame()
+{
+  size_t next = (m_slot.load(std::memory_order_relaxed) + 1) % kFramesInFlight;
+
+  std::lock_guard lock(m_threads_mutex);
+  for (ThreadEntry& entry : m_threads)
+    (*entry.arenas)[next].Reset(m_poison);
+
+  m_slot.store(next, std::memory_order_relaxed);
+  ++m_frame;
+}
+
+FrameArena::Stats FrameArena::GetStats() const
+{
+  std::lock_guard lock(m_threads_mutex);
+
+  Stats stats;
+  size_t slot = m_slot.load(std::memory_order_relaxed);
+  stats.threads = m_threads.size();
+  for (const ThreadEntry& entry : m_threads) {
+    stats.bytes_allocated += (*entry.arenas)[slot].BytesAllocated();
+    for (const LinearArena& arena : *entry.arenas)
+      stats.bytes_reserved += arena.BytesReserved();
+  }
+  return stats;
+}
+
+}  // namespace engine::memory
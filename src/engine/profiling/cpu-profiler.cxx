@@ -0,0 +1,163 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "profiling/cpu-profiler.hxx"
+
+#include "core/exceptions.hxx"
+#include "profiling/json.hxx"
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+
+namespace engine::profiling
+{
+
+std::vector<CpuEvent> CpuThreadBuffer::Snapshot() const
+{
+  uint64_t written = m_written.load(std::memory_order_acquire);
+  uint64_t first = written > kCapacity ? written - kCapacity : 0;
+
+  std::vector<CpuEvent> events;
+  events.reserve(written - first);
+  for (uint64_t i = first; i < written; ++i)
+    events.push_back(m_events[i & (kCapacity - 1)]);
+
+  // The owning thread kept pushing meanwhile. Index n reuses the slot of
+  // n - kCapacity and is written before it is published, so everything below
+  // the published count + 1 - kCapacity may have been overwritten during the copy.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint64_t published = m_written.load(std::memory_order_relaxed);
+  const uint64_t intact = published + 1 > kCapacity ? published + 1 - kCapacity : 0;
+  if (intact > first)
+    events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(std::min(intact, written) - first));
+
+  return events;
+}
+
+std::string CpuThreadBuffer::Name() const
+{
+  std::lock_guard lock(m_name_mutex);
+  return m_name;
+}
+
+void CpuThreadBuffer::SetName(std::string name)
+{
+  std::lock_guard lock(m_name_mutex);
+  m_name = std::move(name);
+}
+
+CpuProfiler& CpuProfiler::Instance()
+{
+  static CpuProfiler profiler;
+  return profiler;
+}
+
+CpuProfiler::CpuProfiler()
+ : m_start_ticks(Now()), m_start_time(std::chrono::steady_clock::now())
+{}
+
+CpuThreadBuffer* CpuProfiler::RegisterThread()
+{
+  std::lock_guard lock(m_threads_mutex);
+  uint32_t index = static_cast<uint32_t>(m_threads.size());
+  m_threads.push_back(std::make_unique<CpuThreadBuffer>(index));
+  m_threads.back()->SetName("thread " + std::to_string(index));
+  return m_threads.back().get();
+}
+
+void CpuProfiler::SetThreadName(const char* name)
+{
+  LocalBuffer().SetName(name);
+}
+
+void CpuProfiler::MarkFrame()
+{
+  uint64_t now = Now();
+  CpuThreadBuffer& buffer = LocalBuffer();
+  buffer.Push({"frame", now, now, CpuEventType::Frame, buffer.depth});
+  m_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+double CpuProfiler::TicksPerMicrosecond() const
+{
+  // Calibrated against steady_clock over the whole profiler lifetime, no sleep needed
+  uint64_t ticks = Now() - m_start_ticks;
+  double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start_time).count();
+  return microseconds > 0.0 ? ticks / microseconds : 1.0;
+}
+
+void CpuProfiler::WriteChromeTrace(std::ostream& stream) const
+{
+  const double ticks_per_us = TicksPerMicrosecond();
+  auto to_us = [this, ticks_per_us](uint64_t ticks)
+  {
+    return ticks < m_start_ticks ? 0.0 : (ticks - m_start_ticks) / ticks_per_us;
+  };
+
+  std::vector<CpuThreadBuffer*> threads;
+  {
+    std::lock_guard lock(m_threads_mutex);
+    for (const std::unique_ptr<CpuThreadBuffer>& thread : m_threads)
+      threads.push_back(thread.get());
+  }
+
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separator = [&first, &stream]
+  {
+    stream << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  stream.setf(std::ios::fixed);
+  stream.precision(3);
+
+  for (const CpuThreadBuffer* thread : threads) {
+    const uint32_t tid = thread->ThreadIndex();
+
+    separator();
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid << ",\"args\":{\"name\":";
+    WriteJsonString(stream, thread->Name());
+    stream << "}}";
+
+    for (const CpuEvent& event : thread->Snapshot()) {
+      separator();
+      stream << "{\"name\":";
+      WriteJsonString(stream, event.name);
+      if (event.type == CpuEventType::Frame) {
+        stream << ",\"ph\":\"i\",\"s\":\"g\",\"cat\":\"frame\"";
+      }
+      else {
+        stream << ",\"ph\":\"X\",\"cat\":\"cpu\",\"dur\":" << to_us(event.end) - to_us(event.begin);
+      }
+      stream << ",\"ts\":" << to_us(event.begin) << ",\"pid\":0,\"tid\":" << tid << "}";
+    }
+  }
+
+  stream << "\n]}\n";
+}
+
+void CpuProfiler::ExportChromeTrace(const std::filesystem::path& path) const
+{
+  std::ofstream stream(path);
+  if (!stream)
+    throw RuntimeError("Failed to open " + path.string());
+
+  WriteChromeTrace(stream);
+}
+
+}  // namespace engine::profiling
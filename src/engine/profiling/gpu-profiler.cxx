@@ -0,0 +1,326 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "profiling/gpu-profiler.hxx"
+
+#include "core/exceptions.hxx"
+#include "profiling/json.hxx"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+
+namespace engine::profiling
+{
+
+namespace
+{
+
+constexpr double kNanosecondsPerMillisecond = 1'000'000.0;
+constexpr double kStartSmoothing = 0.1;
+
+ImU32 NameColor(const char* name)
+{
+  // FNV-1a, only used to give every scope a stable color
+  uint32_t hash = 2166136261u;
+  for (const char* c = name; *c; ++c)
+    hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+
+  return IM_COL32(96 + (hash & 0x7f), 96 + ((hash >> 8) & 0x7f), 96 + ((hash >> 16) & 0x7f), 255);
+}
+
+}  // namespace
+
+GpuProfiler::GpuProfiler()
+{
+  m_nodes.reserve(32);
+  m_stack.reserve(16);
+}
+
+void GpuProfiler::BeginFrame()
+{
+  m_current_slot = m_frame % kFramesInFlight;
+  FrameSlot& slot = m_slots[m_current_slot];
+
+  if (slot.pending) {
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(slot.queries[slot.used_queries - 1].Get(), GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_TRUE)
+      Resolve(slot);
+    else
+      ++m_dropped_frames;
+  }
+
+  slot.used_queries = 0;
+  slot.scopes.clear();
+  slot.pending = false;
+  slot.frame = m_frame;
+
+  m_stack.clear();
+  m_in_frame = m_enabled;
+  PushScope("frame");
+}
+
+void GpuProfiler::EndFrame()
+{
+  if (!m_in_frame)
+    return;
+
+  // Close the root and anything left open by an unbalanced push
+  while (!m_stack.empty())
+    PopScope();
+
+  m_slots[m_current_slot].pending = true;
+  m_in_frame = false;
+  ++m_frame;
+}
+
+void GpuProfiler::PushScope(const char* name)
+{
+  if (!m_in_frame)
+    return;
+
+  FrameSlot& slot = m_slots[m_current_slot];
+  int parent = m_stack.empty() ? -1 : slot.scopes[m_stack.back()].node;
+
+  ScopeRecord record;
+  record.node = FindOrAddNode(parent, name);
+  record.begin_query = IssueTimestamp(slot);
+
+  m_stack.push_back(static_cast<int>(slot.scopes.size()));
+  slot.scopes.push_back(record);
+}
+
+void GpuProfiler::PopScope()
+{
+  if (!m_in_frame || m_stack.empty())
+    return;
+
+  FrameSlot& slot = m_slots[m_current_slot];
+  slot.scopes[m_stack.back()].end_query = IssueTimestamp(slot);
+  m_stack.pop_back();
+}
+
+uint32_t GpuProfiler::IssueTimestamp(FrameSlot& slot)
+{
+  if (slot.used_queries == slot.queries.size())
+    slot.queries.push_back(gl::QueryHandle::Create(GL_TIMESTAMP));
+
+  glQueryCounter(slot.queries[slot.used_queries].Get(), GL_TIMESTAMP);
+  return slot.used_queries++;
+}
+
+int GpuProfiler::FindOrAddNode(int parent, const char* name)
+{
+  // Children are few, a linear scan beats any map here
+  for (size_t i = parent + 1; i < m_nodes.size(); ++i) {
+    const Node& node = m_nodes[i];
+    if (node.parent == parent && (node.name == name || std::strcmp(node.name, name) == 0))
+      return static_cast<int>(i);
+  }
+
+  Node node;
+  node.name = name;
+  node.parent = parent;
+  node.depth = parent < 0 ? 0 : m_nodes[parent].depth + 1;
+
+  // Keep every subtree contiguous so that a parent precedes its children
+  size_t position = m_nodes.size();
+  if (parent >= 0) {
+    position = parent + 1;
+    while (position < m_nodes.size() && m_nodes[position].depth > m_nodes[parent].depth)
+      ++position;
+  }
+
+  m_nodes.insert(m_nodes.begin() + position, node);
+  for (Node& other : m_nodes) {
+    if (other.parent >= static_cast<int>(position))
+      ++other.parent;
+  }
+
+  // Indices of in-flight records past the insertion point are shifted as well
+  for (FrameSlot& slot : m_slots) {
+    for (ScopeRecord& record : slot.scopes) {
+      if (record.node >= static_cast<int>(position))
+        ++record.node;
+    }
+  }
+
+  return static_cast<int>(position);
+}
+
+void GpuProfiler::Resolve(FrameSlot& slot)
+{
+  std::vector<GLuint64> timestamps(slot.used_queries);
+  for (uint32_t i = 0; i < slot.used_queries; ++i)
+    glGetQueryObjectui64v(slot.queries[i].Get(), GL_QUERY_RESULT, &timestamps[i]);
+
+  const GLuint64 frame_start = timestamps[slot.scopes.front().begin_query];
+
+  // The same scope may be entered several times per frame, its durations are summed
+  std::vector<double> starts(m_nodes.size(), -1.0);
+  std::vector<double> durations(m_nodes.size(), 0.0);
+  for (const ScopeRecord& record : slot.scopes) {
+    double start = (timestamps[record.begin_query] - frame_start) / kNanosecondsPerMillisecond;
+    double duration = (timestamps[record.end_query] - timestamps[record.begin_query]) / kNanosecondsPerMillisecond;
+    if (starts[record.node] < 0.0)
+      starts[record.node] = start;
+    durations[record.node] += duration;
+  }
+
+  ++m_resolved_frames;
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    if (starts[i] >= 0.0)
+      Accumulate(m_nodes[i], starts[i], durations[i]);
+  }
+
+  m_frame_average_ms = m_nodes.front().average_ms;
+}
+
+void GpuProfiler::Accumulate(Node& node, double start_ms, double duration_ms)
+{
+  node.start_ms = start_ms;
+  node.duration_ms = duration_ms;
+  node.average_start_ms = node.history_size == 0
+    ? start_ms
+    : node.average_start_ms + (start_ms - node.average_start_ms) * kStartSmoothing;
+
+  node.history[node.history_head] = static_cast<float>(duration_ms);
+  node.history_head = (node.history_head + 1) % kHistorySize;
+  node.history_size = std::min(node.history_size + 1, kHistorySize);
+  node.last_frame = m_resolved_frames;
+
+  double sum = 0.0;
+  double max = 0.0;
+  for (size_t i = 0; i < node.history_size; ++i) {
+    sum += node.history[i];
+    max = std::max<double>(max, node.history[i]);
+  }
+  node.average_ms = sum / node.history_size;
+  node.max_ms = max;
+}
+
+void GpuProfiler::DrawImGui(const char* window_name) const
+{
+  ImGui::Begin(window_name);
+
+  ImGui::Text("GPU frame: %.3f ms (resolved %llu, dropped %llu)", m_frame_average_ms,
+    static_cast<unsigned long long>(m_resolved_frames), static_cast<unsigned long long>(m_dropped_frames));
+
+  if (m_nodes.empty() || m_frame_average_ms <= 0.0) {
+    ImGui::End();
+    return;
+  }
+
+  auto is_stale = [this](const Node& node) { return node.last_frame + kHistorySize < m_resolved_frames; };
+
+  // Flame graph: one row per depth, bar offsets and widths from the rolling averages
+  const float row_height = ImGui::GetTextLineHeightWithSpacing();
+  const ImVec2 origin = ImGui::GetCursorScreenPos();
+  const float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+  const float scale = width / static_cast<float>(m_frame_average_ms);
+
+  int max_depth = 0;
+  ImDrawList* draw_list = ImGui::GetWindowDrawList();
+  for (const Node& node : m_nodes) {
+    if (is_stale(node))
+      continue;
+
+    max_depth = std::max(max_depth, node.depth);
+    ImVec2 min(origin.x + static_cast<float>(node.average_start_ms) * scale, origin.y + node.depth * row_height);
+    ImVec2 max(min.x + std::max(static_cast<float>(node.average_ms) * scale, 1.f), min.y + row_height - 1.f);
+
+    draw_list->AddRectFilled(min, max, NameColor(node.name));
+    draw_list->PushClipRect(min, max, true);
+    draw_list->AddText(ImVec2(min.x + 2.f, min.y), IM_COL32(0, 0, 0, 255), node.name);
+    draw_list->PopClipRect();
+
+    if (ImGui::IsMouseHoveringRect(min, max))
+      ImGui::SetTooltip("%s\navg %.3f ms\nmax %.3f ms", node.name, node.average_ms, node.max_ms);
+  }
+  ImGui::Dummy(ImVec2(width, (max_depth + 1) * row_height));
+
+  if (ImGui::BeginTable("gpu-scopes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Avg, ms");
+    ImGui::TableSetupColumn("Last, ms");
+    ImGui::TableSetupColumn("Max, ms");
+    ImGui::TableHeadersRow();
+
+    for (const Node& node : m_nodes) {
+      if (is_stale(node))
+        continue;
+
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%*s%s", node.depth * 2, "", node.name);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", node.average_ms);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", node.duration_ms);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", node.max_ms);
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::End();
+}
+
+void GpuProfiler::WriteJson(std::ostream& stream) const
+{
+  stream << "{\n";
+  stream << "  \"frames_resolved\": " << m_resolved_frames << ",\n";
+  stream << "  \"frames_dropped\": " << m_dropped_frames << ",\n";
+  stream << "  \"frame_average_ms\": " << m_frame_average_ms << ",\n";
+  stream << "  \"scopes\": [";
+
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    const Node& node = m_nodes[i];
+    stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    WriteJsonString(stream, node.name);
+    stream << ", \"parent\": " << node.parent
+           << ", \"depth\": " << node.depth
+           << ", \"average_start_ms\": " << node.average_start_ms
+           << ", \"average_ms\": " << node.average_ms
+           << ", \"last_ms\": " << node.duration_ms
+           << ", \"max_ms\": " << node.max_ms
+           << ", \"history_ms\": [";
+
+    // Oldest sample first
+    size_t first = node.history_size < kHistorySize ? 0 : node.history_head;
+    for (size_t j = 0; j < node.history_size; ++j)
+      stream << (j == 0 ? "" : ", ") << node.history[(first + j) % kHistorySize];
+
+    stream << "]}";
+  }
+
+  stream << "\n  ]\n}\n";
+}
+
+void GpuProfiler::ExportJson(const std::filesystem::path& path) const
+{
+  std::ofstream stream(path);
+  if (!stream)
+    throw RuntimeError("Failed to open " + path.string());
+
+  WriteJson(stream);
+}
+
+}  // namespace engine::profiling
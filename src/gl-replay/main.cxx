@@ -0,0 +1,250 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+// Replays a capture recorded with ENGINE_GL_CAPTURE as fast as possible in a
+// hidden window and reports the CPU cost of every GL call type.
+//
+// gl-replay <capture> [--loops N] [--finish] [--swap] [--csv <out>] [--compare <baseline csv>]
+//
+// --compare prints the per-call difference against a CSV written by an earlier
+// run, e.g. on another driver, to A/B driver overhead on the same call stream.
+
+#include "gl/command-capture.hxx"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+struct Options
+{
+  std::string capture;
+  int loops = 100;
+  bool finish = false;
+  bool swap = false;
+  std::string csv;
+  std::string compare;
+};
+
+struct Row
+{
+  std::string name;
+  uint64_t count = 0;
+  double total_ns = 0.0;
+};
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+  for (int i = 1; i < argc; ++i) {
+    bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--loops") == 0 && has_value)
+      options.loops = std::max(1, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--finish") == 0)
+      options.finish = true;
+    else if (std::strcmp(argv[i], "--swap") == 0)
+      options.swap = true;
+    else if (std::strcmp(argv[i], "--csv") == 0 && has_value)
+      options.csv = argv[++i];
+    else if (std::strcmp(argv[i], "--compare") == 0 && has_value)
+      options.compare = argv[++i];
+    else if (options.capture.empty() && argv[i][0] != '-')
+      options.capture = argv[i];
+    else
+      return false;
+  }
+  return !options.capture.empty();
+}
+
+template<class T>
+bool ParseField(std::string_view text, T& value)
+{
+  auto [last, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == std::errc() && last == text.data() + text.size();
+}
+
+// call,count,total_ns rows as written by --csv, throws on anything else
+std::map<std::string, Row> ReadCsv(const std::string& path)
+{
+  std::ifstream stream(path);
+  if (!stream)
+    throw std::runtime_error("Failed to open baseline " + path);
+
+  std::map<std::string, Row> rows;
+  std::string line;
+  std::getline(stream, line);  // header
+  for (size_t number = 2; std::getline(stream, line); ++number) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty())
+      continue;
+
+    const size_t first = line.find(',');
+    const size_t second = first == std::string::npos ? first : line.find(',', first + 1);
+    Row row;
+    if (second == std::string::npos || first == 0
+      || !ParseField(std::string_view(line).substr(first + 1, second - first - 1), row.count)
+      || !ParseField(std::string_view(line).substr(second + 1), row.total_ns))
+      throw std::runtime_error(path + ":" + std::to_string(number) + ": expected call,count,total_ns, got " + line);
+
+    row.name = line.substr(0, first);
+    rows[row.name] = row;
+  }
+  return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::printf("Usage: gl-replay <capture> [--loops N] [--finish] [--swap] [--csv <out>] [--compare <baseline csv>]\n");
+    return 1;
+  }
+
+  // Read up front, a bad baseline should not cost a whole replay
+  std::map<std::string, Row> baseline;
+  try {
+    if (!options.compare.empty())
+      baseline = ReadCsv(options.compare);
+  }
+  catch (const std::exception& error) {
+    std::printf("%s\n", error.what());
+    return 1;
+  }
+
+  if (glfwInit() != GLFW_TRUE)
+    return -1;
+
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+  GLFWwindow* window = glfwCreateWindow(800, 600, "gl-replay", NULL, NULL);
+  if (!window) {
+    glfwTerminate();
+    return -1;
+  }
+
+  glfwMakeContextCurrent(window);
+  glfwSwapInterval(0);
+
+  if (gladLoadGL() == 0)
+    return -1;
+
+  std::vector<Row> rows;
+  double wall_ms = 0.0;
+  uint64_t frames = 0;
+
+  try {
+    engine::gl::CommandReplayer replayer(options.capture);
+    std::printf("%s: %u frames, renderer %s\n", options.capture.c_str(), replayer.FrameCount(), glGetString(GL_RENDERER));
+
+    replayer.SetMeasure(false);
+    replayer.ReplaySetup();
+    glFinish();
+
+    auto on_frame = [&options, window, &frames]
+    {
+      if (options.finish)
+        glFinish();
+      if (options.swap)
+        glfwSwapBuffers(window);
+      ++frames;
+    };
+
+    // The first loop warms up driver caches and is not measured
+    replayer.ReplayFrames(on_frame);
+    frames = 0;
+
+    replayer.SetMeasure(true);
+    replayer.ResetStats();
+    auto start = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < options.loops; ++loop)
+      replayer.ReplayFrames(on_frame);
+    glFinish();
+    wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    for (size_t call = 0; call < replayer.Stats().size(); ++call) {
+      const auto& stats = replayer.Stats()[call];
+      if (stats.count > 0)
+        rows.push_back({std::string(engine::gl::CommandReplayer::CallName(call)), stats.count, stats.total_ns});
+    }
+  }
+  catch (const std::exception& error) {
+    std::printf("%s\n", error.what());
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 1;
+  }
+
+  glfwDestroyWindow(window);
+  glfwTerminate();
+
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.total_ns > b.total_ns; });
+
+  double calls_ns = 0.0;
+  uint64_t calls = 0;
+  for (const Row& row : rows) {
+    calls_ns += row.total_ns;
+    calls += row.count;
+  }
+
+  std::printf("%llu frames in %.2f ms (%.3f ms/frame), %llu calls, %.2f ms in GL calls\n\n",
+    static_cast<unsigned long long>(frames), wall_ms, frames ? wall_ms / frames : 0.0,
+    static_cast<unsigned long long>(calls), calls_ns / 1e6);
+
+  std::printf("%-32s %12s %12s %10s", "call", "count", "total ms", "ns/call");
+  if (!baseline.empty())
+    std::printf(" %12s %8s", "base ns/call", "delta");
+  std::printf("\n");
+
+  for (const Row& row : rows) {
+    double per_call = row.total_ns / row.count;
+    std::printf("%-32s %12llu %12.3f %10.1f", row.name.c_str(), static_cast<unsigned long long>(row.count), row.total_ns / 1e6, per_call);
+
+    auto base = baseline.find(row.name);
+    if (base != baseline.end() && base->second.count > 0) {
+      double base_per_call = base->second.total_ns / base->second.count;
+      std::printf(" %12.1f %+7.1f%%", base_per_call, (per_call / base_per_call - 1.0) * 100.0);
+    }
+    std::printf("\n");
+  }
+
+  if (!options.csv.empty()) {
+    std::ofstream csv(options.csv);
+    csv << "call,count,total_ns\n";
+    for (const Row& row : rows)
+      csv << row.name << ',' << row.count << ',' << row.total_ns << '\n';
+  }
+
+  return 0;
+}
@@ -15,6 +15,11 @@
 *************************************************************************/
 
 #include "hello-camera/hello-camera.hxx"
+#include "hello-camera/shaders.hxx"
+
+#include "math/frustum.hxx"
+#include "math/transform.hxx"
+#include "profiling/cpu-profiler.hxx"
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -25,6 +30,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <cmath>
+#include <iterator>
 #include <numbers>
 
 HelloCamera::HelloCamera()
@@ -45,30 +51,28 @@ HelloCamera::HelloCamera()
   ImGui_ImplOpenGL3_Init();
 
   LoadAssets();
-
-  glEnable(GL_DEPTH_TEST);
 }
 
-void HelloCamera::LoadAssets()
+static engine::gl::Texture LoadTexture(const std::filesystem::path& path)
 {
-  GLuint texture = -1;
-  glGenTextures(1, &texture);
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, texture);
-  ProcessImage(GetCurrentExecutableDirectory() / "assets/textures/LearnOpenGL/container.jpg", [](stb::Image& image)
+  engine::gl::Texture texture;
+  ProcessImage(path, [&texture](stb::Image& image)
     {
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image.Width(), image.Height(), 0, GL_RGB, GL_UNSIGNED_BYTE, image.Bytes());
+      texture = engine::gl::Texture(GL_TEXTURE_2D, 0, GL_RGB8, image.Width(), image.Height());
+      texture.Upload(0, 0, GL_RGB, GL_UNSIGNED_BYTE, image.Bytes());
     });
-  glGenerateMipmap(GL_TEXTURE_2D);
+  texture.GenerateMipmaps();
+  return texture;
+}
 
-  glGenTextures(1, &texture);
-  glActiveTexture(GL_TEXTURE1);
-  glBindTexture(GL_TEXTURE_2D, texture);
-  ProcessImage(GetCurrentExecutableDirectory() / "assets/textures/DebugTextures/texture1024.png", [](stb::Image& image)
-    {
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image.Width(), image.Height(), 0, GL_RGB, GL_UNSIGNED_BYTE, image.Bytes());
-    });
-  glGenerateMipmap(GL_TEXTURE_2D);
+void HelloCamera::LoadAssets()
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  m_box_texture = LoadTexture(GetCurrentExecutableDirectory() / "assets/textures/LearnOpenGL/container.jpg");
+  m_skybox_texture = LoadTexture(GetCurrentExecutableDirectory() / "assets/textures/DebugTextures/texture1024.png");
+  m_box_texture_index = m_texture_table.Add(m_box_texture);
+  m_skybox_texture_index = m_texture_table.Add(m_skybox_texture);
 
   for (tinyobj::index_t index : m_model->Shapes()[0].mesh.indices)
   {
@@ -76,87 +80,49 @@ void HelloCamera::LoadAssets()
     m_texcoords.push_back({m_model->Attrib().texcoords[2 * index.texcoord_index], m_model->Attrib().texcoords[2 * index.texcoord_index + 1]});
   }
 
-  GLuint vbo[2];
-  glGenBuffers(2, vbo);
-
-  glGenVertexArrays(1, &m_vao);
-  glBindVertexArray(m_vao);
-
-  glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
-  glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(m_vertices[0]), m_vertices.data(), GL_STATIC_DRAW);
-
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(0);
-
-  glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
-  glBufferData(GL_ARRAY_BUFFER, m_texcoords.size() * sizeof(m_texcoords[0]), m_texcoords.data(), GL_STATIC_DRAW);
-
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(1);
-
-  const GLchar* vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-out vec2 texCoord;
-uniform mat4 rotation_y;
-uniform mat4 rotation_z;
-uniform mat4 translation;
-uniform mat4 projection;
-uniform mat4 camera;
-uniform float scale;
-uniform bool is_skybox;
-
-void main()
-{
-  if (is_skybox)
-  {
-    gl_Position = projection * camera * vec4(100.0 * aPos, 1.0);
+  glm::vec3 min(m_vertices.front().x, m_vertices.front().y, m_vertices.front().z);
+  glm::vec3 max = min;
+  for (const Vec3& vertex : m_vertices) {
+    min = glm::min(min, glm::vec3(vertex.x, vertex.y, vertex.z));
+    max = glm::max(max, glm::vec3(vertex.x, vertex.y, vertex.z));
   }
-  else
-  {
-    gl_Position = projection * camera * translation * rotation_z * rotation_y * vec4(scale * aPos, 1.0);
-  }
-
-  texCoord = aTexCoord;
-}
-)";
-
-  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-  glCompileShader(vertexShader);
-
-  //FragColor = texture(ourTexture, texCoord);
-  const GLchar* fragmentShaderSource = R"(
-#version 330 core
-in vec2 texCoord;
-out vec4 FragColor;
-uniform sampler2D woodenBox;
-uniform sampler2D skybox;
-uniform bool is_skybox;
-void main()
-{
-  if (is_skybox)
-  {
-    FragColor = texture(skybox, texCoord);
-  }
-  else
-  {
-    FragColor = texture(woodenBox, texCoord);
-  }
-}
-)";
-
-  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-  glCompileShader(fragmentShader);
-
-  m_program = glCreateProgram();
-
-  glAttachShader(m_program, vertexShader);
-  glAttachShader(m_program, fragmentShader);
-
-  glLinkProgram(m_program);
+  m_box_bounds = {(min + max) / 2.f, (max - min) / 2.f};
+  m_box_object = m_culler.Add(m_box_bounds.center, glm::length(m_box_bounds.extent), m_box_bounds.extent);
+
+  m_vertex_buffer = engine::gl::Buffer(std::span<const Vec3>(m_vertices));
+  m_texcoord_buffer = engine::gl::Buffer(std::span<const Vec2>(m_texcoords));
+
+  m_vertex_array.SetVertexBuffer(0, m_vertex_buffer, 0, sizeof(Vec3));
+  m_vertex_array.SetAttribute(0, 0, 3, GL_FLOAT, 0);
+  m_vertex_array.SetVertexBuffer(1, m_texcoord_buffer, 0, sizeof(Vec2));
+  m_vertex_array.SetAttribute(1, 1, 2, GL_FLOAT, 0);
+
+  const std::string vertexShaderSource = "#version 460 core\n" + ObjectBlock::Glsl()
+    + std::string(shaders::kSceneVert.source);
+  const std::string fragmentShaderSource = "#version 460 core\n" + m_texture_table.Glsl(kTextureTableSlot)
+    + ObjectBlock::Glsl() + std::string(shaders::kSceneFrag.source);
+
+  m_shaders = std::make_unique<engine::gl::ShaderPermutations>(std::initializer_list<engine::gl::ShaderStage>{
+    {GL_VERTEX_SHADER, vertexShaderSource},
+    {GL_FRAGMENT_SHADER, fragmentShaderSource},
+  }, &GetProgramCache());
+
+  // The box and the skybox differ only by their matrices and textures, one variant
+  // draws both. The untextured one shows the texture coordinates instead.
+  const engine::gl::ShaderPermutations::Key variants[] = {m_shaders->Variant({}), m_shaders->Variant({"UNTEXTURED"})};
+  m_shaders->Precompile(variants);
+
+  engine::gl::Pipeline pipeline;
+  pipeline.vertex_array = m_vertex_array.Get();
+  pipeline.program = m_shaders->Get(variants[0]).Get();
+  m_pipeline = m_render_queue.AddPipeline(pipeline);
+  pipeline.program = m_shaders->Get(variants[1]).Get();
+  m_untextured_pipeline = m_render_queue.AddPipeline(pipeline);
+
+  // Textures are selected per object through the table, the material binds none
+  m_material = m_render_queue.AddMaterial({});
+
+  m_render_queue.SetObjectBuffer(GL_UNIFORM_BUFFER, ObjectBlock::kBinding, m_object_ring.Get(), sizeof(ObjectBlock));
 }
 
 HelloCamera::~HelloCamera()
@@ -170,24 +136,28 @@ constexpr float Radians(float degrees) {
   return std::numbers::pi_v<float> / 180.f * degrees;
 }
 
+static glm::mat4 Scale(float scale)
+{
+  glm::mat4 result(scale);
+  result[3][3] = 1.f;
+  return result;
+}
+
 void HelloCamera::OnUpdate()
 {
-  auto endTime = std::chrono::steady_clock::now();
-  float dt = std::chrono::duration<float>(endTime - m_startTime).count();
-  m_startTime = endTime;
+  ENGINE_PROFILE_FUNCTION();
+
+  float dt = GetDeltaTime();
 
   m_camera.OnFrame(*this, dt);
 
   m_angle = std::fmodf(m_angle + m_speed * dt, 2.f * std::numbers::pi_v<float>);
 
-  glUseProgram(m_program);
-
-  GLuint rotationLoc = glGetUniformLocation(m_program, "rotation");
-  GLuint scaleLoc = glGetUniformLocation(m_program, "scale");
+  engine::gl::StateCache& state = GetStateCache();
 
-  int window_width = 0, window_height = 0;
-  glfwGetWindowSize(GetWindow(), &window_width, &window_height);
-  float aspect = (float)window_width / (float)window_height;
+  // Tracked from the input queue, frames may run off the main thread
+  const glm::ivec2 window = GetInput().WindowSize();
+  float aspect = window.y > 0 ? (float)window.x / (float)window.y : 1.f;
 
   float range_z = m_far_z - m_near_z;
   float projection_fov = 1.f / std::tanf(Radians(m_fov / 2.f));
@@ -222,21 +192,67 @@ void HelloCamera::OnUpdate()
 
   glm::mat4 camera = m_camera.GetViewTransform();
 
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "rotation_z"), 1, GL_TRUE, glm::value_ptr(rotation_z));
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "rotation_y"), 1, GL_TRUE, glm::value_ptr(rotation_y));
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "projection"), 1, GL_TRUE, glm::value_ptr(projection));
-  glUniform1f(glGetUniformLocation(m_program, "scale"), m_cube_scale);
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "translation"), 1, GL_TRUE, glm::value_ptr(translation));
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "camera"), 1, GL_TRUE, glm::value_ptr(camera));
+  // The matrices above are written row by row, GLSL expects columns. Everything
+  // is composed here once per object instead of once per vertex.
+  const glm::mat4 view_projection = engine::math::Multiply(glm::transpose(projection), glm::transpose(camera));
+  const glm::mat4 box_world = engine::math::Multiply(glm::transpose(translation),
+    engine::math::Multiply(glm::transpose(rotation_z),
+      engine::math::Multiply(glm::transpose(rotation_y), Scale(m_cube_scale))));
+  const glm::mat4 skybox_world = Scale(100.f);
+
+  const glm::mat4 worlds[] = {box_world, skybox_world};
+  glm::mat4 world_view_projections[std::size(worlds)];
+  engine::math::ComposeWorldViewProjection(view_projection, worlds, world_view_projections);
+
+  // The skybox surrounds the camera and is never culled. The box gets a
+  // sphere around its rotated mesh and the box around that rotation.
+  const engine::math::Aabb box_bounds = engine::math::TransformAabb(box_world, m_box_bounds);
+  m_culler.Set(m_box_object, box_bounds.center, glm::length(m_box_bounds.extent) * m_cube_scale, box_bounds.extent);
+  const std::span<const uint32_t> visible = m_culler.Cull(engine::math::Frustum::FromViewProjection(view_projection));
+
+  m_texture_table.Bind(state, kTextureTableSlot);
+
+  // Both objects are submitted in whatever order, the queue draws the box first
+  // so that early-z rejects the skybox behind it
+  m_object_ring.BeginFrame();
+  m_render_queue.Clear();
+  m_render_queue.SetDepthRange(m_near_z, m_far_z);
+
+  ObjectBlock skybox = {};
+  skybox.world_view_projection = world_view_projections[1];
+  skybox.texture_index = m_skybox_texture_index;
+  SubmitObject(skybox, m_far_z);
+
+  if (visible.empty())
+    return;
+
+  ObjectBlock box = {};
+  box.world_view_projection = world_view_projections[0];
+  box.texture_index = m_box_texture_index;
+  glm::vec4 box_view = glm::transpose(camera) * glm::vec4(m_translation_x, m_translation_y, m_translation_z, 1.f);
+  SubmitObject(box, box_view.z);
+}
 
-  glUniform1i(glGetUniformLocation(m_program, "woodenBox"), 0);
-  glUniform1i(glGetUniformLocation(m_program, "skybox"), 1);
+void HelloCamera::SubmitObject(const ObjectBlock& object, float depth)
+{
+  engine::gl::RingBuffer::Allocation allocation =
+    m_object_ring.Push(std::span<const ObjectBlock>(&object, 1), m_object_ring.UniformAlignment());
+
+  // Draws are not indexed, no element buffer is needed
+  engine::gl::DrawPacket packet;
+  packet.pipeline = m_textured ? m_pipeline : m_untextured_pipeline;
+  packet.material = m_material;
+  packet.object_offset = static_cast<uint32_t>(allocation.offset);
+  packet.mesh.count = static_cast<uint32_t>(m_vertices.size());
+  m_render_queue.Submit(packet, depth);
 }
 
 void HelloCamera::OnRender()
 {
+  m_gpu_profiler.BeginFrame();
+
   ImGui_ImplOpenGL3_NewFrame();
-  ImGui_ImplGlfw_NewFrame();
+  NewImGuiFrame();
 
   ImGui::NewFrame();
 
@@ -251,27 +267,46 @@ void HelloCamera::OnRender()
     ImGui::InputFloat("Translation Y", &m_translation_y, 0.1f, 0.f, "%.1f");
     ImGui::InputFloat("Translation Z", &m_translation_z, 0.1f, 0.f, "%.1f");
     ImGui::InputFloat("Camera velocity", &m_camera_velocity, 0.1f, 0.f, "%.1f");
+    ImGui::Checkbox("Textured", &m_textured);
+    engine::gl::StateCache::Counter state_calls = GetStateCache().Total();
+    ImGui::Text("GL state calls: %llu issued, %llu elided", static_cast<unsigned long long>(state_calls.issued),
+      static_cast<unsigned long long>(state_calls.elided));
+    const engine::gl::RenderQueue::Stats& queue_stats = m_render_queue.GetStats();
+    ImGui::Text("Draws: %u, pipeline changes %u, material changes %u", queue_stats.draws, queue_stats.pipeline_changes,
+      queue_stats.material_changes);
+    const engine::math::CullStats& cull_stats = m_culler.Stats();
+    ImGui::Text("Culling: %u of %u objects visible", cull_stats.visible, cull_stats.tested);
+    ImGui::Text("Textures: %s", m_texture_table.Mode() == engine::gl::TextureTableMode::Bindless ? "bindless" : "array");
+    if (ImGui::Button("Export GPU profile"))
+      m_gpu_profiler.ExportJson(GetCurrentExecutableDirectory() / "gpu-profile.json");
+    if (ImGui::Button("Export CPU trace"))
+      engine::profiling::CpuProfiler::Instance().ExportChromeTrace(GetCurrentExecutableDirectory() / "cpu-trace.json");
 
   ImGui::End();
 
+  m_gpu_profiler.DrawImGui();
+
   glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-  glBindVertexArray(m_vao);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+  {
+    engine::profiling::GpuScope scope(m_gpu_profiler, "scene");
+    m_render_queue.Execute(GetStateCache());
+  }
+  m_object_ring.EndFrame();
 
-  glUniform1i(glGetUniformLocation(m_program, "is_skybox"), 1);
-  glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
-  glUniform1i(glGetUniformLocation(m_program, "is_skybox"), 0);
-  glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
+  {
+    engine::profiling::GpuScope scope(m_gpu_profiler, "imgui");
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  }
 
-  ImGui::Render();
-  ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  m_gpu_profiler.EndFrame();
 }
 
-int main()
+int main(int argc, char** argv)
 {
   HelloCamera application;
-  application.Run();
+  application.Run(argc, argv);
   return 0;
 }
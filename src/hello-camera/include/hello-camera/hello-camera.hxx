@@ -17,11 +17,30 @@
 #pragma once
 
 #include "core/application.hxx"
+#include "gl/buffer.hxx"
+#include "gl/render-queue.hxx"
+#include "gl/ring-buffer.hxx"
 #include "core/camera.hxx"
 #include "core/user-input-handler.hxx"
+#include "gl/shader-permutations.hxx"
+#include "gl/texture.hxx"
+#include "gl/texture-table.hxx"
+#include "gl/uniform-block.hxx"
+#include "gl/vertex-array.hxx"
+#include "math/frustum-culler.hxx"
+#include "math/kernels.hxx"
+#include "profiling/gpu-profiler.hxx"
 
 #include <memory>
 
+// Written once per object into the object ring. The matrices are composed on
+// the CPU, the vertex shader does a single matrix-vector product.
+#define HELLO_CAMERA_OBJECT_BLOCK(X)  \
+  X(glm::mat4, world_view_projection) \
+  X(uint32_t, texture_index)
+
+ENGINE_GL_UNIFORM_BLOCK(ObjectBlock, 1, HELLO_CAMERA_OBJECT_BLOCK);
+
 class HelloCamera : public engine::glfw::Application
 {
 public:
@@ -31,11 +50,18 @@ public:
   void OnUpdate() final;
   void OnRender() final;
 
+protected:
+  engine::glfw::Camera* GetCamera() final { return &m_camera; }
 
 private:
+  // Storage buffer binding or texture unit, whichever the table mode uses
+  static constexpr GLuint kTextureTableSlot = 0;
+
   void LoadAssets();
+  void SubmitObject(const ObjectBlock& object, float depth);
 
   engine::glfw::Camera m_camera;
+  engine::profiling::GpuProfiler m_gpu_profiler;
 
   struct Vec2 {
     tinyobj::real_t x = 0.f;
@@ -52,7 +78,6 @@ private:
   std::vector<Vec3> m_vertices;
   std::vector<Vec2> m_texcoords;
 
-  std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now();
   float m_angle = 0.f;
   float m_speed = 1.f;
   float m_fov = 90.f;
@@ -64,9 +89,24 @@ private:
   float m_translation_y = 0.f;
   float m_translation_z = 2.f;
   float m_camera_velocity = .5f;
-  GLuint m_program = 0u;
-  GLuint m_ebo = -1;
-  GLuint m_vbo = -1;
-  GLuint m_vao = -1;
-  GLboolean m_is_skybox = 0;
+  bool m_textured = true;
+  std::unique_ptr<engine::gl::ShaderPermutations> m_shaders;
+  engine::gl::Texture m_box_texture;
+  engine::gl::Texture m_skybox_texture;
+  engine::gl::TextureTable m_texture_table{8, GL_RGB8, 1024, 1024};
+  uint32_t m_box_texture_index = 0;
+  uint32_t m_skybox_texture_index = 0;
+  engine::gl::Buffer m_vertex_buffer;
+  engine::gl::Buffer m_texcoord_buffer;
+  engine::gl::VertexArray m_vertex_array;
+  engine::gl::RingBuffer m_object_ring{64 * 1024};
+  engine::gl::RenderQueue m_render_queue;
+  uint16_t m_pipeline = 0;
+  uint16_t m_untextured_pipeline = 0;
+  uint16_t m_material = 0;
+
+  // Model space box of the mesh, its world bounds are culled every frame
+  engine::math::Aabb m_box_bounds;
+  engine::math::FrustumCuller m_culler;
+  uint32_t m_box_object = 0;
 };
@@ -0,0 +1,15 @@
+// #version, the texture table and the ObjectBlock declaration are prepended from C++
+
+#pragma feature UNTEXTURED
+
+in vec2 texCoord;
+out vec4 FragColor;
+
+void main()
+{
+#ifdef UNTEXTURED
+  FragColor = vec4(texCoord, 0.5, 1.0);
+#else
+  FragColor = SampleTexture(texture_index, texCoord);
+#endif
+}
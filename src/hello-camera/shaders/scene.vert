@@ -0,0 +1,12 @@
+// #version and the ObjectBlock declaration are prepended from C++
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+out vec2 texCoord;
+
+void main()
+{
+  // Composed on the CPU: projection * camera * world
+  gl_Position = world_view_projection * vec4(aPos, 1.0);
+  texCoord = aTexCoord;
+}
@@ -15,6 +15,9 @@
 *************************************************************************/
 
 #include "hello-model/hello-model.hxx"
+#include "hello-model/shaders.hxx"
+
+#include "profiling/cpu-profiler.hxx"
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -24,6 +27,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <chrono>
 #include <cmath>
 #include <numbers>
 
@@ -44,20 +48,25 @@ HelloModel::HelloModel()
   ImGui_ImplOpenGL3_Init();
 
   LoadAssets();
-
-  glEnable(GL_DEPTH_TEST);
 }
 
-void HelloModel::LoadAssets()
+static engine::gl::Texture LoadTexture(const std::filesystem::path& path)
 {
-  GLuint texture = -1;
-  glGenTextures(1, &texture);
-  glBindTexture(GL_TEXTURE_2D, texture);
-  ProcessImage(GetCurrentExecutableDirectory() / "assets/textures/LearnOpenGL/container.jpg", [](stb::Image& image)
+  engine::gl::Texture texture;
+  ProcessImage(path, [&texture](stb::Image& image)
     {
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image.Width(), image.Height(), 0, GL_RGB, GL_UNSIGNED_BYTE, image.Bytes());
+      texture = engine::gl::Texture(GL_TEXTURE_2D, 0, GL_RGB8, image.Width(), image.Height());
+      texture.Upload(0, 0, GL_RGB, GL_UNSIGNED_BYTE, image.Bytes());
     });
-  glGenerateMipmap(GL_TEXTURE_2D);
+  texture.GenerateMipmaps();
+  return texture;
+}
+
+void HelloModel::LoadAssets()
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  m_box_texture = LoadTexture(GetCurrentExecutableDirectory() / "assets/textures/LearnOpenGL/container.jpg");
 
   for (tinyobj::index_t index : m_model->Shapes()[0].mesh.indices)
   {
@@ -65,68 +74,58 @@ void HelloModel::LoadAssets()
     m_texcoords.push_back({m_model->Attrib().texcoords[2 * index.texcoord_index], m_model->Attrib().texcoords[2 * index.texcoord_index + 1]});
   }
 
-  GLuint vbo[2];
-  glGenBuffers(2, vbo);
-
-  glGenVertexArrays(1, &m_vao);
-  glBindVertexArray(m_vao);
-
-  glBindBuffer(GL_ARRAY_BUFFER, vbo[0]);
-  glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(m_vertices[0]), m_vertices.data(), GL_STATIC_DRAW);
-
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(0);
-
-  glBindBuffer(GL_ARRAY_BUFFER, vbo[1]);
-  glBufferData(GL_ARRAY_BUFFER, m_texcoords.size() * sizeof(m_texcoords[0]), m_texcoords.data(), GL_STATIC_DRAW);
-
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
-  glEnableVertexAttribArray(1);
-
-  const GLchar* vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-out vec2 texCoord;
-uniform mat4 rotation_y;
-uniform mat4 rotation_z;
-uniform float scale;
-uniform mat4 translation;
-uniform mat4 projection;
-
-void main()
-{
-  gl_Position = projection * translation * rotation_z * rotation_y * vec4(scale * aPos, 1.0);
-  texCoord = aTexCoord;
+  m_vertex_buffer = engine::gl::Buffer(std::span<const Vec3>(m_vertices));
+  m_texcoord_buffer = engine::gl::Buffer(std::span<const Vec2>(m_texcoords));
+
+  m_vertex_array.SetVertexBuffer(0, m_vertex_buffer, 0, sizeof(Vec3));
+  m_vertex_array.SetAttribute(0, 0, 3, GL_FLOAT, 0);
+  m_vertex_array.SetVertexBuffer(1, m_texcoord_buffer, 0, sizeof(Vec2));
+  m_vertex_array.SetAttribute(1, 1, 2, GL_FLOAT, 0);
+
+  // Both variants come from the same modules, only the constant differs
+  const auto build_start = std::chrono::steady_clock::now();
+  m_shader_spirv = engine::gl::UsesSpirv(shaders::kModelFrag);
+  m_program = BuildProgram(true);
+  m_untextured_program = BuildProgram(false);
+  m_shader_build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+  engine::gl::Pipeline pipeline;
+  pipeline.program = m_program.Get();
+  pipeline.vertex_array = m_vertex_array.Get();
+  m_pipeline = m_render_queue.AddPipeline(pipeline);
+  pipeline.program = m_untextured_program.Get();
+  m_untextured_pipeline = m_render_queue.AddPipeline(pipeline);
+
+  engine::gl::Material material;
+  material.textures[0] = m_box_texture.Get();
+  m_material = m_render_queue.AddMaterial(material);
+
+  m_render_queue.SetObjectBuffer(GL_UNIFORM_BUFFER, ObjectBlock::kBinding, m_object_block.Get(), sizeof(ObjectBlock));
 }
-)";
-
-  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-  glCompileShader(vertexShader);
-
-  //FragColor = texture(ourTexture, texCoord);
-  const GLchar* fragmentShaderSource = R"(
-#version 330 core
-in vec2 texCoord;
-out vec4 FragColor;
-uniform sampler2D ourTexture;
-void main()
-{
-  FragColor = texture(ourTexture, texCoord);
-}
-)";
-
-  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-  glCompileShader(fragmentShader);
-
-  m_program = glCreateProgram();
 
-  glAttachShader(m_program, vertexShader);
-  glAttachShader(m_program, fragmentShader);
+engine::gl::ShaderProgram HelloModel::BuildProgram(bool textured)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  // SPIR-V when the driver takes it, the embedded GLSL through the program cache otherwise
+  const engine::gl::SpecializationConstant constants[] = {{kTexturedConstant, textured}};
+  engine::gl::ShaderProgram program;
+  if (engine::gl::UsesSpirv(shaders::kModelFrag)) {
+    const engine::gl::ShaderHandle shaders[] = {
+      engine::gl::CompileEmbeddedShader(shaders::kModelVert),
+      engine::gl::CompileEmbeddedShader(shaders::kModelFrag, constants),
+    };
+    program = engine::gl::ShaderProgram(engine::gl::LinkProgram(shaders));
+  }
+  else {
+    const std::string fragment = engine::gl::SpecializeSource(shaders::kModelFrag.source, constants);
+    program = GetProgramCache().Link({shaders::kModelVert, {GL_FRAGMENT_SHADER, fragment}});
+  }
 
-  glLinkProgram(m_program);
+  // model.vert declares the blocks by hand, this is what keeps it in step with C++
+  engine::gl::CheckBlockLayout<FrameBlock>(program.Get());
+  engine::gl::CheckBlockLayout<ObjectBlock>(program.Get());
+  return program;
 }
 
 HelloModel::~HelloModel()
@@ -142,20 +141,17 @@ static constexpr float Radians(float degrees) {
 
 void HelloModel::OnUpdate()
 {
-  auto endTime = std::chrono::steady_clock::now();
-  float dt = std::chrono::duration<float>(endTime - m_startTime).count();
-  m_startTime = endTime;
+  ENGINE_PROFILE_FUNCTION();
 
-  m_angle = std::fmodf(m_angle + m_speed * dt, 2.f * std::numbers::pi_v<float>);
+  float dt = GetDeltaTime();
 
-  glUseProgram(m_program);
+  m_angle = std::fmodf(m_angle + m_speed * dt, 2.f * std::numbers::pi_v<float>);
 
-  GLuint rotationLoc = glGetUniformLocation(m_program, "rotation");
-  GLuint scaleLoc = glGetUniformLocation(m_program, "scale");
+  engine::gl::StateCache& state = GetStateCache();
 
-  int window_width = 0, window_height = 0;
-  glfwGetWindowSize(GetWindow(), &window_width, &window_height);
-  float aspect = (float)window_width / (float)window_height;
+  // Tracked from the input queue, frames may run off the main thread
+  const glm::ivec2 window = GetInput().WindowSize();
+  float aspect = window.y > 0 ? (float)window.x / (float)window.y : 1.f;
 
   float range_z = m_far_z - m_near_z;
   float projection_fov = 1.f / std::tanf(Radians(m_fov / 2.f));
@@ -188,17 +184,34 @@ void HelloModel::OnUpdate()
                    0.f, 0.f,             0.f,   1.f,
   };
 
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "rotation_z"), 1, GL_TRUE, glm::value_ptr(rotation_z));
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "rotation_y"), 1, GL_TRUE, glm::value_ptr(rotation_y));
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "projection"), 1, GL_TRUE, glm::value_ptr(projection));
-  glUniform1f(glGetUniformLocation(m_program, "scale"), m_cube_scale);
-  glUniformMatrix4fv(glGetUniformLocation(m_program, "translation"), 1, GL_TRUE, glm::value_ptr(translation));
+  // The matrices above are written row by row, GLSL expects columns
+  FrameBlock frame;
+  frame.projection = glm::transpose(projection);
+  m_frame_block.Update(frame);
+  state.BindBufferRange(GL_UNIFORM_BUFFER, FrameBlock::kBinding, m_frame_block.Get());
+
+  ObjectBlock object;
+  object.translation = glm::transpose(translation);
+  object.rotation_z = glm::transpose(rotation_z);
+  object.rotation_y = glm::transpose(rotation_y);
+  object.scale = m_cube_scale;
+  m_object_block.Update(object);
+
+  // Draws are not indexed, no element buffer is needed
+  engine::gl::DrawPacket packet;
+  packet.pipeline = m_textured ? m_pipeline : m_untextured_pipeline;
+  packet.material = m_material;
+  packet.mesh.count = static_cast<uint32_t>(m_vertices.size());
+
+  m_render_queue.Clear();
+  m_render_queue.SetDepthRange(m_near_z, m_far_z);
+  m_render_queue.Submit(packet, m_translation_z);
 }
 
 void HelloModel::OnRender()
 {
   ImGui_ImplOpenGL3_NewFrame();
-  ImGui_ImplGlfw_NewFrame();
+  NewImGuiFrame();
 
   ImGui::NewFrame();
   ImGui::InputFloat("Rotation velocity", &m_speed, 0.5f, 1.0f, "%.1f");
@@ -209,14 +222,14 @@ void HelloModel::OnRender()
   ImGui::InputFloat("Translation X", &m_translation_x, 0.1f, 0.f, "%.1f");
   ImGui::InputFloat("Translation Y", &m_translation_y, 0.1f, 0.f, "%.1f");
   ImGui::InputFloat("Translation Z", &m_translation_z, 0.1f, 0.f, "%.1f");
+  ImGui::Checkbox("Textured", &m_textured);
+  ImGui::Text("Shaders: %s, built in %.2f ms",
+    m_shader_spirv ? "SPIR-V" : "GLSL", m_shader_build_ms);
 
   glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-  glBindVertexArray(m_vao);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-
-  glDrawArrays(GL_TRIANGLES, 0, m_vertices.size());
+  m_render_queue.Execute(GetStateCache());
 
   ImGui::Render();
   ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -17,9 +17,31 @@
 #pragma once
 
 #include "core/application.hxx"
+#include "gl/buffer.hxx"
+#include "gl/render-queue.hxx"
+#include "gl/shader-program.hxx"
+#include "gl/spirv.hxx"
+#include "gl/texture.hxx"
+#include "gl/uniform-block.hxx"
+#include "gl/vertex-array.hxx"
 
 #include <memory>
 
+// Also declared in shaders/model.vert, which is compiled offline to SPIR-V.
+// BuildProgram checks the linked blocks against these with CheckBlockLayout.
+#define HELLO_MODEL_FRAME_BLOCK(X) \
+  X(glm::mat4, projection)
+
+ENGINE_GL_UNIFORM_BLOCK(FrameBlock, 0, HELLO_MODEL_FRAME_BLOCK);
+
+#define HELLO_MODEL_OBJECT_BLOCK(X) \
+  X(glm::mat4, translation)         \
+  X(glm::mat4, rotation_z)          \
+  X(glm::mat4, rotation_y)          \
+  X(float, scale)
+
+ENGINE_GL_UNIFORM_BLOCK(ObjectBlock, 1, HELLO_MODEL_OBJECT_BLOCK);
+
 class HelloModel : public engine::glfw::Application
 {
 public:
@@ -30,7 +52,11 @@ public:
   void OnRender() final;
 
 private:
+  // layout (constant_id = 0) in shaders/model.frag
+  static constexpr GLuint kTexturedConstant = 0;
+
   void LoadAssets();
+  engine::gl::ShaderProgram BuildProgram(bool textured);
 
   struct Vec2
   {
@@ -49,7 +75,6 @@ private:
   std::vector<Vec3> m_vertices;
   std::vector<Vec2> m_texcoords;
 
-  std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now();
   float m_angle = 0.f;
   float m_speed = 1.f;
   float m_fov = 90.f;
@@ -60,8 +85,19 @@ private:
   float m_translation_x = 0.f;
   float m_translation_y = 0.f;
   float m_translation_z = 2.f;
-  GLuint m_program = 0u;
-  GLuint m_ebo = -1;
-  GLuint m_vbo = -1;
-  GLuint m_vao = -1;
+  bool m_textured = true;
+  double m_shader_build_ms = 0.0;
+  bool m_shader_spirv = false;
+  engine::gl::ShaderProgram m_program;
+  engine::gl::ShaderProgram m_untextured_program;
+  engine::gl::Texture m_box_texture;
+  engine::gl::Buffer m_vertex_buffer;
+  engine::gl::Buffer m_texcoord_buffer;
+  engine::gl::VertexArray m_vertex_array;
+  engine::gl::BlockBuffer<FrameBlock> m_frame_block;
+  engine::gl::BlockBuffer<ObjectBlock> m_object_block;
+  engine::gl::RenderQueue m_render_queue;
+  uint16_t m_pipeline = 0;
+  uint16_t m_untextured_pipeline = 0;
+  uint16_t m_material = 0;
 };
@@ -16,8 +16,8 @@
 
 #include "hello-model/hello-model.hxx"
 
-int main()
+int main(int argc, char** argv)
 {
   HelloModel application;
-  application.Run();
+  application.Run(argc, argv);
 }
@@ -0,0 +1,16 @@
+#version 460 core
+
+// Set per program by HelloModel::BuildProgram(), the untaken branch is folded away
+layout (constant_id = 0) const bool TEXTURED = true;
+
+layout (location = 0) in vec2 texCoord;
+layout (location = 0) out vec4 FragColor;
+layout (binding = 0) uniform sampler2D ourTexture;
+
+void main()
+{
+  if (TEXTURED)
+    FragColor = texture(ourTexture, texCoord);
+  else
+    FragColor = vec4(texCoord, 0.0, 1.0);
+}
@@ -0,0 +1,27 @@
+#version 460 core
+
+// Complete stage so that it compiles offline into SPIR-V: the blocks are written
+// out here, HelloModel::BuildProgram throws if they differ from
+// HELLO_MODEL_FRAME_BLOCK and HELLO_MODEL_OBJECT_BLOCK
+layout(std140, binding = 0) uniform FrameBlock
+{
+  mat4 projection;
+};
+
+layout(std140, binding = 1) uniform ObjectBlock
+{
+  mat4 translation;
+  mat4 rotation_z;
+  mat4 rotation_y;
+  float scale;
+};
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 0) out vec2 texCoord;
+
+void main()
+{
+  gl_Position = projection * translation * rotation_z * rotation_y * vec4(scale * aPos, 1.0);
+  texCoord = aTexCoord;
+}
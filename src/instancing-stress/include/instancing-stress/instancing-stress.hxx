@@ -0,0 +1,98 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+#pragma once
+
+#include "core/application.hxx"
+#include "core/camera.hxx"
+#include "gl/geometry-pool.hxx"
+#include "gl/instancing.hxx"
+#include "gl/program-builder.hxx"
+#include "gl/render-queue.hxx"
+#include "gl/shader-program.hxx"
+#include "gl/uniform-block.hxx"
+#include "gl/vertex-array.hxx"
+#include "profiling/gpu-profiler.hxx"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#define INSTANCING_STRESS_FRAME_BLOCK(X) \
+  X(glm::mat4, view_projection)
+
+ENGINE_GL_UNIFORM_BLOCK(FrameBlock, 0, INSTANCING_STRESS_FRAME_BLOCK);
+
+// Up to a million cubes in one instanced draw, per-instance data fetched from
+// attributes or a storage buffer. Frame times are shown live and written by
+// --benchmark like every other sample.
+class InstancingStress : public engine::glfw::Application
+{
+public:
+  static constexpr uint32_t kMaxInstances = 1'000'000;
+
+  InstancingStress();
+  ~InstancingStress();
+
+  void OnUpdate() final;
+  void OnRender() final;
+
+protected:
+  engine::glfw::Camera* GetCamera() final { return &m_camera; }
+
+private:
+  static constexpr size_t kFrameHistory = 240;
+
+  struct Vertex
+  {
+    glm::vec3 position;
+    glm::vec3 normal;
+  };
+
+  void LoadAssets();
+  uint16_t AddPipeline(const engine::gl::ShaderProgram& program);
+  // Swaps the storage variant in once the builder has it
+  void PollPrograms();
+  void UpdateInstances(float time);
+  void DrawStatistics();
+
+  engine::glfw::Camera m_camera;
+  engine::profiling::GpuProfiler m_gpu_profiler;
+
+  engine::gl::GeometryPool m_geometry{sizeof(Vertex), 24, 36};
+  engine::gl::MeshRange m_cube;
+  engine::gl::InstanceBuffer m_instance_buffer{kMaxInstances};
+  std::vector<engine::gl::Instance> m_instances;
+  engine::gl::VertexArray m_vertex_array;
+  engine::gl::BlockBuffer<FrameBlock> m_frame_block;
+
+  // Indexed by InstanceFetch, the storage pipeline aliases the attribute one until its program is ready
+  engine::gl::ProgramBuilder m_program_builder{&GetProgramCache()};
+  engine::gl::ProgramBuilder::Ticket m_storage_ticket = 0;
+  std::array<engine::gl::ShaderProgram, 2> m_programs;
+  std::array<uint16_t, 2> m_pipelines = {};
+  engine::gl::RenderQueue m_render_queue;
+
+  int m_instance_count = 100'000;
+  int m_fetch = 0;
+  bool m_animate = false;
+  float m_time = 0.f;
+  float m_fov = 90.f;
+  float m_near_z = 0.1f;
+  float m_far_z = 500.f;
+
+  std::array<double, kFrameHistory> m_frame_times_ms = {};
+  size_t m_frame_index = 0;
+};
@@ -0,0 +1,285 @@
+/*************************************************************************
+* Copyright 2025 Vladislav Riabov
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*************************************************************************/
+
+#include "instancing-stress/instancing-stress.hxx"
+#include "instancing-stress/shaders.hxx"
+
+#include "core/frame-statistics.hxx"
+#include "profiling/cpu-profiler.hxx"
+
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+#include <imgui_impl_opengl3.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+
+constexpr GLuint kInstanceBinding = 1;
+constexpr GLuint kInstanceAttribute = 2;
+
+constexpr float Radians(float degrees)
+{
+  return std::numbers::pi_v<float> / 180.f * degrees;
+}
+
+glm::vec4 AxisAngle(glm::vec3 axis, float angle)
+{
+  return glm::vec4(glm::normalize(axis) * std::sin(angle / 2.f), std::cos(angle / 2.f));
+}
+
+}  // namespace
+
+InstancingStress::InstancingStress()
+ : Application(m_camera)
+{
+  IMGUI_CHECKVERSION();
+  ImGui::CreateContext();
+  ImGui::GetIO().IniFilename = nullptr;
+  ImGui_ImplGlfw_InitForOpenGL(GetWindow(), true);
+  ImGui_ImplOpenGL3_Init();
+
+  // Uncapped, the frame time is what is being measured
+  glfwSwapInterval(0);
+
+  LoadAssets();
+}
+
+InstancingStress::~InstancingStress()
+{
+  ImGui_ImplOpenGL3_Shutdown();
+  ImGui_ImplGlfw_Shutdown();
+  ImGui::DestroyContext();
+}
+
+void InstancingStress::LoadAssets()
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  // One quad per face so that every face has its own normal
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  for (int axis = 0; axis < 3; ++axis) {
+    for (float sign : {-1.f, 1.f}) {
+      glm::vec3 normal(0.f);
+      normal[axis] = sign;
+      glm::vec3 u(0.f), v(0.f);
+      u[(axis + 1) % 3] = 1.f;
+      v[(axis + 2) % 3] = sign;
+
+      const uint32_t base = static_cast<uint32_t>(vertices.size());
+      vertices.push_back({normal - u - v, normal});
+      vertices.push_back({normal + u - v, normal});
+      vertices.push_back({normal + u + v, normal});
+      vertices.push_back({normal - u + v, normal});
+      indices.insert(indices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+  }
+  m_cube = m_geometry.Add(std::span<const Vertex>(vertices), indices);
+
+  m_geometry.Attach(m_vertex_array);
+  m_vertex_array.SetAttribute(0, 0, 3, GL_FLOAT, offsetof(Vertex, position));
+  m_vertex_array.SetAttribute(1, 0, 3, GL_FLOAT, offsetof(Vertex, normal));
+  m_instance_buffer.AttachAttributes(m_vertex_array, 1, kInstanceAttribute);
+
+  // A cube of cubes, 100 on a side, filled from the center of the front face outwards
+  constexpr int kSide = 100;
+  m_instances.resize(kMaxInstances);
+  for (uint32_t i = 0; i < kMaxInstances; ++i) {
+    engine::gl::Instance& instance = m_instances[i];
+    int x = static_cast<int>(i % kSide) - kSide / 2;
+    int y = static_cast<int>(i / kSide % kSide) - kSide / 2;
+    int z = static_cast<int>(i / (kSide * kSide));
+    instance.position = glm::vec3(x * 2.f, y * 2.f, 5.f + z * 2.f);
+    instance.scale = 0.5f;
+    instance.rotation = AxisAngle(glm::vec3(x, y, 1.f), 0.1f * i);
+  }
+  m_instance_buffer.Update(m_instances);
+
+  auto vertex_source = [](engine::gl::InstanceFetch fetch)
+  {
+    const GLuint slot = fetch == engine::gl::InstanceFetch::Attributes ? kInstanceAttribute : kInstanceBinding;
+    return "#version 460 core\n" + FrameBlock::Glsl() + engine::gl::InstanceBuffer::Glsl(fetch, slot)
+      + std::string(shaders::kCubeVert.source);
+  };
+
+  // The attribute variant is linked up front and draws while the storage
+  // variant compiles in the background
+  m_programs[0] = GetProgramCache().Link({
+    {GL_VERTEX_SHADER, vertex_source(engine::gl::InstanceFetch::Attributes)},
+    shaders::kCubeFrag,
+  });
+  m_pipelines[0] = AddPipeline(m_programs[0]);
+
+  m_storage_ticket = m_program_builder.Submit({
+    {GL_VERTEX_SHADER, vertex_source(engine::gl::InstanceFetch::Storage)},
+    shaders::kCubeFrag,
+  });
+  m_pipelines[1] = m_pipelines[0];
+
+  m_render_queue.AddMaterial({});
+}
+
+uint16_t InstancingStress::AddPipeline(const engine::gl::ShaderProgram& program)
+{
+  engine::gl::Pipeline pipeline;
+  pipeline.program = program.Get();
+  pipeline.vertex_array = m_vertex_array.Get();
+  pipeline.index_type = GL_UNSIGNED_INT;
+  pipeline.cull_face = GL_BACK;
+  return m_render_queue.AddPipeline(pipeline);
+}
+
+void InstancingStress::PollPrograms()
+{
+  m_program_builder.Poll();
+
+  switch (m_program_builder.Status(m_storage_ticket)) {
+  case engine::gl::ProgramStatus::Ready:
+    m_programs[1] = m_program_builder.Take(m_storage_ticket);
+    m_pipelines[1] = AddPipeline(m_programs[1]);
+    break;
+  case engine::gl::ProgramStatus::Failed:
+    throw engine::gl::ShaderCompileFail(m_program_builder.Log(m_storage_ticket));
+  default:
+    break;
+  }
+}
+
+void InstancingStress::UpdateInstances(float time)
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  // Every live instance is rewritten and uploaded, a streaming worst case
+  std::span<engine::gl::Instance> live(m_instances.data(), m_instance_count);
+  for (size_t i = 0; i < live.size(); ++i) {
+    const glm::vec3& position = live[i].position;
+    live[i].rotation = AxisAngle(glm::vec3(position.x, position.y, 1.f), 0.1f * i + time);
+  }
+  m_instance_buffer.Update(std::span<const engine::gl::Instance>(live));
+}
+
+void InstancingStress::OnUpdate()
+{
+  ENGINE_PROFILE_FUNCTION();
+
+  float dt = GetDeltaTime();
+  m_frame_times_ms[m_frame_index++ % kFrameHistory] = dt * 1000.0;
+
+  m_camera.OnFrame(*this, dt);
+  PollPrograms();
+
+  if (m_animate) {
+    m_time += dt;
+    UpdateInstances(m_time);
+  }
+
+  // Tracked from the input queue, frames may run off the main thread
+  const glm::ivec2 window = GetInput().WindowSize();
+  float aspect = window.y > 0 ? (float)window.x / (float)window.y : 1.f;
+
+  float range_z = m_far_z - m_near_z;
+  float projection_fov = 1.f / std::tanf(Radians(m_fov / 2.f));
+
+  glm::mat4 projection = {
+    projection_fov, 0.f, 0.f, 0.f,
+    0.f, projection_fov * aspect, 0.f, 0.f,
+    0.f, 0.f, (m_far_z + m_near_z) / range_z, - (2.f * m_far_z * m_near_z) / range_z,
+    0.f, 0.f, 1.f, 0.f,
+  };
+
+  // Written row by row like the camera's view transform, GLSL expects columns
+  FrameBlock frame;
+  frame.view_projection = glm::transpose(m_camera.GetViewTransform() * projection);
+  m_frame_block.Update(frame);
+
+  engine::gl::StateCache& state = GetStateCache();
+  state.BindBufferRange(GL_UNIFORM_BUFFER, FrameBlock::kBinding, m_frame_block.Get());
+  m_instance_buffer.BindStorage(state, kInstanceBinding);
+
+  engine::gl::DrawPacket packet;
+  packet.pipeline = m_pipelines[m_fetch];
+  packet.mesh = m_cube;
+  packet.mesh.instance_count = static_cast<uint32_t>(m_instance_count);
+
+  m_render_queue.Clear();
+  m_render_queue.Submit(packet, 0.f);
+}
+
+void InstancingStress::DrawStatistics()
+{
+  const size_t frames = std::min(m_frame_index, kFrameHistory);
+  engine::FrameTimeSummary summary =
+    engine::SummarizeFrameTimes(std::vector<double>(m_frame_times_ms.begin(), m_frame_times_ms.begin() + frames));
+
+  ImGui::Begin("instancing-stress");
+
+  ImGui::SliderInt("Cubes", &m_instance_count, 1, static_cast<int>(kMaxInstances), "%d", ImGuiSliderFlags_Logarithmic);
+  ImGui::Combo("Instance fetch", &m_fetch, "Attributes\0Storage buffer\0");
+  ImGui::Checkbox("Animate (re-upload every frame)", &m_animate);
+  if (m_program_builder.PendingCount() > 0)
+    ImGui::Text("Storage variant compiling (%s), drawing with attributes", m_program_builder.IsParallel() ? "parallel" : "serial");
+  else if (m_program_builder.Status(m_storage_ticket) == engine::gl::ProgramStatus::Taken)
+    ImGui::Text("Storage variant ready %.1f ms after submit", m_program_builder.LatencyMs(m_storage_ticket));
+
+  ImGui::Text("Frame: avg %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms", summary.average_ms, summary.p95_ms,
+    summary.p99_ms, summary.max_ms);
+  ImGui::Text("%.1f M cubes/s", summary.average_ms > 0.0 ? m_instance_count / summary.average_ms / 1000.0 : 0.0);
+  if (ImGui::Button("Export GPU profile"))
+    m_gpu_profiler.ExportJson(GetCurrentExecutableDirectory() / "gpu-profile.json");
+
+  ImGui::End();
+
+  m_gpu_profiler.DrawImGui();
+}
+
+void InstancingStress::OnRender()
+{
+  m_gpu_profiler.BeginFrame();
+
+  ImGui_ImplOpenGL3_NewFrame();
+  NewImGuiFrame();
+  ImGui::NewFrame();
+  DrawStatistics();
+
+  glClearColor(0.1f, 0.1f, 0.12f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  {
+    engine::profiling::GpuScope scope(m_gpu_profiler, "cubes");
+    m_render_queue.Execute(GetStateCache());
+  }
+
+  {
+    engine::profiling::GpuScope scope(m_gpu_profiler, "imgui");
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  }
+
+  m_gpu_profiler.EndFrame();
+}
+
+int main(int argc, char** argv)
+{
+  InstancingStress application;
+  application.Run(argc, argv);
+  return 0;
+}
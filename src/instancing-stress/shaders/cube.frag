@@ -0,0 +1,11 @@
+#version 460 core
+
+#include "lighting.glsl"
+
+in vec3 world_normal;
+out vec4 FragColor;
+
+void main()
+{
+  FragColor = vec4(Lighting(world_normal) * vec3(0.9, 0.6, 0.3), 1.0);
+}
@@ -0,0 +1,12 @@
+// #version, FrameBlock and the instance fetch are prepended from C++
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+out vec3 world_normal;
+
+void main()
+{
+  Instance instance = LoadInstance();
+  world_normal = RotateByQuaternion(normal, instance.rotation);
+  gl_Position = view_projection * vec4(InstanceToWorld(instance, position), 1.0);
+}
@@ -0,0 +1,7 @@
+const vec3 kLightDirection = normalize(vec3(0.4, 0.8, -0.5));
+
+// Ambient plus Lambert from a single directional light
+float Lighting(vec3 normal)
+{
+  return 0.3 + 0.7 * max(dot(normalize(normal), kLightDirection), 0.0);
+}